@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchBrowse"
+  "BenchBrowse.pdb"
+  "CMakeFiles/BenchBrowse.dir/bench/BenchBrowse.cpp.o"
+  "CMakeFiles/BenchBrowse.dir/bench/BenchBrowse.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchBrowse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
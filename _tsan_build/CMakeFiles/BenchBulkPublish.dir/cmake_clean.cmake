@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchBulkPublish"
+  "BenchBulkPublish.pdb"
+  "CMakeFiles/BenchBulkPublish.dir/bench/BenchBulkPublish.cpp.o"
+  "CMakeFiles/BenchBulkPublish.dir/bench/BenchBulkPublish.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchBulkPublish.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchConcurrency"
+  "BenchConcurrency.pdb"
+  "CMakeFiles/BenchConcurrency.dir/bench/BenchConcurrency.cpp.o"
+  "CMakeFiles/BenchConcurrency.dir/bench/BenchConcurrency.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchConcurrency.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
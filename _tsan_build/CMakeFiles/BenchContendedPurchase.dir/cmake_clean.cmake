@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchContendedPurchase"
+  "BenchContendedPurchase.pdb"
+  "CMakeFiles/BenchContendedPurchase.dir/bench/BenchContendedPurchase.cpp.o"
+  "CMakeFiles/BenchContendedPurchase.dir/bench/BenchContendedPurchase.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchContendedPurchase.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchMemory"
+  "BenchMemory.pdb"
+  "CMakeFiles/BenchMemory.dir/bench/BenchMemory.cpp.o"
+  "CMakeFiles/BenchMemory.dir/bench/BenchMemory.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchMemory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
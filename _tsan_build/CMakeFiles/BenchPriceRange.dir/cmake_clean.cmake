@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchPriceRange"
+  "BenchPriceRange.pdb"
+  "CMakeFiles/BenchPriceRange.dir/bench/BenchPriceRange.cpp.o"
+  "CMakeFiles/BenchPriceRange.dir/bench/BenchPriceRange.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchPriceRange.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchSearchCache"
+  "BenchSearchCache.pdb"
+  "CMakeFiles/BenchSearchCache.dir/bench/BenchSearchCache.cpp.o"
+  "CMakeFiles/BenchSearchCache.dir/bench/BenchSearchCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchSearchCache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchSessions"
+  "BenchSessions.pdb"
+  "CMakeFiles/BenchSessions.dir/bench/BenchSessions.cpp.o"
+  "CMakeFiles/BenchSessions.dir/bench/BenchSessions.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchSessions.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchSnapshotReads"
+  "BenchSnapshotReads.pdb"
+  "CMakeFiles/BenchSnapshotReads.dir/bench/BenchSnapshotReads.cpp.o"
+  "CMakeFiles/BenchSnapshotReads.dir/bench/BenchSnapshotReads.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchSnapshotReads.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
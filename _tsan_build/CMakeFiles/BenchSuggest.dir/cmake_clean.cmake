@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchSuggest"
+  "BenchSuggest.pdb"
+  "CMakeFiles/BenchSuggest.dir/bench/BenchSuggest.cpp.o"
+  "CMakeFiles/BenchSuggest.dir/bench/BenchSuggest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchSuggest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
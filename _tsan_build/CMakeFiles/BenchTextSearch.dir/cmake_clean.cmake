@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchTextSearch"
+  "BenchTextSearch.pdb"
+  "CMakeFiles/BenchTextSearch.dir/bench/BenchTextSearch.cpp.o"
+  "CMakeFiles/BenchTextSearch.dir/bench/BenchTextSearch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchTextSearch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
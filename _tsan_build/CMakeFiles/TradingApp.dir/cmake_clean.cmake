@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TradingApp.dir/src/main.cpp.o"
+  "CMakeFiles/TradingApp.dir/src/main.cpp.o.d"
+  "TradingApp"
+  "TradingApp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TradingApp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TradingServer.dir/src/server_main.cpp.o"
+  "CMakeFiles/TradingServer.dir/src/server_main.cpp.o.d"
+  "TradingServer"
+  "TradingServer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TradingServer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
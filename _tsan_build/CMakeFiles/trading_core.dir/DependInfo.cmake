@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/CategoryDictionary.cpp" "CMakeFiles/trading_core.dir/src/CategoryDictionary.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/CategoryDictionary.cpp.o.d"
+  "/root/repo/src/FilterKernel.cpp" "CMakeFiles/trading_core.dir/src/FilterKernel.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/FilterKernel.cpp.o.d"
+  "/root/repo/src/FuzzyMatch.cpp" "CMakeFiles/trading_core.dir/src/FuzzyMatch.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/FuzzyMatch.cpp.o.d"
+  "/root/repo/src/ImageHash.cpp" "CMakeFiles/trading_core.dir/src/ImageHash.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/ImageHash.cpp.o.d"
+  "/root/repo/src/ImageIndex.cpp" "CMakeFiles/trading_core.dir/src/ImageIndex.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/ImageIndex.cpp.o.d"
+  "/root/repo/src/Item.cpp" "CMakeFiles/trading_core.dir/src/Item.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/Item.cpp.o.d"
+  "/root/repo/src/ItemClaims.cpp" "CMakeFiles/trading_core.dir/src/ItemClaims.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/ItemClaims.cpp.o.d"
+  "/root/repo/src/ItemOrder.cpp" "CMakeFiles/trading_core.dir/src/ItemOrder.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/ItemOrder.cpp.o.d"
+  "/root/repo/src/ItemStore.cpp" "CMakeFiles/trading_core.dir/src/ItemStore.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/ItemStore.cpp.o.d"
+  "/root/repo/src/Pagination.cpp" "CMakeFiles/trading_core.dir/src/Pagination.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/Pagination.cpp.o.d"
+  "/root/repo/src/Platform.cpp" "CMakeFiles/trading_core.dir/src/Platform.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/Platform.cpp.o.d"
+  "/root/repo/src/PriceIndex.cpp" "CMakeFiles/trading_core.dir/src/PriceIndex.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/PriceIndex.cpp.o.d"
+  "/root/repo/src/QueryPlan.cpp" "CMakeFiles/trading_core.dir/src/QueryPlan.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/QueryPlan.cpp.o.d"
+  "/root/repo/src/Relevance.cpp" "CMakeFiles/trading_core.dir/src/Relevance.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/Relevance.cpp.o.d"
+  "/root/repo/src/RoaringBitmap.cpp" "CMakeFiles/trading_core.dir/src/RoaringBitmap.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/RoaringBitmap.cpp.o.d"
+  "/root/repo/src/SearchCache.cpp" "CMakeFiles/trading_core.dir/src/SearchCache.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/SearchCache.cpp.o.d"
+  "/root/repo/src/SearchEngine.cpp" "CMakeFiles/trading_core.dir/src/SearchEngine.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/SearchEngine.cpp.o.d"
+  "/root/repo/src/SessionStore.cpp" "CMakeFiles/trading_core.dir/src/SessionStore.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/SessionStore.cpp.o.d"
+  "/root/repo/src/SuggestIndex.cpp" "CMakeFiles/trading_core.dir/src/SuggestIndex.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/SuggestIndex.cpp.o.d"
+  "/root/repo/src/TextArena.cpp" "CMakeFiles/trading_core.dir/src/TextArena.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/TextArena.cpp.o.d"
+  "/root/repo/src/TextIndex.cpp" "CMakeFiles/trading_core.dir/src/TextIndex.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/TextIndex.cpp.o.d"
+  "/root/repo/src/User.cpp" "CMakeFiles/trading_core.dir/src/User.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/User.cpp.o.d"
+  "/root/repo/src/WorkStealingPool.cpp" "CMakeFiles/trading_core.dir/src/WorkStealingPool.cpp.o" "gcc" "CMakeFiles/trading_core.dir/src/WorkStealingPool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
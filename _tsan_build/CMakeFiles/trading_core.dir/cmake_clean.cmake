@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trading_core.dir/src/CategoryDictionary.cpp.o"
+  "CMakeFiles/trading_core.dir/src/CategoryDictionary.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/FilterKernel.cpp.o"
+  "CMakeFiles/trading_core.dir/src/FilterKernel.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/FuzzyMatch.cpp.o"
+  "CMakeFiles/trading_core.dir/src/FuzzyMatch.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/ImageHash.cpp.o"
+  "CMakeFiles/trading_core.dir/src/ImageHash.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/ImageIndex.cpp.o"
+  "CMakeFiles/trading_core.dir/src/ImageIndex.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/Item.cpp.o"
+  "CMakeFiles/trading_core.dir/src/Item.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/ItemClaims.cpp.o"
+  "CMakeFiles/trading_core.dir/src/ItemClaims.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/ItemOrder.cpp.o"
+  "CMakeFiles/trading_core.dir/src/ItemOrder.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/ItemStore.cpp.o"
+  "CMakeFiles/trading_core.dir/src/ItemStore.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/Pagination.cpp.o"
+  "CMakeFiles/trading_core.dir/src/Pagination.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/Platform.cpp.o"
+  "CMakeFiles/trading_core.dir/src/Platform.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/PriceIndex.cpp.o"
+  "CMakeFiles/trading_core.dir/src/PriceIndex.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/QueryPlan.cpp.o"
+  "CMakeFiles/trading_core.dir/src/QueryPlan.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/Relevance.cpp.o"
+  "CMakeFiles/trading_core.dir/src/Relevance.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/RoaringBitmap.cpp.o"
+  "CMakeFiles/trading_core.dir/src/RoaringBitmap.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/SearchCache.cpp.o"
+  "CMakeFiles/trading_core.dir/src/SearchCache.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/SearchEngine.cpp.o"
+  "CMakeFiles/trading_core.dir/src/SearchEngine.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/SessionStore.cpp.o"
+  "CMakeFiles/trading_core.dir/src/SessionStore.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/SuggestIndex.cpp.o"
+  "CMakeFiles/trading_core.dir/src/SuggestIndex.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/TextArena.cpp.o"
+  "CMakeFiles/trading_core.dir/src/TextArena.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/TextIndex.cpp.o"
+  "CMakeFiles/trading_core.dir/src/TextIndex.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/User.cpp.o"
+  "CMakeFiles/trading_core.dir/src/User.cpp.o.d"
+  "CMakeFiles/trading_core.dir/src/WorkStealingPool.cpp.o"
+  "CMakeFiles/trading_core.dir/src/WorkStealingPool.cpp.o.d"
+  "libtrading_core.a"
+  "libtrading_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trading_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/RequestHandler.cpp" "CMakeFiles/trading_server.dir/src/RequestHandler.cpp.o" "gcc" "CMakeFiles/trading_server.dir/src/RequestHandler.cpp.o.d"
+  "/root/repo/src/TradingServer.cpp" "CMakeFiles/trading_server.dir/src/TradingServer.cpp.o" "gcc" "CMakeFiles/trading_server.dir/src/TradingServer.cpp.o.d"
+  "/root/repo/src/WireClient.cpp" "CMakeFiles/trading_server.dir/src/WireClient.cpp.o" "gcc" "CMakeFiles/trading_server.dir/src/WireClient.cpp.o.d"
+  "/root/repo/src/WireProtocol.cpp" "CMakeFiles/trading_server.dir/src/WireProtocol.cpp.o" "gcc" "CMakeFiles/trading_server.dir/src/WireProtocol.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_tsan_build/CMakeFiles/trading_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
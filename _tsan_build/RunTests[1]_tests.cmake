@@ -0,0 +1,125 @@
+add_test([=[TradingPlatformTest.RegisterAndLoginSuccess]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.RegisterAndLoginSuccess]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.RegisterAndLoginSuccess]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.RegisterDuplicateEmail]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.RegisterDuplicateEmail]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.RegisterDuplicateEmail]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.LoginWrongPassword]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.LoginWrongPassword]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.LoginWrongPassword]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.LoginWrongEmail]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.LoginWrongEmail]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.LoginWrongEmail]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Login_NormalizedEmail]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Login_NormalizedEmail]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Login_NormalizedEmail]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.UpdateProfile_EmailIndex]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.UpdateProfile_EmailIndex]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.UpdateProfile_EmailIndex]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Item_Publish_Success]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Item_Publish_Success]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Item_Publish_Success]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Item_PointerStableAfterGrowth]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Item_PointerStableAfterGrowth]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Item_PointerStableAfterGrowth]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Item_TextArenaAndCompaction]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Item_TextArenaAndCompaction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Item_TextArenaAndCompaction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Cart_AddAndRemove]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Cart_AddAndRemove]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Cart_AddAndRemove]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Cart_EdgeCases]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Cart_EdgeCases]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Cart_EdgeCases]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Purchase_Success]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Purchase_Success]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Purchase_Success]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Purchase_Fail_AlreadySold]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Purchase_Fail_AlreadySold]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Purchase_Fail_AlreadySold]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Batch_PublishAndSetStatus]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Batch_PublishAndSetStatus]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Batch_PublishAndSetStatus]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Checkout_AllOrNothing]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Checkout_AllOrNothing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Checkout_AllOrNothing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Delete_ByAdmin]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Delete_ByAdmin]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Delete_ByAdmin]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Delete_Fail_Unauthorized]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Delete_Fail_Unauthorized]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Delete_Fail_Unauthorized]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_Keywords]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_Keywords]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_Keywords]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_FilterStatus]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_FilterStatus]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_FilterStatus]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_Category]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_Category]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_Category]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_SortPrice]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_SortPrice]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_SortPrice]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_TextIndexMatchesScan]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_TextIndexMatchesScan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_TextIndexMatchesScan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_PartialUtf8NoFalseHit]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_PartialUtf8NoFalseHit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_PartialUtf8NoFalseHit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_TopKMatchesFullSort]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_TopKMatchesFullSort]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_TopKMatchesFullSort]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_PriceIndexMatchesScan]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_PriceIndexMatchesScan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_PriceIndexMatchesScan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_PlanChoosesAccessPath]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_PlanChoosesAccessPath]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_PlanChoosesAccessPath]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_CacheInvalidation]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_CacheInvalidation]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_CacheInvalidation]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_RelevanceRanking]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_RelevanceRanking]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_RelevanceRanking]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_RelevanceCacheFollowsCorpus]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_RelevanceCacheFollowsCorpus]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_RelevanceCacheFollowsCorpus]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_FuzzyMatching]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_FuzzyMatching]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_FuzzyMatching]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_Suggestions]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_Suggestions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_Suggestions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_ParallelScanMatchesSerial]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_ParallelScanMatchesSerial]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_ParallelScanMatchesSerial]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Search_ByImage]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Search_ByImage]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Search_ByImage]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Concurrency_MixedReadersAndWriters]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Concurrency_MixedReadersAndWriters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Concurrency_MixedReadersAndWriters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Concurrency_HotItemSoldOnce]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Concurrency_HotItemSoldOnce]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Concurrency_HotItemSoldOnce]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Concurrency_CheckoutCompetingCarts]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Concurrency_CheckoutCompetingCarts]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Concurrency_CheckoutCompetingCarts]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Concurrency_SnapshotReadsSeeOneVersion]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Concurrency_SnapshotReadsSeeOneVersion]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Concurrency_SnapshotReadsSeeOneVersion]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Session_OpenValidateClose]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Session_OpenValidateClose]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Session_OpenValidateClose]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Server_EndToEnd]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Server_EndToEnd]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Server_EndToEnd]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Server_PipelinedRequestsAnswerInOrder]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Server_PipelinedRequestsAnswerInOrder]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Server_PipelinedRequestsAnswerInOrder]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Server_ThrottlesUnreadResponses]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Server_ThrottlesUnreadResponses]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Server_ThrottlesUnreadResponses]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Wire_OversizedResponseRefused]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Wire_OversizedResponseRefused]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Wire_OversizedResponseRefused]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Catalog_PartitionAndCompact]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Catalog_PartitionAndCompact]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Catalog_PartitionAndCompact]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Catalog_AutoCompact]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Catalog_AutoCompact]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Catalog_AutoCompact]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.View_ZeroCopyResults]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.View_ZeroCopyResults]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.View_ZeroCopyResults]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Page_ByIdWithCursor]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Page_ByIdWithCursor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Page_ByIdWithCursor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Page_ByPriceWithTies]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Page_ByPriceWithTies]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Page_ByPriceWithTies]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Page_InvalidCursor]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Page_InvalidCursor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Page_InvalidCursor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Page_AdminAndSearch]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Page_AdminAndSearch]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Page_AdminAndSearch]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Page_SearchFollowsPlan]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Page_SearchFollowsPlan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Page_SearchFollowsPlan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Columns_SelectMatchesRowPredicate]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Columns_SelectMatchesRowPredicate]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Columns_SelectMatchesRowPredicate]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.Category_BitmapFollowsStatus]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.Category_BitmapFollowsStatus]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.Category_BitmapFollowsStatus]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TradingPlatformTest.UpdateItem_Permissions]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=TradingPlatformTest.UpdateItem_Permissions]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TradingPlatformTest.UpdateItem_Permissions]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PriceIndexTest.ScansMatchReference]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=PriceIndexTest.ScansMatchReference]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PriceIndexTest.ScansMatchReference]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[EpochReplicasTest.ReadersSeeWholeWrites]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=EpochReplicasTest.ReadersSeeWholeWrites]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[EpochReplicasTest.ReadersSeeWholeWrites]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[WorkStealingPoolTest.RunsEveryTaskOnce]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=WorkStealingPoolTest.RunsEveryTaskOnce]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[WorkStealingPoolTest.RunsEveryTaskOnce]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ImageHashTest.SimilarImagesHaveCloseHashes]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=ImageHashTest.SimilarImagesHaveCloseHashes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ImageHashTest.SimilarImagesHaveCloseHashes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ImageIndexTest.NearestMatchesScan]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=ImageIndexTest.NearestMatchesScan]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ImageIndexTest.NearestMatchesScan]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ItemClaimsTest.RolledBackCheckoutDoesNotStealItems]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=ItemClaimsTest.RolledBackCheckoutDoesNotStealItems]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ItemClaimsTest.RolledBackCheckoutDoesNotStealItems]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[SessionStoreTest.TokensExpireAfterIdleTtl]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=SessionStoreTest.TokensExpireAfterIdleTtl]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[SessionStoreTest.TokensExpireAfterIdleTtl]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[FilterKernelTest.AllImplementationsAgree]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=FilterKernelTest.AllImplementationsAgree]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[FilterKernelTest.AllImplementationsAgree]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RoaringBitmapTest.SetOperationsMatchReference]=]  /root/repo/_tsan_build/RunTests [==[--gtest_filter=RoaringBitmapTest.SetOperationsMatchReference]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RoaringBitmapTest.SetOperationsMatchReference]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_tsan_build SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  RunTests_TESTS TradingPlatformTest.RegisterAndLoginSuccess TradingPlatformTest.RegisterDuplicateEmail TradingPlatformTest.LoginWrongPassword TradingPlatformTest.LoginWrongEmail TradingPlatformTest.Login_NormalizedEmail TradingPlatformTest.UpdateProfile_EmailIndex TradingPlatformTest.Item_Publish_Success TradingPlatformTest.Item_PointerStableAfterGrowth TradingPlatformTest.Item_TextArenaAndCompaction TradingPlatformTest.Cart_AddAndRemove TradingPlatformTest.Cart_EdgeCases TradingPlatformTest.Purchase_Success TradingPlatformTest.Purchase_Fail_AlreadySold TradingPlatformTest.Batch_PublishAndSetStatus TradingPlatformTest.Checkout_AllOrNothing TradingPlatformTest.Delete_ByAdmin TradingPlatformTest.Delete_Fail_Unauthorized TradingPlatformTest.Search_Keywords TradingPlatformTest.Search_FilterStatus TradingPlatformTest.Search_Category TradingPlatformTest.Search_SortPrice TradingPlatformTest.Search_TextIndexMatchesScan TradingPlatformTest.Search_PartialUtf8NoFalseHit TradingPlatformTest.Search_TopKMatchesFullSort TradingPlatformTest.Search_PriceIndexMatchesScan TradingPlatformTest.Search_PlanChoosesAccessPath TradingPlatformTest.Search_CacheInvalidation TradingPlatformTest.Search_RelevanceRanking TradingPlatformTest.Search_RelevanceCacheFollowsCorpus TradingPlatformTest.Search_FuzzyMatching TradingPlatformTest.Search_Suggestions TradingPlatformTest.Search_ParallelScanMatchesSerial TradingPlatformTest.Search_ByImage TradingPlatformTest.Concurrency_MixedReadersAndWriters TradingPlatformTest.Concurrency_HotItemSoldOnce TradingPlatformTest.Concurrency_CheckoutCompetingCarts TradingPlatformTest.Concurrency_SnapshotReadsSeeOneVersion TradingPlatformTest.Session_OpenValidateClose TradingPlatformTest.Server_EndToEnd TradingPlatformTest.Server_PipelinedRequestsAnswerInOrder TradingPlatformTest.Server_ThrottlesUnreadResponses TradingPlatformTest.Wire_OversizedResponseRefused TradingPlatformTest.Catalog_PartitionAndCompact TradingPlatformTest.Catalog_AutoCompact TradingPlatformTest.View_ZeroCopyResults TradingPlatformTest.Page_ByIdWithCursor TradingPlatformTest.Page_ByPriceWithTies TradingPlatformTest.Page_InvalidCursor TradingPlatformTest.Page_AdminAndSearch TradingPlatformTest.Page_SearchFollowsPlan TradingPlatformTest.Columns_SelectMatchesRowPredicate TradingPlatformTest.Category_BitmapFollowsStatus TradingPlatformTest.UpdateItem_Permissions PriceIndexTest.ScansMatchReference EpochReplicasTest.ReadersSeeWholeWrites WorkStealingPoolTest.RunsEveryTaskOnce ImageHashTest.SimilarImagesHaveCloseHashes ImageIndexTest.NearestMatchesScan ItemClaimsTest.RolledBackCheckoutDoesNotStealItems SessionStoreTest.TokensExpireAfterIdleTtl FilterKernelTest.AllImplementationsAgree RoaringBitmapTest.SetOperationsMatchReference)
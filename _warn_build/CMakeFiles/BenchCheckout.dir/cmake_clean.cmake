@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchCheckout"
+  "BenchCheckout.pdb"
+  "CMakeFiles/BenchCheckout.dir/bench/BenchCheckout.cpp.o"
+  "CMakeFiles/BenchCheckout.dir/bench/BenchCheckout.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchCheckout.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchFilter"
+  "BenchFilter.pdb"
+  "CMakeFiles/BenchFilter.dir/bench/BenchFilter.cpp.o"
+  "CMakeFiles/BenchFilter.dir/bench/BenchFilter.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchFilter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchFuzzySearch"
+  "BenchFuzzySearch.pdb"
+  "CMakeFiles/BenchFuzzySearch.dir/bench/BenchFuzzySearch.cpp.o"
+  "CMakeFiles/BenchFuzzySearch.dir/bench/BenchFuzzySearch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchFuzzySearch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchImageSearch"
+  "BenchImageSearch.pdb"
+  "CMakeFiles/BenchImageSearch.dir/bench/BenchImageSearch.cpp.o"
+  "CMakeFiles/BenchImageSearch.dir/bench/BenchImageSearch.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchImageSearch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchLookup"
+  "BenchLookup.pdb"
+  "CMakeFiles/BenchLookup.dir/bench/BenchLookup.cpp.o"
+  "CMakeFiles/BenchLookup.dir/bench/BenchLookup.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchLookup.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
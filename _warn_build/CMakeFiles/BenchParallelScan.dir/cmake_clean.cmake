@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchParallelScan"
+  "BenchParallelScan.pdb"
+  "CMakeFiles/BenchParallelScan.dir/bench/BenchParallelScan.cpp.o"
+  "CMakeFiles/BenchParallelScan.dir/bench/BenchParallelScan.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchParallelScan.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchRelevance"
+  "BenchRelevance.pdb"
+  "CMakeFiles/BenchRelevance.dir/bench/BenchRelevance.cpp.o"
+  "CMakeFiles/BenchRelevance.dir/bench/BenchRelevance.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchRelevance.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
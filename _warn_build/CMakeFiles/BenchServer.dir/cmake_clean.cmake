@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchServer"
+  "BenchServer.pdb"
+  "CMakeFiles/BenchServer.dir/bench/BenchServer.cpp.o"
+  "CMakeFiles/BenchServer.dir/bench/BenchServer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchServer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
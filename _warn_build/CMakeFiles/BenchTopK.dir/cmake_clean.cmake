@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BenchTopK"
+  "BenchTopK.pdb"
+  "CMakeFiles/BenchTopK.dir/bench/BenchTopK.cpp.o"
+  "CMakeFiles/BenchTopK.dir/bench/BenchTopK.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BenchTopK.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RunTests.dir/tests/TestPlatform.cpp.o"
+  "CMakeFiles/RunTests.dir/tests/TestPlatform.cpp.o.d"
+  "RunTests"
+  "RunTests.pdb"
+  "RunTests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RunTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/trading_server.dir/src/RequestHandler.cpp.o"
+  "CMakeFiles/trading_server.dir/src/RequestHandler.cpp.o.d"
+  "CMakeFiles/trading_server.dir/src/TradingServer.cpp.o"
+  "CMakeFiles/trading_server.dir/src/TradingServer.cpp.o.d"
+  "CMakeFiles/trading_server.dir/src/WireClient.cpp.o"
+  "CMakeFiles/trading_server.dir/src/WireClient.cpp.o.d"
+  "CMakeFiles/trading_server.dir/src/WireProtocol.cpp.o"
+  "CMakeFiles/trading_server.dir/src/WireProtocol.cpp.o.d"
+  "libtrading_server.a"
+  "libtrading_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/trading_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
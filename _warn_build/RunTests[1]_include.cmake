@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/RunTests[1]_tests.cmake")
+  include("/root/repo/_warn_build/RunTests[1]_tests.cmake")
+else()
+  add_test(RunTests_NOT_BUILT RunTests_NOT_BUILT)
+endif()
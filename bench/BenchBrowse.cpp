@@ -0,0 +1,82 @@
+// 浏览商品的分配次数与耗时基准
+// 用法: BenchBrowse [商品数，默认 100000]
+// 对比复制接口 getAvailableItems() 与视图接口 viewAvailableItems() 浏览全部在售商品时
+// 发生的堆分配次数和耗时。视图只分配指针数组和一次副本登记，不复制任何商品。
+// 最后给出游标分页取首页和取第 1000 页的耗时，按ID分页时两者应当相同。
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "BenchUtil.h"
+
+namespace {
+long long allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+volatile double sink = 0;
+
+template <typename Browse>
+void measure(const char* name, Browse browse) {
+    long long before = allocations;
+    bench::Clock::time_point start = bench::Clock::now();
+    double total = browse();
+    bench::Clock::time_point end = bench::Clock::now();
+    sink += total;
+    std::printf("%-22s %12lld %12.2f\n", name, allocations - before, bench::millis(start, end));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    TradingPlatform platform;
+    bench::fillCatalog(platform, n);
+
+    std::printf("browsing %d listings\n", n);
+    std::printf("%-22s %12s %12s\n", "api", "allocations", "ms");
+    measure("getAvailableItems()", [&platform]() {
+        double total = 0;
+        for (const auto& item : platform.getAvailableItems()) {
+            total += item.getPrice() + item.getItemName().size();
+        }
+        return total;
+    });
+    measure("viewAvailableItems()", [&platform]() {
+        double total = 0;
+        for (const auto& item : platform.viewAvailableItems()) {
+            total += item.getPrice() + item.getItemName().size();
+        }
+        return total;
+    });
+
+    std::printf("\n%-22s %12s\n", "page (size 20)", "us");
+    PageRequest request(20);
+    ItemPage page;
+    for (int pageNo = 1; pageNo <= 1000 && platform.browseItems(request, page); ++pageNo) {
+        if (pageNo == 1 || pageNo == 1000) {
+            bench::Clock::time_point start = bench::Clock::now();
+            platform.browseItems(request, page);
+            bench::Clock::time_point end = bench::Clock::now();
+            std::printf("page %-17d %12.2f\n", pageNo, bench::nanosPerOp(start, end, 1000));
+        }
+        if (!page.hasMore()) break;
+        request.cursor = page.nextCursor;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// 批量发布与批量改状态的吞吐量基准
+// 用法: BenchBulkPublish [商品数，默认 100000] [已有商品数，默认 100000]
+// 在已有 m 件商品的平台上：
+//   发布 n 件：逐件 publishItem 对比 publishItems（每批 100 / 500 / 全部）
+//   下架这 n 件：逐件 deleteItem 对比 setStatusBatch（每批 100 / 500 / 全部）
+// 每种方式在新建的平台上运行，给出每秒处理的商品数及相对逐件调用的倍数。
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+std::vector<ItemDraft> makeDrafts(int n) {
+    static const char* categories[] = {"书籍", "电子产品", "自行车", "生活用品", "服饰"};
+    std::vector<ItemDraft> drafts;
+    drafts.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        drafts.push_back(ItemDraft{"清仓" + std::to_string(i), "毕业清仓，校内自提", categories[i % 5], 5.0 + i % 500, {}});
+    }
+    return drafts;
+}
+
+// batch 为 0 表示逐件调用；返回 {发布耗时, 下架耗时}（毫秒）
+std::pair<double, double> run(int n, int existing, const std::vector<ItemDraft>& drafts, int batch) {
+    TradingPlatform platform;
+    int sellerId = bench::fillCatalog(platform, existing);
+    std::vector<int> ids;
+    ids.reserve(n);
+
+    bench::Clock::time_point start = bench::Clock::now();
+    if (batch == 0) {
+        for (const ItemDraft& d : drafts) ids.push_back(platform.publishItem(d.name, d.description, d.category, d.price, sellerId));
+    } else {
+        for (int begin = 0; begin < n; begin += batch) {
+            std::vector<ItemDraft> part(drafts.begin() + begin, drafts.begin() + std::min(n, begin + batch));
+            std::vector<int> got = platform.publishItems(part, sellerId);
+            ids.insert(ids.end(), got.begin(), got.end());
+        }
+    }
+    double publishMs = bench::millis(start, bench::Clock::now());
+
+    start = bench::Clock::now();
+    int changed = 0;
+    if (batch == 0) {
+        for (int id : ids) changed += platform.deleteItem(id, sellerId);
+    } else {
+        for (int begin = 0; begin < n; begin += batch) {
+            std::vector<int> part(ids.begin() + begin, ids.begin() + std::min(n, begin + batch));
+            changed += platform.setStatusBatch(part, DELETED, sellerId);
+        }
+    }
+    double retireMs = bench::millis(start, bench::Clock::now());
+    if (changed != n || platform.getCatalogStats().liveRows != existing) std::printf("  MISMATCH\n");
+    return std::make_pair(publishMs, retireMs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int existing = argc > 2 ? std::atoi(argv[2]) : 100000;
+    std::vector<ItemDraft> drafts = makeDrafts(n);
+    std::printf("-- %d items onto %d existing\n", n, existing);
+    std::printf("%10s %14s %8s %14s %8s\n", "batch", "publish/s", "speedup", "retire/s", "speedup");
+    const int batches[] = {0, 100, 500, n};
+    double basePublish = 0, baseRetire = 0;
+    for (int batch : batches) {
+        std::pair<double, double> ms = run(n, existing, drafts, batch);
+        double publish = n / (ms.first / 1000.0);
+        double retire = n / (ms.second / 1000.0);
+        if (batch == 0) {
+            basePublish = publish;
+            baseRetire = retire;
+        }
+        std::printf("%10s %14.0f %8.2f %14.0f %8.2f\n", batch == 0 ? "single" : std::to_string(batch).c_str(), publish,
+                    publish / basePublish, retire, retire / baseRetire);
+    }
+    return 0;
+}
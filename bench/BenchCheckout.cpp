@@ -0,0 +1,97 @@
+// 购物车结账基准
+// 用法: BenchCheckout [热门商品数，默认 20000] [每个线程的购物车数，默认 200] [最大线程数，默认 8]
+// 每个线程反复把随机 50 件热门商品放进自己的购物车后购买，线程之间争抢同一批商品。对比：
+//   checkout   checkout(userId)：整车一次预留，全部买下或一件不买，一次写入更新索引
+//   per-item   对购物车中的商品逐件调用 purchaseItem，可能只买到一部分
+// 给出每秒处理的购物车数、买下的商品数，以及逐件购买中只买到一部分的购物车占比；
+// 结束后核对每件商品至多卖出一次，否则标出 DOUBLE-SELL。
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+const int kCartSize = 50;
+
+struct Run {
+    double cartsPerSecond;
+    double itemsPerSecond;
+    double partialRatio;
+    bool soldOnce;
+};
+
+Run contend(int n, int carts, int threads, bool batch) {
+    TradingPlatform platform;
+    bench::fillCatalog(platform, n);
+    std::vector<std::shared_ptr<RegularUser>> buyers;
+    for (int t = 0; t < threads; ++t) {
+        std::string email = "buyer" + std::to_string(t) + "@nju.edu.cn";
+        platform.registerUser("buyer", "pwd", email, "2", "2", "B", "CS", REGULAR_USER);
+        // 各线程只改自己的买家，直接取平台里的用户对象
+        buyers.push_back(std::dynamic_pointer_cast<RegularUser>(platform.users[platform.login(email, "pwd") - 1]));
+    }
+
+    std::atomic<long> bought(0);
+    std::atomic<long> partial(0);
+    std::vector<std::thread> pool;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            std::mt19937 rng(100 + t);
+            RegularUser& buyer = *buyers[t];
+            long localBought = 0;
+            long localPartial = 0;
+            std::vector<int> cart;
+            for (int c = 0; c < carts; ++c) {
+                cart.clear();
+                for (int k = 0; k < kCartSize; ++k) cart.push_back(1 + static_cast<int>(rng() % n));
+                if (batch) {
+                    // 购物车只有本线程在改，直接填入，省去 addToCart 的逐件输出
+                    buyer.cartItems = cart;
+                    size_t before = buyer.purchasedItems.size();
+                    if (platform.checkout(buyer.getUserId())) localBought += buyer.purchasedItems.size() - before;
+                    buyer.cartItems.clear();
+                } else {
+                    int got = 0;
+                    for (int id : cart) got += platform.purchaseItem(id, buyer.getUserId());
+                    localBought += got;
+                    localPartial += got > 0 && got < kCartSize;
+                }
+            }
+            bought += localBought;
+            partial += localPartial;
+        });
+    }
+    for (auto& th : pool) th.join();
+    double seconds = bench::millis(start, bench::Clock::now()) / 1000.0;
+
+    size_t records = 0;
+    for (const auto& buyer : buyers) records += buyer->purchasedItems.size();
+    bool once = static_cast<long>(records) == bought && platform.getCatalogStats().soldRows == bought;
+    double total = static_cast<double>(carts) * threads;
+    return Run{total / seconds, bought / seconds, partial / total, once};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int carts = argc > 2 ? std::atoi(argv[2]) : 200;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : 8;
+    std::printf("-- %d hot items, %d carts of %d per thread, hardware threads %u\n", n, carts, kCartSize,
+                std::thread::hardware_concurrency());
+    std::printf("%8s %10s %12s %12s %10s\n", "threads", "mode", "carts/s", "items/s", "partial");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        for (int batch = 1; batch >= 0; --batch) {
+            Run run = contend(n, carts, threads, batch != 0);
+            std::printf("%8d %10s %12.0f %12.0f %9.1f%%%s\n", threads, batch ? "checkout" : "per-item", run.cartsPerSecond,
+                        run.itemsPerSecond, run.partialRatio * 100, run.soldOnce ? "" : "  DOUBLE-SELL");
+        }
+    }
+    return 0;
+}
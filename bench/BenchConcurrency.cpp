@@ -0,0 +1,113 @@
+// 多线程吞吐量基准
+// 用法: BenchConcurrency [商品数，默认 100000] [每个线程的操作数，默认 20000] [最大线程数，默认 8]
+// 每个线程按给定的读比例随机执行操作：
+//   读：搜索分页（关键词 + 排序，约一半命中缓存） / 按价格浏览首页 / findItemById
+//   写：购买随机商品 / 发布商品 / 修改随机商品的价格
+// 对 100% / 95% / 80% / 50% 读比例和 1、2、4…个线程给出总吞吐量及相对单线程的倍数。
+// 每种配置都在新建的平台上运行，售出的商品不会累积到下一种配置。
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kKeywords[] = {"商品1", "商品2", "商品33", "商品404", "九成新", "商品5", "商品77", "商品8"};
+const char* kSorts[] = {"price_asc", "newest", "price_desc"};
+
+struct Platform {
+    TradingPlatform platform;
+    int sellerId;
+    std::vector<int> buyers;
+};
+
+void fill(Platform& p, int n, int threads) {
+    p.sellerId = bench::fillCatalog(p.platform, n);
+    for (int t = 0; t < threads; ++t) {
+        std::string email = "buyer" + std::to_string(t) + "@nju.edu.cn";
+        p.platform.registerUser("buyer", "pwd", email, "2", "2", "B", "CS", REGULAR_USER);
+        p.buyers.push_back(p.platform.login(email, "pwd"));
+    }
+}
+
+void worker(Platform& p, int n, int ops, int readPercent, unsigned seed, int buyerId) {
+    std::mt19937 rng(seed);
+    size_t local = 0;
+    for (int i = 0; i < ops; ++i) {
+        int dice = static_cast<int>(rng() % 100);
+        int itemId = 1 + static_cast<int>(rng() % n);
+        if (dice < readPercent) {
+            switch (rng() % 3) {
+                case 0: {
+                    SearchCriteria criteria;
+                    criteria.setKeyword(kKeywords[rng() % 8]);
+                    criteria.setSortBy(kSorts[rng() % 3]);
+                    criteria.setPage(20);
+                    ItemPage page;
+                    p.platform.searchItems(criteria, page);
+                    local += page.items.size();
+                    break;
+                }
+                case 1: {
+                    ItemPage page;
+                    p.platform.browseItems(PageRequest(20, ORDER_BY_PRICE_ASC), page);
+                    local += page.items.size();
+                    break;
+                }
+                default: {
+                    auto item = p.platform.findItemById(itemId);
+                    local += item ? item->getSellerId() : 0;
+                }
+            }
+        } else {
+            switch (rng() % 3) {
+                case 0:
+                    local += p.platform.purchaseItem(itemId, buyerId);
+                    break;
+                case 1:
+                    local += p.platform.publishItem("新品" + std::to_string(i), "全新", "生活用品", 20, p.sellerId);
+                    break;
+                default:
+                    local += p.platform.updateItem(itemId, p.sellerId, "商品" + std::to_string(itemId - 1), "九成新，校内自提",
+                                                   "生活用品", 10.0 + rng() % 1000);
+            }
+        }
+    }
+    sink += local;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int ops = argc > 2 ? std::atoi(argv[2]) : 20000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : 8;
+    std::printf("-- %d items, %d ops per thread, hardware threads %u\n", n, ops, std::thread::hardware_concurrency());
+    std::printf("%6s %8s %14s %8s\n", "read%", "threads", "ops/s", "scale");
+
+    const int readMixes[] = {100, 95, 80, 50};
+    for (int readPercent : readMixes) {
+        double single = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            Platform p;
+            fill(p, n, threads);
+            std::vector<std::thread> pool;
+            bench::Clock::time_point start = bench::Clock::now();
+            for (int t = 0; t < threads; ++t) {
+                pool.emplace_back(worker, std::ref(p), n, ops, readPercent, 1000u + t, p.buyers[t]);
+            }
+            for (auto& th : pool) th.join();
+            double seconds = bench::millis(start, bench::Clock::now()) / 1000.0;
+            double throughput = static_cast<double>(ops) * threads / seconds;
+            if (threads == 1) single = throughput;
+            std::printf("%6d %8d %14.0f %8.2f\n", readPercent, threads, throughput, throughput / single);
+        }
+    }
+    return 0;
+}
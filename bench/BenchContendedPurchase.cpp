@@ -0,0 +1,77 @@
+// 热门商品抢购基准
+// 用法: BenchContendedPurchase [商品数，默认 20000] [最大线程数，默认 8]
+// 所有线程按同样的顺序逐件尝试购买同一批商品，每件商品都被全部线程争抢。
+// 对比两种购买路径的总尝试次数/秒：
+//   cas    平台的 purchaseItem：状态字比较交换决出买家，失败者只持读锁
+//   mutex  同样的调用外面再套一把全局互斥锁，模拟“先检查再修改”整体串行的做法
+// 每种配置结束后核对：每件商品恰好一个买家，各买家购买记录之和等于商品数，否则标出 DOUBLE-SELL。
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+struct Run {
+    double attemptsPerSecond;
+    bool exactlyOnce;
+};
+
+Run contend(int n, int threads, bool globalMutex) {
+    TradingPlatform platform;
+    bench::fillCatalog(platform, n);
+    std::vector<int> buyers;
+    for (int t = 0; t < threads; ++t) {
+        std::string email = "buyer" + std::to_string(t) + "@nju.edu.cn";
+        platform.registerUser("buyer", "pwd", email, "2", "2", "B", "CS", REGULAR_USER);
+        buyers.push_back(platform.login(email, "pwd"));
+    }
+
+    std::mutex serial;
+    std::atomic<int> wins(0);
+    std::vector<std::thread> pool;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            int local = 0;
+            for (int itemId = 1; itemId <= n; ++itemId) {
+                if (globalMutex) {
+                    std::lock_guard<std::mutex> guard(serial);
+                    local += platform.purchaseItem(itemId, buyers[t]);
+                } else {
+                    local += platform.purchaseItem(itemId, buyers[t]);
+                }
+            }
+            wins += local;
+        });
+    }
+    for (auto& th : pool) th.join();
+    double seconds = bench::millis(start, bench::Clock::now()) / 1000.0;
+
+    size_t records = 0;
+    for (int buyer : buyers) {
+        records += std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyer))->purchasedItems.size();
+    }
+    bool once = wins == n && records == static_cast<size_t>(n) && platform.getCatalogStats().soldRows == n;
+    return Run{static_cast<double>(n) * threads / seconds, once};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 8;
+    std::printf("-- %d hot items, hardware threads %u\n", n, std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s\n", "threads", "cas attempts/s", "mutex attempts/s");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        Run cas = contend(n, threads, false);
+        Run serial = contend(n, threads, true);
+        std::printf("%8d %16.0f %16.0f%s\n", threads, cas.attemptsPerSecond, serial.attemptsPerSecond,
+                    cas.exactlyOnce && serial.exactlyOnce ? "" : "  DOUBLE-SELL");
+    }
+    return 0;
+}
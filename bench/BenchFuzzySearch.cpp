@@ -0,0 +1,82 @@
+// 近似搜索的基准
+// 用法: BenchFuzzySearch [商品数，默认 1000000]
+// 对带错字的关键词做近似搜索，与同一关键词改正后的精确搜索对比单次耗时，
+// 并给出不走索引、逐件用位并行编辑距离核对的扫描耗时。
+// 候选数为各分段候选集之并的大小，即真正核对原文的商品数。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kBrands[] = {"Giant", "Logitech", "Xiaomi", "Apple", "Sony", "Yonex", "Dell", "Nike", "Casio", "Kindle"};
+const char* kProducts[] = {"山地自行车", "机械键盘", "台灯", "高等数学教材", "蓝牙耳机",
+                           "羽毛球拍", "电饭煲", "显示器", "运动鞋", "考研资料"};
+const char* kConditions[] = {"九成新", "全新未拆", "轻微划痕", "功能完好", "宿舍自提"};
+
+void fill(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(7);
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(kBrands[rng() % 10]) + " " + kProducts[rng() % 10] + " SN" + std::to_string(i);
+        std::string desc = std::string(kConditions[rng() % 5]) + "，校内面交";
+        platform.publishItem(name, desc, "综合", 10.0 + i % 1000, sellerId);
+    }
+}
+
+template <typename Search>
+double timeQuery(Search search, int rounds, size_t& hits) {
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        ItemView view = search();
+        hits = view.size();
+        sink += hits;
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    return bench::millis(start, end) * 1000.0 / rounds;
+}
+
+struct Query {
+    const char* typed;     // 带错字的输入
+    int maxDistance;
+    const char* correct;   // 改正后的关键词
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    TradingPlatform platform;
+    fill(platform, n);
+    ItemView all = platform.viewAvailableItems();
+    std::printf("-- %d items\n", n);
+    std::printf("%-20s %2s %10s %10s %10s %12s %12s %12s\n", "typed", "k", "candidates", "hits", "exact hits",
+                "exact us/q", "fuzzy us/q", "scan us/q");
+
+    // 换位、同音错字、漏字、编号末位写错
+    const Query queries[] = {{"Logitehc", 2, "Logitech"},
+                             {"机戒键盘", 1, "机械键盘"},
+                             {"考研资科", 1, "考研资料"},
+                             {"羽毛拍", 1, "羽毛球拍"},
+                             {"SN98765X", 1, "SN98765"}};
+    for (const Query& q : queries) {
+        size_t exactHits = 0, fuzzyHits = 0, scanHits = 0;
+        double exactUs = timeQuery([&] { return SearchEngine::textSearch(platform.items, q.correct); }, 5, exactHits);
+        double fuzzyUs =
+            timeQuery([&] { return SearchEngine::fuzzySearch(platform.items, q.typed, q.maxDistance); }, 5, fuzzyHits);
+        double scanUs = timeQuery([&] { return SearchEngine::fuzzySearch(all, q.typed, q.maxDistance); }, 1, scanHits);
+        SearchCriteria criteria;
+        criteria.setKeyword(q.typed);
+        criteria.setMaxDistance(q.maxDistance);
+        QueryPlan plan = criteria.plan(platform.items);
+        std::printf("%-20s %2d %10.0f %10zu %10zu %12.1f %12.1f %12.1f%s\n", q.typed, q.maxDistance,
+                    plan.keywordRows, fuzzyHits, exactHits, exactUs, fuzzyUs, scanUs,
+                    fuzzyHits == scanHits ? "" : "  MISMATCH");
+    }
+    return 0;
+}
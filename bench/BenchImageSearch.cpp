@@ -0,0 +1,86 @@
+// 按图搜索的基准
+// 用法: BenchImageSearch [图片数，默认 1000000]
+// 直接往图片哈希索引里放 n 个差异哈希：每 8 个围绕同一个随机中心、各自翻转 0~6 位（同款商品的不同照片），
+// 对已有照片稍作改动后查询，比较多索引哈希表与顺序扫描（AVX2/POPCNT）的单次耗时，
+// 结果不一致时标出 MISMATCH。另给出一张 640x480 灰度图计算差异哈希的耗时。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "BenchUtil.h"
+#include "ImageHash.h"
+#include "ImageIndex.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+uint64_t flipBits(uint64_t hash, int flips, std::mt19937_64& rng) {
+    for (int i = 0; i < flips; ++i) hash ^= uint64_t(1) << (rng() % 64);
+    return hash;
+}
+
+bool sameMatches(const std::vector<ImageMatch>& a, const std::vector<ImageMatch>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].itemId != b[i].itemId || a[i].distance != b[i].distance) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> hashes;
+    hashes.reserve(n);
+    uint64_t center = 0;
+    for (int i = 0; i < n; ++i) {
+        if (i % 8 == 0) center = rng();
+        hashes.push_back(flipBits(center, rng() % 7, rng));
+    }
+
+    ImageIndex index;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int i = 0; i < n; ++i) index.add(i / 2 + 1, hashes[i]);
+    double buildMs = bench::millis(start, bench::Clock::now());
+    std::printf("-- %d hashes, build %.0f ms, %.1f MB\n", n, buildMs, index.memoryBytes() / 1048576.0);
+
+    const int queries = 200;
+    std::vector<uint64_t> probes;
+    for (int q = 0; q < queries; ++q) probes.push_back(flipBits(hashes[rng() % n], 3, rng));
+
+    std::printf("%6s %6s %10s %14s %12s\n", "limit", "maxd", "hits/q", "index us/q", "scan us/q");
+    struct Case {
+        size_t limit;
+        int maxDistance;
+    };
+    const Case cases[] = {{1, 10}, {10, 10}, {10, 16}, {100, 24}, {0, 8}};
+    for (const Case& c : cases) {
+        size_t hits = 0;
+        bool same = true;
+        start = bench::Clock::now();
+        for (uint64_t probe : probes) hits += index.nearest(probe, c.limit, c.maxDistance).size();
+        double indexUs = bench::millis(start, bench::Clock::now()) * 1000.0 / queries;
+        start = bench::Clock::now();
+        for (uint64_t probe : probes) sink += index.scan(probe, c.limit, c.maxDistance).size();
+        double scanUs = bench::millis(start, bench::Clock::now()) * 1000.0 / queries;
+        for (int q = 0; q < 20; ++q) {
+            same = same && sameMatches(index.nearest(probes[q], c.limit, c.maxDistance),
+                                       index.scan(probes[q], c.limit, c.maxDistance));
+        }
+        std::printf("%6zu %6d %10.1f %14.1f %12.1f%s\n", c.limit, c.maxDistance, static_cast<double>(hits) / queries,
+                    indexUs, scanUs, same ? "" : "  MISMATCH");
+    }
+
+    GrayImage photo(640, 480);
+    for (int y = 0; y < photo.height; ++y) {
+        for (int x = 0; x < photo.width; ++x) photo.at(x, y) = static_cast<uint8_t>((x * 7 + y * 3 + x * y / 97) & 0xff);
+    }
+    const int rounds = 200;
+    start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) sink += differenceHash(photo);
+    std::printf("dHash 640x480: %.1f us\n", bench::millis(start, bench::Clock::now()) * 1000.0 / rounds);
+    return 0;
+}
@@ -0,0 +1,67 @@
+// 商品/用户按ID查找的规模基准
+// 用法: BenchLookup [最大商品数，默认 1000000]
+// 分别在 1k / 10k / 100k / 1M 商品规模下随机查找，输出每次查找的平均耗时，
+// 同时给出旧实现（对 std::vector<Item> 线性 find_if）在同规模下的耗时作为对照。
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+using bench::Clock;
+using bench::nanosPerOp;
+
+// 防止编译器把查找结果优化掉
+volatile long long sink = 0;
+
+void runSize(int n) {
+    TradingPlatform platform;
+    bench::fillCatalog(platform, n);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(1, n);
+    const long lookups = 2000000;
+    std::vector<int> ids(lookups);
+    for (long i = 0; i < lookups; ++i) ids[i] = pick(rng);
+
+    Clock::time_point start = Clock::now();
+    long long acc = 0;
+    for (long i = 0; i < lookups; ++i) {
+        platform.readItem(ids[i], [&acc](const Item& item) { acc += item.getSellerId(); });
+    }
+    Clock::time_point end = Clock::now();
+    sink += acc;
+    double indexed = nanosPerOp(start, end, lookups);
+
+    // 旧实现对照：线性扫描，规模越大查找次数越少，避免基准跑太久
+    std::vector<Item> legacy(platform.items.begin(), platform.items.end());
+    long scans = std::max(20L, 20000000L / n);
+    start = Clock::now();
+    for (long i = 0; i < scans; ++i) {
+        int target = ids[i % lookups];
+        auto it = std::find_if(legacy.begin(), legacy.end(), [target](const Item& item) {
+            return item.getItemId() == target;
+        });
+        acc += it->getSellerId();
+    }
+    end = Clock::now();
+    sink += acc;
+    double linear = nanosPerOp(start, end, scans);
+
+    std::printf("%10d %18.1f %18.1f\n", n, indexed, linear);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxItems = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("%10s %18s %18s\n", "items", "indexed ns/op", "linear ns/op");
+    for (int n = 1000; n <= maxItems; n *= 10) {
+        runSize(n);
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+// 商品/用户记录的内存占用基准
+// 用法: BenchMemory [商品数，默认 200000]
+// 统计建立 n 条记录时的堆分配次数和常驻堆字节数（含记录本身），对比：
+//   旧布局   每个文本字段一个 std::string（Item 5 个、User 7 个）
+//   自持文本 RecordText 把一条记录的文本放在一次分配里（复制出来的 Item / 所有 User）
+//   商品表   ItemStore 把文本写入文本区，另外包含列存、分区和分类位图
+// 字节数不含 malloc 自身每块约 16 字节的管理开销，分配次数越多，实际差距比表中更大。
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "BenchUtil.h"
+#include "ItemStore.h"
+
+namespace {
+long long allocations = 0;
+long long liveBytes = 0;
+
+// 在每块内存前记录大小，释放时扣除
+const std::size_t kHeader = 16;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    char* p = static_cast<char*>(std::malloc(size + kHeader));
+    if (!p) throw std::bad_alloc();
+    *reinterpret_cast<std::size_t*>(p) = size;
+    liveBytes += static_cast<long long>(size);
+    return p + kHeader;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    char* base = static_cast<char*>(p) - kHeader;
+    liveBytes -= static_cast<long long>(*reinterpret_cast<std::size_t*>(base));
+    std::free(base);
+}
+
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete(p); }
+
+namespace {
+
+// 改造前的记录布局
+struct LegacyItem {
+    int itemId;
+    std::string itemName;
+    std::string description;
+    std::string category;
+    double price;
+    std::vector<std::string> images;
+    ItemStatus status;
+    std::string publishDate;
+    int sellerId;
+};
+
+struct LegacyUser {
+    int userId;
+    std::string username, password, email, phone, studentId, realName, college;
+    UserRole role;
+};
+
+const char* kCategories[] = {"书籍", "电子产品", "自行车", "生活用品", "服饰"};
+
+// 源数据提前生成好，计量期间只统计记录本身的分配
+struct Source {
+    std::vector<std::string> names, descs;
+    std::vector<LegacyUser> users;
+
+    explicit Source(int n) {
+        for (int i = 0; i < n; ++i) {
+            std::string id = std::to_string(i);
+            names.push_back("二手教材《高等数学》第" + std::to_string(i % 7 + 1) + "版");
+            descs.push_back("九成新，无笔记，仙林校区宿舍楼下自提，可小刀 #" + id);
+            users.push_back(LegacyUser{i + 1, "student" + id, "password" + id, "student" + id + "@smail.nju.edu.cn",
+                                       "139" + id, "2312400" + id, "张同学" + id, "匡亚明学院", REGULAR_USER});
+        }
+    }
+};
+
+struct Usage {
+    long long allocations;
+    long long bytes;
+};
+
+template <typename Build>
+Usage measure(Build build) {
+    long long allocBefore = allocations;
+    long long bytesBefore = liveBytes;
+    build();
+    return Usage{allocations - allocBefore, liveBytes - bytesBefore};
+}
+
+void report(const char* name, Usage usage, int n, size_t recordSize) {
+    std::printf("%-22s %10zu %14.2f %14.1f\n", name, recordSize,
+                static_cast<double>(usage.allocations) / n, static_cast<double>(usage.bytes) / n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+    Source src(n);
+    const std::string category[] = {kCategories[0], kCategories[1], kCategories[2], kCategories[3], kCategories[4]};
+    const std::string date = "2024-05-01";
+    std::printf("%-22s %10s %14s %14s\n", "records", "sizeof", "mallocs/rec", "heap B/rec");
+
+    std::vector<LegacyItem> legacyItems;
+    Usage legacy = measure([&] {
+        legacyItems.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            legacyItems.push_back(LegacyItem{i + 1, src.names[i], src.descs[i], category[i % 5], 10.0 + i % 1000,
+                                             {}, AVAILABLE, date, 1});
+        }
+    });
+    report("items: legacy", legacy, n, sizeof(LegacyItem));
+
+    std::vector<Item> ownedItems;
+    Usage owned = measure([&] {
+        ownedItems.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            ownedItems.emplace_back(i + 1, src.names[i], src.descs[i], category[i % 5], 10.0 + i % 1000, 1);
+        }
+    });
+    report("items: owned text", owned, n, sizeof(Item));
+
+    // 商品表：Item 临时对象的那次分配会在写入文本区后释放，只计入分配次数
+    ItemStore* store = nullptr;
+    Usage arena = measure([&] {
+        store = new ItemStore();
+        for (int i = 0; i < n; ++i) {
+            store->add(Item(i + 1, src.names[i], src.descs[i], category[i % 5], 10.0 + i % 1000, 1));
+        }
+    });
+    report("items: ItemStore", arena, n, sizeof(Item));
+    CatalogStats stats = store->stats();
+    std::printf("  text arena: %.1f B/item used\n", static_cast<double>(stats.textBytes) / n);
+
+    std::vector<LegacyUser> legacyUsers;
+    Usage legacyUser = measure([&] {
+        legacyUsers.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            legacyUsers.push_back(src.users[i]);
+        }
+    });
+    report("users: legacy", legacyUser, n, sizeof(LegacyUser));
+
+    std::vector<RegularUser> users;
+    Usage packedUser = measure([&] {
+        users.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            const LegacyUser& u = src.users[i];
+            users.emplace_back(u.userId, u.username, u.password, u.email, u.phone, u.studentId, u.realName, u.college);
+        }
+    });
+    report("users: owned text", packedUser, n, sizeof(RegularUser));
+
+    delete store;
+    return 0;
+}
@@ -0,0 +1,80 @@
+// 并行全表扫描的基准
+// 用法: BenchParallelScan [商品数，默认 1000000] [最大线程数，默认 32]
+// 对必须全表扫描的查询（关键词不能走索引、需要逐件核对原文；近似搜索的分段太短不能走索引），
+// 按 1、2、4…个线程分别计时，给出相对单线程的加速比。结果与单线程不一致时标出 MISMATCH。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kBrands[] = {"Giant", "Logitech", "Xiaomi", "Apple", "Sony", "Yonex", "Dell", "Nike", "Casio", "Kindle"};
+const char* kProducts[] = {"山地自行车", "机械键盘", "台灯", "高等数学教材", "蓝牙耳机",
+                           "羽毛球拍", "电饭煲", "显示器", "运动鞋", "考研资料"};
+const char* kConditions[] = {"九成新", "全新未拆", "轻微划痕", "功能完好", "宿舍自提"};
+
+void fill(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(7);
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(kBrands[rng() % 10]) + " " + kProducts[rng() % 10];
+        if (rng() % 4 == 0) name += " Wi-Fi";
+        std::string desc = std::string(kConditions[rng() % 5]) + "，校内面交";
+        platform.publishItem(name, desc, "综合", 10.0 + i % 1000, sellerId);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 32;
+    TradingPlatform platform;
+    fill(platform, n);
+    std::printf("-- %d items, hardware threads %u\n", n, std::thread::hardware_concurrency());
+
+    struct Query {
+        const char* label;
+        SearchCriteria criteria;
+    };
+    std::vector<Query> queries(3);
+    queries[0].label = "\"-\" all";
+    queries[0].criteria.setKeyword("-");
+    queries[1].label = "\"-\" newest top20";
+    queries[1].criteria.setKeyword("-");
+    queries[1].criteria.setSortBy("newest");
+    queries[1].criteria.setLimit(20);
+    queries[2].label = "fuzzy \"Wi Fi\" k=1";
+    queries[2].criteria.setKeyword("Wi Fi");
+    queries[2].criteria.setMaxDistance(1);
+
+    std::printf("%-24s %8s %10s %12s %8s\n", "query", "threads", "hits", "us/q", "speedup");
+    for (Query& q : queries) {
+        std::vector<int> reference;
+        double serialUs = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            q.criteria.setThreads(threads);
+            const int rounds = 5;
+            ItemView view;
+            bench::Clock::time_point start = bench::Clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                view = q.criteria.select(platform.items);
+                sink += view.size();
+            }
+            double us = bench::millis(start, bench::Clock::now()) * 1000.0 / rounds;
+            if (threads == 1) {
+                serialUs = us;
+                reference = view.ids();
+            }
+            std::printf("%-24s %8d %10zu %12.1f %8.2f%s\n", q.label, threads, view.size(), us, serialUs / us,
+                        view.ids() == reference ? "" : "  MISMATCH");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// 价格区间查询的基准
+// 用法: BenchPriceRange [最大商品数，默认 1000000]
+// 20 个分类、价格在 1~2000 元之间均匀分布，最常见的查询是“教材 30 元以下”（约占全部商品的 0.07%）。
+// 对比商品表上的查询（SearchCriteria::select(商品表)）与逐条判断的视图扫描，
+// 另外给出按价格排序取前 20 件和按价格分页翻到第 5 页的耗时，以及查询计划选中的访问路径。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+void fill(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(11);
+    for (int i = 0; i < n; ++i) {
+        std::string category = i % 20 == 0 ? "教材" : "分类" + std::to_string(i % 20);
+        platform.publishItem("商品" + std::to_string(i), "九成新", category, 1 + rng() % 2000, sellerId);
+    }
+}
+
+template <typename Query>
+double timeQuery(Query query, int rounds, size_t& hits) {
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        hits = query();
+        sink += hits;
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    return bench::millis(start, end) * 1000.0 / rounds;
+}
+
+SearchCriteria criteria(const char* category, double maxPrice, const char* sortBy, size_t limit) {
+    SearchCriteria c;
+    c.setCategory(category);
+    c.setPriceRange(0, maxPrice);
+    c.setSortBy(sortBy);
+    c.setLimit(limit);
+    return c;
+}
+
+void runSize(int n) {
+    TradingPlatform platform;
+    fill(platform, n);
+    ItemView all = platform.viewAvailableItems();
+    std::printf("-- %d items, price index %.1f MB\n", n, platform.items.priceIndex().memoryBytes() / 1048576.0);
+
+    struct Case {
+        const char* name;
+        SearchCriteria query;
+    } cases[] = {
+        {"教材 <= 30", criteria("教材", 30, "", 0)},
+        {"教材 <= 30, price_asc", criteria("教材", 30, "price_asc", 0)},
+        {"<= 30", criteria("", 30, "", 0)},
+        {"教材, price_asc K=20", criteria("教材", 1000000, "price_asc", 20)},
+        {"all, price_desc K=20", criteria("", 1000000, "price_desc", 20)},
+    };
+    for (const Case& c : cases) {
+        size_t storeHits = 0, scanHits = 0;
+        double indexed = timeQuery([&] { return c.query.select(platform.items).size(); }, 20, storeHits);
+        double scanned = timeQuery([&] { return c.query.select(all).size(); }, 3, scanHits);
+        std::printf("%-30s %10zu %14.1f %14.1f  %-14s%s\n", c.name, storeHits, indexed, scanned,
+                    accessPathName(c.query.plan(platform.items).path), storeHits == scanHits ? "" : "  MISMATCH");
+    }
+
+    size_t pageHits = 0;
+    double paged = timeQuery([&] {
+        PageRequest request(20, ORDER_BY_PRICE_ASC);
+        ItemPage page;
+        for (int i = 0; i < 5; ++i) {
+            platform.browseItems(request, page);
+            request.cursor = page.nextCursor;
+        }
+        return page.items.size();
+    }, 20, pageHits);
+    std::printf("%-30s %10zu %14.1f\n", "browse price_asc, 5 pages", pageHits, paged);
+    std::printf("%s", cases[0].query.explain(platform.items).c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxItems = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("%-30s %10s %14s %14s  %s\n", "query", "hits", "store us/q", "scan us/q", "plan");
+    for (int n = 10000; n <= maxItems; n *= 10) {
+        runSize(n);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// 相关度排序的基准
+// 用法: BenchRelevance [商品数，默认 1000000]
+// 对几个命中数不同的关键词按相关度取前 20 名，给出单次耗时、检查过的候选数和真正读原文计分的商品数，
+// 并与不限数量（全部计分再排序）的耗时对比。最后打印一个查询的计划说明。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kBrands[] = {"Giant", "Logitech", "Xiaomi", "Apple", "Sony", "Yonex", "Dell", "Nike", "Casio", "Kindle"};
+const char* kProducts[] = {"山地自行车", "机械键盘", "台灯", "高等数学教材", "蓝牙耳机",
+                           "羽毛球拍", "电饭煲", "显示器", "运动鞋", "考研资料"};
+const char* kConditions[] = {"九成新", "全新未拆", "轻微划痕", "功能完好", "宿舍自提"};
+const char* kExtras[] = {"", "送收纳袋", "配原装充电器", "附赠考研笔记", "可小刀", "毕业清仓"};
+
+void fill(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(7);
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(kBrands[rng() % 10]) + " " + kProducts[rng() % 10];
+        if (rng() % 2) name += " SN" + std::to_string(i);
+        std::string desc = std::string(kConditions[rng() % 5]) + "，" + kExtras[rng() % 6] + "，校内面交";
+        platform.publishItem(name, desc, "综合", 10.0 + i % 1000, sellerId);
+    }
+}
+
+double timeQuery(const SearchCriteria& criteria, const ItemStore& store, int rounds, QueryPlan& plan) {
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        plan = QueryPlan();
+        sink += criteria.select(store, &plan).size();
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    return bench::millis(start, end) * 1000.0 / rounds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    TradingPlatform platform;
+    fill(platform, n);
+    std::printf("-- %d items\n", n);
+    std::printf("%-20s %10s %10s %12s %12s\n", "query", "examined", "scored", "top20 us/q", "all us/q");
+
+    // “考研”同时出现在名称和描述里；“全新”只在描述里；“Logitech 机械”是两个片段
+    const char* queries[] = {"考研", "机械键盘", "Logitech 机械", "全新", "Sony", "SN12"};
+    for (const char* q : queries) {
+        SearchCriteria criteria;
+        criteria.setKeyword(q);
+        criteria.setSortBy("relevance");
+        criteria.setLimit(20);
+        QueryPlan top, all;
+        double topUs = timeQuery(criteria, platform.items, 20, top);
+        criteria.setLimit(0);
+        double allUs = timeQuery(criteria, platform.items, 3, all);
+        std::printf("%-20s %10zu %10zu %12.1f %12.1f\n", q, top.rowsExamined, top.rowsMatched, topUs, allUs);
+    }
+
+    SearchCriteria sample;
+    sample.setKeyword("考研");
+    sample.setSortBy("relevance,price_asc");
+    sample.setLimit(20);
+    std::printf("\n%s", sample.explain(platform.items).c_str());
+    return 0;
+}
@@ -0,0 +1,97 @@
+// 搜索结果缓存的基准
+// 用法: BenchSearchCache [商品数，默认 200000]
+// 反复执行几个热门查询（关键词“自行车”“显示器”、分类“书籍”），对比不经缓存的查询与缓存命中的耗时；
+// 再模拟混合负载：每 50 次查询穿插一次发布和一次购买，统计命中率和平均耗时。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kProducts[] = {"自行车", "显示器", "台灯", "机械键盘", "蓝牙耳机", "羽毛球拍", "电饭煲", "运动鞋"};
+const char* kCategories[] = {"书籍", "数码", "交通工具", "生活用品", "服饰"};
+
+int fill(TradingPlatform& platform, int n, std::mt19937& rng) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    for (int i = 0; i < n; ++i) {
+        platform.publishItem(std::string(kProducts[rng() % 8]) + " " + std::to_string(i), "校内自提",
+                             kCategories[rng() % 5], 10.0 + rng() % 1000, sellerId);
+    }
+    return sellerId;
+}
+
+struct HotQuery {
+    const char* name;
+    SearchCriteria criteria;
+};
+
+SearchCriteria keywordQuery(const char* keyword) {
+    SearchCriteria c;
+    c.setKeyword(keyword);
+    c.setSortBy("price_asc");
+    c.setLimit(20);
+    return c;
+}
+
+SearchCriteria categoryQuery(const char* category) {
+    SearchCriteria c;
+    c.setCategory(category);
+    c.setSortBy("newest");
+    c.setLimit(20);
+    return c;
+}
+
+template <typename Query>
+double timeQuery(Query query, int rounds) {
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) sink += query();
+    bench::Clock::time_point end = bench::Clock::now();
+    return bench::millis(start, end) * 1000.0 / rounds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::mt19937 rng(5);
+    TradingPlatform platform;
+    int sellerId = fill(platform, n, rng);
+    platform.registerUser("buyer", "pwd", "buyer@nju.edu.cn", "2", "2", "B", "CS", REGULAR_USER);
+    int buyerId = platform.login("buyer@nju.edu.cn", "pwd");
+
+    HotQuery hot[] = {
+        {"自行车 price_asc K=20", keywordQuery("自行车")},
+        {"显示器 price_asc K=20", keywordQuery("显示器")},
+        {"书籍 newest K=20", categoryQuery("书籍")},
+    };
+    std::printf("%d items\n%-28s %14s %14s\n", n, "query", "uncached us/q", "cached us/q");
+    for (const HotQuery& q : hot) {
+        double uncached = timeQuery([&] { return q.criteria.select(platform.items).size(); }, 50);
+        double cached = timeQuery([&] { return platform.viewSearchResults(q.criteria).size(); }, 1000);
+        std::printf("%-28s %14.1f %14.2f\n", q.name, uncached, cached);
+    }
+    // 混合负载：发布集中在“服饰”、购买随机
+    SearchCacheStats before = platform.getSearchCacheStats();
+    const int kQueries = 20000;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        if (i % 50 == 0) {
+            platform.publishItem("运动鞋 new" + std::to_string(i), "全新", "服饰", 99, sellerId);
+            platform.purchaseItem(1 + rng() % n, buyerId);
+        }
+        sink += platform.viewSearchResults(hot[i % 3].criteria).size();
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    SearchCacheStats after = platform.getSearchCacheStats();
+    unsigned long long hits = after.hits - before.hits;
+    unsigned long long misses = after.misses - before.misses;
+    std::printf("mixed: %d queries, hit rate %.1f%%, invalidations %llu, %.2f us/query\n", kQueries,
+                100.0 * hits / (hits + misses), after.invalidations - before.invalidations,
+                bench::millis(start, end) * 1000.0 / kQueries);
+    return 0;
+}
@@ -0,0 +1,192 @@
+// 网络前端压测：在本进程中启动 TradingServer，再由多个客户端线程经回环接口（TCP 和 Unix 域套接字）发请求
+// 用法: BenchServer [商品数，默认 100000] [连接数，默认 8] [流水线深度，默认 16] [每轮秒数，默认 2] [工作线程数，默认 4]
+// 请求按 5:3:2 混合按分类搜索（价格升序，一页 20 件）、按随机排序浏览首页、查看随机商品详情。
+// 不含关键词和价格区间搜索：它们每次要花几百微秒到几毫秒在平台的查询上（见 BenchTextSearch、BenchPriceRange），
+// 会盖过网络前端本身的开销，这里测的是前端。
+// 每个连接保持固定数量的未完成请求：深度 1 即一问一答，深度 N 时一次写出 N 个请求、收到一个响应就补发一个。
+// 给出每秒请求数和单个请求从写出到收到响应的延迟分位数（微秒）。
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "BenchUtil.h"
+#include "TradingServer.h"
+#include "WireClient.h"
+
+namespace {
+
+struct Load {
+    double requestsPerSecond;
+    double p50;
+    double p99;
+    double p999;
+    double max;
+    long errors;
+};
+
+const char* kCategories[] = {"书籍", "电子产品", "自行车", "生活用品", "服饰"};
+
+std::string searchBody(const std::string& category) {
+    std::string body;
+    WireWriter out(body);
+    out.str("");
+    out.str(category);
+    out.f64(0);
+    out.f64(1000000);
+    out.str("price_asc");
+    out.i32(20);
+    out.str("");
+    return body;
+}
+
+std::string browseBody(PageOrder order) {
+    std::string body;
+    WireWriter out(body);
+    out.u8(static_cast<uint8_t>(order));
+    out.i32(20);
+    out.str("");
+    return body;
+}
+
+std::string detailBody(int itemId) {
+    std::string body;
+    WireWriter out(body);
+    out.i32(itemId);
+    return body;
+}
+
+// 一个连接：登录后保持 depth 个未完成的请求，直到 deadline
+void client(bool useUnix, int port, const std::string& path, int index, int items, int depth,
+            bench::Clock::time_point deadline, std::vector<double>& latencies, long& errors) {
+    WireClient conn;
+    bool connected = useUnix ? conn.connectUnix(path) : conn.connectTcp("127.0.0.1", port);
+    if (!connected) {
+        ++errors;
+        return;
+    }
+    std::string login;
+    WireWriter out(login);
+    out.str("buyer" + std::to_string(index) + "@nju.edu.cn");
+    out.str("pwd");
+    WireFrame response;
+    if (!conn.call(WIRE_LOGIN, login, response) || response.code != WIRE_OK) {
+        ++errors;
+        return;
+    }
+
+    std::mt19937 rng(1000 + index);
+    std::vector<bench::Clock::time_point> sentAt(depth);
+    uint32_t nextId = 0;
+    auto sendOne = [&]() {
+        unsigned pick = rng() % 10;
+        if (pick < 5) {
+            conn.send(nextId, WIRE_SEARCH, searchBody(kCategories[rng() % 5]));
+        } else if (pick < 8) {
+            conn.send(nextId, WIRE_BROWSE, browseBody(static_cast<PageOrder>(rng() % 4)));
+        } else {
+            conn.send(nextId, WIRE_ITEM_DETAIL, detailBody(1 + static_cast<int>(rng() % items)));
+        }
+        sentAt[nextId % depth] = bench::Clock::now();
+        ++nextId;
+    };
+    for (int k = 0; k < depth; ++k) sendOne();
+    int outstanding = depth;
+    while (outstanding > 0) {
+        if (!conn.receive(response)) {
+            ++errors;
+            return;
+        }
+        bench::Clock::time_point now = bench::Clock::now();
+        latencies.push_back(std::chrono::duration<double, std::micro>(now - sentAt[response.requestId % depth]).count());
+        if (response.code != WIRE_OK) ++errors;
+        --outstanding;
+        if (now < deadline) {
+            sendOne();
+            ++outstanding;
+        }
+    }
+}
+
+Load drive(bool useUnix, int port, const std::string& path, int items, int connections, int depth, double seconds) {
+    std::vector<std::vector<double>> latencies(connections);
+    std::vector<long> errors(connections, 0);
+    std::vector<std::thread> threads;
+    bench::Clock::time_point start = bench::Clock::now();
+    bench::Clock::time_point deadline =
+        start + std::chrono::duration_cast<bench::Clock::duration>(std::chrono::duration<double>(seconds));
+    for (int c = 0; c < connections; ++c) {
+        threads.emplace_back(client, useUnix, port, std::cref(path), c, items, depth, deadline,
+                             std::ref(latencies[c]), std::ref(errors[c]));
+    }
+    for (std::thread& t : threads) t.join();
+    double elapsed = bench::millis(start, bench::Clock::now()) / 1000;
+
+    std::vector<double> all;
+    Load load = Load();
+    for (int c = 0; c < connections; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        load.errors += errors[c];
+    }
+    if (all.empty()) return load;
+    std::sort(all.begin(), all.end());
+    auto at = [&all](double q) { return all[std::min(all.size() - 1, static_cast<size_t>(q * all.size()))]; };
+    load.requestsPerSecond = all.size() / elapsed;
+    load.p50 = at(0.50);
+    load.p99 = at(0.99);
+    load.p999 = at(0.999);
+    load.max = all.back();
+    return load;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int items = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int connections = argc > 2 ? std::atoi(argv[2]) : 8;
+    int depth = argc > 3 ? std::atoi(argv[3]) : 16;
+    double seconds = argc > 4 ? std::atof(argv[4]) : 2;
+    int workers = argc > 5 ? std::atoi(argv[5]) : 4;
+
+    TradingPlatform platform;
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::vector<ItemDraft> drafts;
+    for (int i = 0; i < items; ++i) {
+        drafts.push_back(ItemDraft{"商品" + std::to_string(i), "九成新，校内自提", kCategories[i % 5], 10.0 + i % 1000, {}});
+    }
+    platform.publishItems(drafts, sellerId);
+    for (int c = 0; c < connections; ++c) {
+        platform.registerUser("buyer", "pwd", "buyer" + std::to_string(c) + "@nju.edu.cn", "2", "2", "B", "CS", REGULAR_USER);
+    }
+
+    std::string path = "/tmp/bench_server_" + std::to_string(getpid()) + ".sock";
+    TradingServer server(platform, workers);
+    if (!server.listenTcp("127.0.0.1", 0) || !server.listenUnix(path)) {
+        std::printf("无法监听回环地址\n");
+        return 1;
+    }
+    std::thread loop([&server]() { server.run(); });
+
+    std::printf("-- %d items, %d connections, %d workers, %u hardware threads, %.1fs per run\n", items, connections,
+                workers, std::thread::hardware_concurrency(), seconds);
+    std::printf("%10s %6s %12s %10s %10s %10s %10s %7s\n", "transport", "depth", "req/s", "p50(us)", "p99(us)",
+                "p999(us)", "max(us)", "errors");
+    for (bool useUnix : {false, true}) {
+        for (int d : {1, depth}) {
+            Load load = drive(useUnix, server.port(), path, items, connections, d, seconds);
+            std::printf("%10s %6d %12.0f %10.1f %10.1f %10.1f %10.1f %7ld\n", useUnix ? "unix" : "tcp", d,
+                        load.requestsPerSecond, load.p50, load.p99, load.p999, load.max, load.errors);
+        }
+    }
+    server.stop();
+    loop.join();
+    ServerStats stats = server.stats();
+    std::printf("server: %llu connections, %llu requests, %llu dropped, %llu throttled\n", stats.accepted, stats.requests,
+                stats.dropped, stats.throttled);
+    return 0;
+}
@@ -0,0 +1,101 @@
+// 会话令牌基准
+// 用法: BenchSessions [会话数，默认 2000000] [最大线程数，默认 8] [每个线程的校验次数，默认 2000000]
+//   create     发放令牌的速率
+//   pick only  基线：随机取出一个令牌字符串本身的耗时（校验的数字里也含这一部分）
+//   validate   在全部会话都有效时，1/2/4/... 个线程同时校验随机令牌（其中 1/10 是伪造的）的总速率
+//   login      对照：每个请求都用邮箱和密码重新登录（查邮箱索引 + 比对密码），10000 个用户
+//   expire     全部会话闲置到期后，时间轮一次回收的耗时
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+#include "SessionStore.h"
+
+namespace {
+
+SessionStore::Seconds fakeNow = 0;
+SessionStore::Seconds fakeClock() { return fakeNow; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : 8;
+    long perThread = argc > 3 ? std::atol(argv[3]) : 2000000;
+
+    SessionStore store(SessionStore::kDefaultTtl, fakeClock);
+    std::vector<std::string> tokens;
+    tokens.reserve(n);
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int i = 0; i < n; ++i) tokens.push_back(store.create(1 + i % 100000));
+    double createMs = bench::millis(start, bench::Clock::now());
+    std::printf("-- %d live sessions, ttl %ds, %u hardware threads\n", n, store.ttl(), std::thread::hardware_concurrency());
+    std::printf("create     %10.0f sessions/s  (%.0f ns each)\n", n / createMs * 1000, createMs * 1e6 / n);
+
+    // 基线：只从令牌表里随机取出令牌字符串，不校验。2M 个令牌散在堆上，取令牌本身就有缓存缺失
+    {
+        std::mt19937 rng(7);
+        unsigned sum = 0;
+        start = bench::Clock::now();
+        for (long k = 0; k < perThread; ++k) {
+            unsigned pick = rng();
+            const std::string& token = tokens[pick % tokens.size()];
+            sum += static_cast<unsigned char>(token[pick % 32]);
+        }
+        double ms = bench::millis(start, bench::Clock::now());
+        std::printf("pick only  %10.1f ns/op (checksum %u)\n", ms * 1e6 / perThread, sum);
+    }
+    std::printf("%8s %14s %12s\n", "threads", "validations/s", "ns/op");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::atomic<long> valid(0);
+        std::vector<std::thread> pool;
+        start = bench::Clock::now();
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t]() {
+                std::mt19937 rng(7 + t);
+                std::string forged(32, 'f');
+                long hits = 0;
+                for (long k = 0; k < perThread; ++k) {
+                    unsigned pick = rng();
+                    hits += store.validate(pick % 10 == 0 ? forged : tokens[pick % tokens.size()]) != 0;
+                }
+                valid += hits;
+            });
+        }
+        for (std::thread& t : pool) t.join();
+        double ms = bench::millis(start, bench::Clock::now());
+        long ops = perThread * threads;
+        std::printf("%8d %14.0f %12.1f\n", threads, ops / ms * 1000, ms * 1e6 / ops);
+        if (valid.load() < ops * 8 / 10) std::printf("  UNEXPECTED: only %ld valid\n", valid.load());
+    }
+
+    // 对照：每个请求都做一次密码校验
+    TradingPlatform platform;
+    const int users = 10000;
+    for (int u = 0; u < users; ++u) {
+        platform.registerUser("u", "password" + std::to_string(u), "user" + std::to_string(u) + "@nju.edu.cn", "1", "1", "U", "CS", REGULAR_USER);
+    }
+    std::vector<std::string> emails;
+    for (int u = 0; u < users; ++u) emails.push_back("user" + std::to_string(u) + "@nju.edu.cn");
+    long logins = std::min<long>(perThread, 1000000);
+    long ok = 0;
+    std::mt19937 rng(3);
+    start = bench::Clock::now();
+    for (long k = 0; k < logins; ++k) {
+        int u = static_cast<int>(rng() % users);
+        ok += platform.login(emails[u], "password" + std::to_string(u)) != 0;
+    }
+    double loginMs = bench::millis(start, bench::Clock::now());
+    std::printf("login      %10.0f checks/s     (%.0f ns each, %ld ok)\n", logins / loginMs * 1000, loginMs * 1e6 / logins, ok);
+
+    fakeNow += store.ttl() + 1;
+    start = bench::Clock::now();
+    size_t removed = store.expire();
+    double expireMs = bench::millis(start, bench::Clock::now());
+    std::printf("expire     %zu sessions in %.1f ms, %zu left\n", removed, expireMs, store.size());
+    return 0;
+}
@@ -0,0 +1,109 @@
+// 发布压力下的读延迟基准
+// 用法: BenchSnapshotReads [商品数，默认 100000] [每个读线程的查询数，默认 5000] [读线程数，默认 2]
+// 读线程循环执行搜索分页（关键词 + 排序）、按价格浏览首页和管理员全部商品首页，记录每次查询的耗时；
+// 同时运行 0 / 1 / 2 / 4 个发布线程不停发布新商品（其中每 4 次购买一件旧商品）。
+// 查询登记在当前有效的商品表副本上执行，不等待写者，p99 应基本不随发布线程数上升；
+// 同时给出发布吞吐量（写者之间串行，每次修改在两份副本上各执行一次）。
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kKeywords[] = {"商品1", "商品2", "商品33", "九成新", "商品5", "商品77"};
+const char* kSorts[] = {"price_asc", "newest", "price_desc"};
+
+double percentile(std::vector<double>& sorted, double p) {
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+void reader(const TradingPlatform& platform, int queries, unsigned seed, std::vector<double>& latencies) {
+    size_t local = 0;
+    for (int i = 0; i < queries; ++i) {
+        unsigned dice = seed + static_cast<unsigned>(i) * 2654435761u;
+        bench::Clock::time_point start = bench::Clock::now();
+        ItemPage page;
+        switch (i % 3) {
+            case 0: {
+                SearchCriteria criteria;
+                criteria.setKeyword(kKeywords[dice % 6]);
+                criteria.setSortBy(kSorts[(dice >> 8) % 3]);
+                criteria.setPage(20);
+                platform.searchItems(criteria, page);
+                break;
+            }
+            case 1:
+                platform.browseItems(PageRequest(20, ORDER_BY_PRICE_ASC), page);
+                break;
+            default:
+                platform.browseAllItems(PageRequest(20, ORDER_BY_ID), page);
+        }
+        latencies.push_back(bench::millis(start, bench::Clock::now()) * 1000.0);
+        local += page.items.size();
+    }
+    sink += local;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int queries = argc > 2 ? std::atoi(argv[2]) : 5000;
+    int readers = argc > 3 ? std::atoi(argv[3]) : 2;
+    std::printf("-- %d items, %d readers x %d queries, hardware threads %u\n", n, readers, queries,
+                std::thread::hardware_concurrency());
+    std::printf("%10s %10s %10s %10s %12s\n", "publishers", "p50 us", "p99 us", "max us", "publishes/s");
+
+    const int publisherCounts[] = {0, 1, 2, 4};
+    for (int publishers : publisherCounts) {
+        TradingPlatform platform;
+        int sellerId = bench::fillCatalog(platform, n);
+        platform.registerUser("buyer", "pwd", "buyer@nju.edu.cn", "2", "2", "B", "CS", REGULAR_USER);
+        int buyerId = platform.login("buyer@nju.edu.cn", "pwd");
+
+        std::atomic<bool> done(false);
+        std::atomic<long> published(0);
+        std::vector<std::thread> writers;
+        for (int w = 0; w < publishers; ++w) {
+            writers.emplace_back([&, w]() {
+                long count = 0;
+                int oldest = 1 + w;
+                while (!done) {
+                    platform.publishItem("新品" + std::to_string(count), "全新", "生活用品", 20 + count % 100, sellerId);
+                    if (++count % 4 == 0) {
+                        platform.purchaseItem(oldest, buyerId);
+                        oldest += publishers;
+                    }
+                }
+                published += count;
+            });
+        }
+
+        std::vector<std::vector<double>> latencies(readers);
+        std::vector<std::thread> pool;
+        bench::Clock::time_point start = bench::Clock::now();
+        for (int r = 0; r < readers; ++r) {
+            latencies[r].reserve(queries);
+            pool.emplace_back(reader, std::cref(platform), queries, 17u * (r + 1), std::ref(latencies[r]));
+        }
+        for (auto& th : pool) th.join();
+        done = true;
+        for (auto& th : writers) th.join();
+        double seconds = bench::millis(start, bench::Clock::now()) / 1000.0;
+
+        std::vector<double> all;
+        for (const auto& l : latencies) all.insert(all.end(), l.begin(), l.end());
+        std::sort(all.begin(), all.end());
+        std::printf("%10d %10.1f %10.1f %10.1f %12.0f\n", publishers, percentile(all, 0.5), percentile(all, 0.99),
+                    all.back(), published / seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+// 输入补全的基准
+// 用法: BenchSuggest [商品数，默认 1000000]
+// 发布 n 件商品后，对不同长度、命中短语数不同的前缀取前 10 条建议，给出单次耗时；
+// 另给出补全索引的短语数、内存占用，以及发布时维护索引的摊还耗时。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kBrands[] = {"Giant", "Logitech", "Xiaomi", "Apple", "Sony", "Yonex", "Dell", "Nike", "Casio", "Kindle"};
+const char* kProducts[] = {"山地自行车", "机械键盘", "台灯", "高等数学教材", "蓝牙耳机",
+                           "羽毛球拍", "电饭煲", "显示器", "运动鞋", "考研资料"};
+const char* kCategories[] = {"书籍", "电子产品", "自行车", "生活用品", "服饰"};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    TradingPlatform platform;
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(7);
+    // 名称的一半是“品牌 商品”（重复多），一半带型号（几乎各不相同）
+    std::vector<std::string> names;
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(kBrands[rng() % 10]) + " " + kProducts[rng() % 10];
+        if (rng() % 2) name += " " + std::to_string(rng() % 100000);
+        names.push_back(name);
+    }
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int i = 0; i < n; ++i) platform.publishItem(names[i], "九成新", kCategories[i % 5], 10.0 + i % 1000, sellerId);
+    bench::Clock::time_point end = bench::Clock::now();
+    const SuggestIndex& index = platform.items.suggestions();
+    std::printf("-- %d items, %zu phrases, index %.1f MB, publish %.0f ns/item (whole publish path)\n", n, index.size(),
+                index.memoryBytes() / 1048576.0, bench::nanosPerOp(start, end, n));
+
+    std::printf("%-16s %10s %10s\n", "prefix", "top", "ns/query");
+    const char* prefixes[] = {"", "s", "Sony", "sony 机", "Logitech 机械键盘 4", "电", "考研", "zzz"};
+    const int rounds = 100000;
+    for (const char* prefix : prefixes) {
+        std::string p = prefix;
+        std::vector<Suggestion> top;
+        start = bench::Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            top = platform.suggest(p, 10);
+            sink += top.size();
+        }
+        end = bench::Clock::now();
+        std::printf("%-16s %10s %10.0f\n", prefix, top.empty() ? "-" : top[0].text.c_str(),
+                    bench::nanosPerOp(start, end, rounds));
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// 关键词搜索的规模基准
+// 用法: BenchTextSearch [最大商品数，默认 1000000]
+// 在 10k / 100k / 1M 商品规模下，对比逐条 find 的扫描（SearchEngine::textSearch(视图)）
+// 与倒排索引（SearchEngine::textSearch(商品表)）的单次查询耗时。
+// 结果数固定的查询，索引的耗时应基本不随商品总数增长。
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile size_t sink = 0;
+
+const char* kBrands[] = {"Giant", "Logitech", "Xiaomi", "Apple", "Sony", "Yonex", "Dell", "Nike", "Casio", "Kindle"};
+const char* kProducts[] = {"山地自行车", "机械键盘", "台灯", "高等数学教材", "蓝牙耳机",
+                           "羽毛球拍", "电饭煲", "显示器", "运动鞋", "考研资料"};
+const char* kConditions[] = {"九成新", "全新未拆", "轻微划痕", "功能完好", "宿舍自提"};
+
+void fill(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    std::mt19937 rng(7);
+    for (int i = 0; i < n; ++i) {
+        std::string name = std::string(kBrands[rng() % 10]) + " " + kProducts[rng() % 10] + " SN" + std::to_string(i);
+        std::string desc = std::string(kConditions[rng() % 5]) + "，校内面交";
+        platform.publishItem(name, desc, "综合", 10.0 + i % 1000, sellerId);
+    }
+}
+
+template <typename Search>
+double timeQuery(Search search, int rounds, size_t& hits) {
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        ItemView view = search();
+        hits = view.size();
+        sink += hits;
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    return bench::millis(start, end) * 1000.0 / rounds;
+}
+
+void runSize(int n) {
+    TradingPlatform platform;
+    fill(platform, n);
+    ItemView all = platform.viewAvailableItems();
+    std::printf("-- %d items, index terms %zu, index %.1f MB\n", n, platform.items.textIndex().termCount(),
+                platform.items.textIndex().memoryBytes() / 1048576.0);
+
+    // SN4321 是编号片段，命中 SN4321、SN43210… 等，命中数随规模按十倍增长；其余查询命中固定比例
+    const char* queries[] = {"SN4321", "Yonex 羽毛球", "考研", "Logitech 机械键盘 SN9", "全新"};
+    for (const char* q : queries) {
+        std::string keyword = q;
+        size_t indexHits = 0, scanHits = 0;
+        double indexed = timeQuery([&] { return SearchEngine::textSearch(platform.items, keyword); }, 20, indexHits);
+        double scanned = timeQuery([&] { return SearchEngine::textSearch(all, keyword); }, 3, scanHits);
+        std::printf("%-28s %10zu %14.1f %14.1f%s\n", q, indexHits, indexed, scanned,
+                    indexHits == scanHits ? "" : "  MISMATCH");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxItems = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    std::printf("%-28s %10s %14s %14s\n", "query", "hits", "index us/q", "scan us/q");
+    for (int n = 10000; n <= maxItems; n *= 10) {
+        runSize(n);
+    }
+    return 0;
+}
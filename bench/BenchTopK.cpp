@@ -0,0 +1,61 @@
+// 有序查询取前 K 件的基准
+// 用法: BenchTopK [商品数，默认 1000000]
+// 全部商品都满足条件（1M 件匹配），对比全量排序后取前 20 件与有界堆只选前 20 件的耗时，
+// 另外给出组合排序键和带 offset 的情形。价格只有 1000 种取值，同价商品很多。
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "BenchUtil.h"
+
+namespace {
+
+volatile long long sink = 0;
+const int kRounds = 5;
+
+void run(const char* name, TradingPlatform& platform, const std::string& sortBy, size_t offset, size_t limit) {
+    SearchCriteria criteria;
+    criteria.setSortBy(sortBy);
+    criteria.setLimit(limit, offset);
+    ItemView result;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        result = criteria.select(platform.items);
+        sink += result.refs.empty() ? 0 : result[0].getItemId();
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    std::printf("%-34s %10zu %12.2f   first id %d\n", name, result.size(), bench::millis(start, end) / kRounds,
+                result.empty() ? 0 : result[0].getItemId());
+}
+
+template <typename Order>
+void runView(const char* name, Order order) {
+    ItemView result;
+    bench::Clock::time_point start = bench::Clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        result = order();
+        sink += result.size();
+    }
+    bench::Clock::time_point end = bench::Clock::now();
+    std::printf("%-34s %10zu %12.2f\n", name, result.size(), bench::millis(start, end) / kRounds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    TradingPlatform platform;
+    bench::fillCatalog(platform, n);
+
+    std::printf("%-34s %10s %12s\n", "query", "returned", "ms/query");
+    run("price_asc, full sort", platform, "price_asc", 0, 0);
+    run("price_asc, K=20", platform, "price_asc", 0, 20);
+    run("price_desc, K=20", platform, "price_desc", 0, 20);
+    run("price_asc,newest, K=20", platform, "price_asc,newest", 0, 20);
+    run("newest, K=20", platform, "newest", 0, 20);
+    run("price_asc, offset 1000, K=20", platform, "price_asc", 1000, 20);
+
+    ItemView all = platform.viewAvailableItems();
+    runView("view sortByPrice (full)", [&] { return SearchEngine::sortByPrice(all, true); });
+    runView("view orderBy price_asc K=20", [&] { return SearchEngine::orderBy(all, "price_asc", 0, 20); });
+    return 0;
+}
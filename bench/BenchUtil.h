@@ -0,0 +1,34 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+// 基准程序共用的计时与造数工具
+#include <chrono>
+#include <string>
+#include "Platform.h"
+
+namespace bench {
+
+typedef std::chrono::steady_clock Clock;
+
+inline double nanosPerOp(Clock::time_point start, Clock::time_point end, long ops) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+inline double millis(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 注册一个卖家并发布 n 件商品，返回卖家ID
+inline int fillCatalog(TradingPlatform& platform, int n) {
+    platform.registerUser("seller", "pwd", "seller@nju.edu.cn", "1", "1", "S", "CS", REGULAR_USER);
+    int sellerId = platform.login("seller@nju.edu.cn", "pwd");
+    static const char* categories[] = {"书籍", "电子产品", "自行车", "生活用品", "服饰"};
+    for (int i = 0; i < n; ++i) {
+        platform.publishItem("商品" + std::to_string(i), "九成新，校内自提",
+                             categories[i % 5], 10.0 + i % 1000, sellerId);
+    }
+    return sellerId;
+}
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef BITUTIL_H
+#define BITUTIL_H
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// 位运算小工具，word 不能为0
+inline int lowestSetBit(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+inline int highestSetBit(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+inline int popcount64(uint64_t word) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return static_cast<int>(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+#endif
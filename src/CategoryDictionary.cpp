@@ -0,0 +1,25 @@
+#include "CategoryDictionary.h"
+
+int CategoryDictionary::intern(const std::string& category) {
+    auto it = ids.find(category);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(names.size());
+    names.push_back(category);
+    ids.emplace(category, id);
+    return id;
+}
+
+int CategoryDictionary::lookup(const std::string& category) const {
+    auto it = ids.find(category);
+    return it == ids.end() ? -1 : it->second;
+}
+
+const std::string& CategoryDictionary::name(int id) const {
+    return names[id];
+}
+
+int CategoryDictionary::size() const {
+    return static_cast<int>(names.size());
+}
@@ -0,0 +1,19 @@
+#ifndef CATEGORYDICTIONARY_H
+#define CATEGORYDICTIONARY_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// 商品分类字典：把分类字符串映射为从0开始的小整数，供列存和索引使用
+struct CategoryDictionary {
+    std::vector<std::string> names;               // id -> 分类名
+    std::unordered_map<std::string, int> ids;     // 分类名 -> id
+
+    // 查找分类，不存在时分配新的 id
+    int intern(const std::string& category);
+    // 只查找，不存在时返回 -1
+    int lookup(const std::string& category) const;
+    const std::string& name(int id) const;
+    int size() const;
+};
+#endif
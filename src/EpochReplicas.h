@@ -0,0 +1,96 @@
+#ifndef EPOCHREPLICAS_H
+#define EPOCHREPLICAS_H
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <cstddef>
+
+// 两份副本轮换的快照读（left-right）：
+// 读者登记到当前有效的副本上，在回调返回前这一份不会被修改，读到的始终是同一时刻的完整版本；
+// 登记只是对所在分片的计数器加一，读者之间、读者与写者之间都不互相等待。
+// 写者先修改另一份副本，再把有效副本切换过去（发布新版本），等还登记在旧副本上的读者全部离开
+// （宽限期，相当于旧版本的读者纪元结束）后，把同样的修改在旧副本上重放一次，旧副本随即成为下一次写入的目标。
+// 写者之间须由调用方串行；修改会在两份副本上各执行一次，必须是确定性的。
+// 读回调中不能再写，否则写者会一直等待自己离开。
+template <typename T>
+struct EpochReplicas {
+    static const size_t kReaderSlots = 64;
+
+    EpochReplicas() : active(0) {
+        for (Slot& slot : slots) {
+            slot.readers[0] = 0;
+            slot.readers[1] = 0;
+        }
+    }
+    EpochReplicas(const EpochReplicas&) = delete;
+    EpochReplicas& operator=(const EpochReplicas&) = delete;
+
+    // 在当前有效的副本上调用 read(const T&)，返回它的结果
+    template <typename Read>
+    auto read(Read read) const -> decltype(read(std::declval<const T&>())) {
+        Pin pin(*this);
+        return read(static_cast<const T&>(replicas[pin.side]));
+    }
+
+    // 登记到当前有效的副本上并返回它，返回值（及其副本）全部释放前这一份不会被修改，可以在别的线程释放。
+    // 持有期间写者要等它释放才能完成，本线程在释放之前不能写
+    std::shared_ptr<const T> pin() const {
+        std::shared_ptr<Pin> registration = std::make_shared<Pin>(*this);
+        return std::shared_ptr<const T>(registration, &replicas[registration->side]);
+    }
+
+    // 依次在两份副本上调用 write(T&)
+    template <typename Write>
+    void write(Write write) {
+        int side = active.load(std::memory_order_relaxed);
+        write(replicas[1 - side]);
+        active.store(1 - side, std::memory_order_seq_cst);
+        for (const Slot& slot : slots) {
+            while (slot.readers[side].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        }
+        write(replicas[side]);
+    }
+
+    // 直接访问某一份副本，只能在没有其他线程读写时使用
+    T& replica(int side) { return replicas[side]; }
+    const T& replica(int side) const { return replicas[side]; }
+
+private:
+    // 每个分片独占一条缓存行，不同线程登记时互不干扰
+    struct alignas(64) Slot {
+        std::atomic<long> readers[2];
+    };
+
+    // 读者登记：加一后再确认有效副本没有切换，切换了就撤销重来，保证写者等待的计数里一定包含自己
+    struct Pin {
+        std::atomic<long>* counter;
+        int side;
+
+        explicit Pin(const EpochReplicas& owner) {
+            Slot& slot = owner.slots[slotIndex()];
+            for (;;) {
+                side = owner.active.load(std::memory_order_seq_cst);
+                counter = &slot.readers[side];
+                counter->fetch_add(1, std::memory_order_seq_cst);
+                if (owner.active.load(std::memory_order_seq_cst) == side) return;
+                counter->fetch_sub(1, std::memory_order_release);
+            }
+        }
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+        ~Pin() { counter->fetch_sub(1, std::memory_order_release); }
+    };
+
+    // 每个线程固定使用一个分片
+    static size_t slotIndex() {
+        static std::atomic<size_t> next(0);
+        thread_local size_t mine = next++ % kReaderSlots;
+        return mine;
+    }
+
+    T replicas[2];
+    std::atomic<int> active;
+    mutable Slot slots[kReaderSlots];
+};
+#endif
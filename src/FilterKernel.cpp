@@ -0,0 +1,165 @@
+#include "FilterKernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRADING_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// 每个位图字覆盖 64 行；SIMD 实现只处理完整的 64 行，不足 64 行的部分走标量实现
+static const int kWordRows = 64;
+
+static uint64_t scalarWord(const ItemColumns& columns, const ColumnFilter& filter, int first, int last) {
+    uint64_t word = 0;
+    for (int row = first; row < last; ++row) {
+        double p = columns.price[row];
+        bool hit = columns.status[row] == filter.status &&
+                   p >= filter.minPrice && p <= filter.maxPrice &&
+                   (filter.categoryId < 0 || columns.categoryId[row] == filter.categoryId);
+        word |= static_cast<uint64_t>(hit) << (row - first);
+    }
+    return word;
+}
+
+#ifdef TRADING_X86_SIMD
+
+__attribute__((target("sse2")))
+static uint64_t sse2Word(const double* price, const uint8_t* status, const int32_t* category,
+                         const ColumnFilter& filter) {
+    const __m128d lo = _mm_set1_pd(filter.minPrice);
+    const __m128d hi = _mm_set1_pd(filter.maxPrice);
+    const __m128i wantStatus = _mm_set1_epi8(static_cast<char>(filter.status));
+    const __m128i wantCategory = _mm_set1_epi32(filter.categoryId);
+    const bool anyCategory = filter.categoryId < 0;
+
+    uint64_t word = 0;
+    for (int i = 0; i < kWordRows; i += 16) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(status + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(s, wantStatus)));
+
+        uint32_t priceMask = 0;
+        for (int j = 0; j < 16; j += 2) {
+            __m128d p = _mm_loadu_pd(price + i + j);
+            __m128d inRange = _mm_and_pd(_mm_cmpge_pd(p, lo), _mm_cmple_pd(p, hi));
+            priceMask |= static_cast<uint32_t>(_mm_movemask_pd(inRange)) << j;
+        }
+        mask &= priceMask;
+
+        if (!anyCategory) {
+            uint32_t categoryMask = 0;
+            for (int j = 0; j < 16; j += 4) {
+                __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(category + i + j));
+                __m128 eq = _mm_castsi128_ps(_mm_cmpeq_epi32(c, wantCategory));
+                categoryMask |= static_cast<uint32_t>(_mm_movemask_ps(eq)) << j;
+            }
+            mask &= categoryMask;
+        }
+        word |= static_cast<uint64_t>(mask) << i;
+    }
+    return word;
+}
+
+__attribute__((target("avx2")))
+static uint64_t avx2Word(const double* price, const uint8_t* status, const int32_t* category,
+                         const ColumnFilter& filter) {
+    const __m256d lo = _mm256_set1_pd(filter.minPrice);
+    const __m256d hi = _mm256_set1_pd(filter.maxPrice);
+    const __m256i wantStatus = _mm256_set1_epi8(static_cast<char>(filter.status));
+    const __m256i wantCategory = _mm256_set1_epi32(filter.categoryId);
+    const bool anyCategory = filter.categoryId < 0;
+
+    uint64_t word = 0;
+    for (int i = 0; i < kWordRows; i += 32) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(status + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, wantStatus)));
+
+        uint32_t priceMask = 0;
+        for (int j = 0; j < 32; j += 4) {
+            __m256d p = _mm256_loadu_pd(price + i + j);
+            __m256d inRange = _mm256_and_pd(_mm256_cmp_pd(p, lo, _CMP_GE_OQ), _mm256_cmp_pd(p, hi, _CMP_LE_OQ));
+            priceMask |= static_cast<uint32_t>(_mm256_movemask_pd(inRange)) << j;
+        }
+        mask &= priceMask;
+
+        if (!anyCategory) {
+            uint32_t categoryMask = 0;
+            for (int j = 0; j < 32; j += 8) {
+                __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(category + i + j));
+                __m256 eq = _mm256_castsi256_ps(_mm256_cmpeq_epi32(c, wantCategory));
+                categoryMask |= static_cast<uint32_t>(_mm256_movemask_ps(eq)) << j;
+            }
+            mask &= categoryMask;
+        }
+        word |= static_cast<uint64_t>(mask) << i;
+    }
+    return word;
+}
+
+static bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+static bool cpuHasSse2() {
+#if defined(__x86_64__)
+    return true;
+#else
+    static const bool has = __builtin_cpu_supports("sse2");
+    return has;
+#endif
+}
+
+#endif // TRADING_X86_SIMD
+
+FilterImpl resolveFilterImpl(FilterImpl requested) {
+#ifdef TRADING_X86_SIMD
+    if ((requested == FILTER_AUTO || requested == FILTER_AVX2) && cpuHasAvx2()) return FILTER_AVX2;
+    if (requested != FILTER_SCALAR && cpuHasSse2()) return FILTER_SSE2;
+#else
+    (void)requested;
+#endif
+    return FILTER_SCALAR;
+}
+
+const char* filterImplName(FilterImpl impl) {
+    switch (impl) {
+        case FILTER_AVX2: return "avx2";
+        case FILTER_SSE2: return "sse2";
+        case FILTER_SCALAR: return "scalar";
+        default: return "auto";
+    }
+}
+
+void filterColumns(const ItemColumns& columns, const ColumnFilter& filter,
+                   int beginRow, int endRow, std::vector<uint64_t>& bitmap, FilterImpl impl) {
+    if (endRow > columns.rows()) endRow = columns.rows();
+    if (beginRow >= endRow) return;
+    size_t words = static_cast<size_t>(endRow + kWordRows - 1) / kWordRows;
+    if (bitmap.size() < words) bitmap.resize(words, 0);
+
+    FilterImpl actual = resolveFilterImpl(impl);
+    for (int first = beginRow; first < endRow; first += kWordRows) {
+        int last = first + kWordRows;
+        uint64_t word;
+#ifdef TRADING_X86_SIMD
+        if (last <= endRow && actual == FILTER_AVX2) {
+            word = avx2Word(&columns.price[first], &columns.status[first], &columns.categoryId[first], filter);
+        } else if (last <= endRow && actual == FILTER_SSE2) {
+            word = sse2Word(&columns.price[first], &columns.status[first], &columns.categoryId[first], filter);
+        } else
+#endif
+        {
+            (void)actual;
+            word = scalarWord(columns, filter, first, last < endRow ? last : endRow);
+        }
+        bitmap[first / kWordRows] = word;
+    }
+}
+
+void filterColumns(const ItemColumns& columns, const ColumnFilter& filter,
+                   std::vector<uint64_t>& bitmap, FilterImpl impl) {
+    filterColumns(columns, filter, 0, columns.rows(), bitmap, impl);
+}
+
+void bitmapToRows(const std::vector<uint64_t>& bitmap, std::vector<int>& rows) {
+    forEachSelectedRow(bitmap, [&rows](int row) { rows.push_back(row); });
+}
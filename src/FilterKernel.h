@@ -0,0 +1,56 @@
+#ifndef FILTERKERNEL_H
+#define FILTERKERNEL_H
+#include <vector>
+#include <cstdint>
+#include "ItemColumns.h"
+#include "BitUtil.h"
+
+// 列存过滤条件：状态、价格区间 [minPrice, maxPrice]、分类（-1 表示不限）
+struct ColumnFilter {
+    int status;
+    double minPrice;
+    double maxPrice;
+    int categoryId;
+
+    ColumnFilter() : status(AVAILABLE), minPrice(0), maxPrice(1e300), categoryId(-1) {}
+};
+
+enum FilterImpl {
+    FILTER_AUTO,     // 按CPU能力自动选择
+    FILTER_SCALAR,
+    FILTER_SSE2,
+    FILTER_AVX2
+};
+
+// 对 [beginRow, endRow) 行求值，结果写入选择位图：第 row 行满足条件时
+// bitmap[row / 64] 的第 row % 64 位为1。bitmap 会被扩展到至少覆盖 endRow 行，
+// 该区间内原有的位会被覆盖。beginRow 必须是 64 的倍数。
+// 请求的实现在当前CPU上不可用时退回到可用的最快实现。
+void filterColumns(const ItemColumns& columns, const ColumnFilter& filter,
+                   int beginRow, int endRow, std::vector<uint64_t>& bitmap,
+                   FilterImpl impl = FILTER_AUTO);
+
+// 对全部行求值
+void filterColumns(const ItemColumns& columns, const ColumnFilter& filter,
+                   std::vector<uint64_t>& bitmap, FilterImpl impl = FILTER_AUTO);
+
+// 实际会使用的实现
+FilterImpl resolveFilterImpl(FilterImpl requested);
+const char* filterImplName(FilterImpl impl);
+
+// 按行号升序访问选择位图中的每一行
+template <typename Visit>
+void forEachSelectedRow(const std::vector<uint64_t>& bitmap, Visit visit) {
+    for (size_t w = 0; w < bitmap.size(); ++w) {
+        uint64_t word = bitmap[w];
+        while (word) {
+            visit(static_cast<int>(w * 64 + lowestSetBit(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+// 把选择位图展开成行号（升序）
+void bitmapToRows(const std::vector<uint64_t>& bitmap, std::vector<int>& rows);
+
+#endif
@@ -0,0 +1,114 @@
+#include "FuzzyMatch.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <cstring>
+
+static int32_t foldAscii(int32_t c) {
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+FuzzyPattern::FuzzyPattern(const std::string& pattern, int maxDistance)
+    : source(pattern), limit(maxDistance > 0 ? maxDistance : 0), validPattern(true) {
+    std::memset(asciiMask, 0, sizeof(asciiMask));
+    size_t pos = 0;
+    while (pos < pattern.size()) {
+        offsets.push_back(pos);
+        int32_t c = decodeUtf8(pattern, pos);
+        if (c < 0) validPattern = false;
+        chars.push_back(foldAscii(c));
+    }
+    if (!validPattern || chars.size() > static_cast<size_t>(kWordBits)) return;
+    for (size_t i = 0; i < chars.size(); ++i) {
+        uint64_t bit = uint64_t(1) << i;
+        if (chars[i] < 0x80) {
+            asciiMask[chars[i]] |= bit;
+            continue;
+        }
+        auto it = std::lower_bound(wideMask.begin(), wideMask.end(), std::make_pair(chars[i], uint64_t(0)));
+        if (it != wideMask.end() && it->first == chars[i]) {
+            it->second |= bit;
+        } else {
+            wideMask.insert(it, std::make_pair(chars[i], bit));
+        }
+    }
+}
+
+// 非法字节（-1）不与任何模式字符相等
+uint64_t FuzzyPattern::peq(int32_t c) const {
+    if (c < 0) return 0;
+    if (c < 0x80) return asciiMask[foldAscii(c)];
+    auto it = std::lower_bound(wideMask.begin(), wideMask.end(), std::make_pair(c, uint64_t(0)));
+    return it != wideMask.end() && it->first == c ? it->second : 0;
+}
+
+bool FuzzyPattern::matches(TextRef text) const {
+    if (!validPattern) return false;
+    // 删去整个模式即可匹配空串
+    if (length() <= limit) return true;
+    return length() <= kWordBits ? matchesBitParallel(text) : matchesDynamic(text);
+}
+
+// 动态规划表的一列（第 j 个文本字符处，模式前 i 个字符与以它结尾的最佳子串的距离）压成两个位向量：
+// Pv / Mv 的第 i 位表示相邻两行的差为 +1 / -1。子串可以从任意位置开始，所以第 0 行恒为 0，
+// 水平差向量左移时低位补 0。score 跟踪最后一行的值。
+bool FuzzyPattern::matchesBitParallel(TextRef text) const {
+    const int m = length();
+    const uint64_t last = uint64_t(1) << (m - 1);
+    uint64_t pv = ~uint64_t(0);
+    uint64_t mv = 0;
+    int score = m;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        uint64_t eq = peq(decodeUtf8(text, pos));
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score <= limit) return true;
+    }
+    return false;
+}
+
+bool FuzzyPattern::matchesDynamic(TextRef text) const {
+    const int m = length();
+    std::vector<int> column(m + 1);
+    for (int i = 0; i <= m; ++i) column[i] = i;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        int32_t c = decodeUtf8(text, pos);
+        c = c < 0 ? -1 : foldAscii(c);
+        int diagonal = 0;   // 上一列第 i - 1 行，第 0 行恒为 0
+        for (int i = 1; i <= m; ++i) {
+            int substitute = diagonal + (chars[i - 1] == c && c >= 0 ? 0 : 1);
+            diagonal = column[i];
+            column[i] = std::min(std::min(column[i] + 1, column[i - 1] + 1), substitute);
+        }
+        if (column[m] <= limit) return true;
+    }
+    return false;
+}
+
+std::vector<std::string> FuzzyPattern::pieces() const {
+    std::vector<std::string> out;
+    const int count = limit + 1;
+    if (!validPattern || length() < count) return out;
+    // 前 length % count 段各多一个码点
+    int begin = 0;
+    for (int p = 0; p < count; ++p) {
+        int size = length() / count + (p < length() % count ? 1 : 0);
+        size_t from = offsets[begin];
+        size_t to = begin + size < length() ? offsets[begin + size] : source.size();
+        out.push_back(source.substr(from, to - from));
+        begin += size;
+    }
+    return out;
+}
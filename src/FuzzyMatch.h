@@ -0,0 +1,41 @@
+#ifndef FUZZYMATCH_H
+#define FUZZYMATCH_H
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "TextArena.h"
+
+// 近似匹配：文本中存在一段子串，与模式的编辑距离（按码点计的插入、删除、替换次数）不超过 maxDistance。
+// ASCII 字母不区分大小写，非法字节按一个不与任何字符相等的字符计。
+// 模式不超过 64 个码点时用 Myers 的位并行算法，每个文本字符只需十来次字运算；更长的模式逐列动态规划。
+struct FuzzyPattern {
+    static const int kWordBits = 64;
+
+    FuzzyPattern(const std::string& pattern, int maxDistance);
+
+    // 模式是合法 UTF-8；不合法时不匹配任何文本
+    bool valid() const { return validPattern; }
+    int length() const { return static_cast<int>(chars.size()); }
+    int maxDistance() const { return limit; }
+    bool matches(TextRef text) const;
+
+    // 把模式按码点切成 maxDistance + 1 段（UTF-8）。编辑至多改动其中 maxDistance 段，
+    // 匹配的子串一定原样含有某一段（ASCII 不分大小写），各段的候选集之并就是候选集的超集。
+    // 模式短于 maxDistance + 1 个码点时空串也能匹配，返回空表
+    std::vector<std::string> pieces() const;
+
+private:
+    uint64_t peq(int32_t c) const;
+    bool matchesBitParallel(TextRef text) const;
+    bool matchesDynamic(TextRef text) const;
+
+    std::string source;
+    std::vector<int32_t> chars;                          // ASCII 已转小写
+    std::vector<size_t> offsets;                         // 每个码点在 source 中的起始字节
+    int limit;
+    bool validPattern;
+    uint64_t asciiMask[128];                             // 字符在模式中出现的位置
+    std::vector<std::pair<int32_t, uint64_t>> wideMask;  // 非 ASCII 字符，按码点排序
+};
+#endif
@@ -0,0 +1,112 @@
+#include "ImageHash.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <cctype>
+
+namespace {
+
+// 差异哈希的缩略图尺寸：每行 9 个像素比较出 8 位
+const int kThumbWidth = 9;
+const int kThumbHeight = 8;
+
+// PNM 头部的下一个十进制数，跳过空白和 # 开头的注释
+bool readHeaderNumber(const std::string& data, size_t& pos, int& value) {
+    while (pos < data.size()) {
+        unsigned char c = static_cast<unsigned char>(data[pos]);
+        if (c == '#') {
+            while (pos < data.size() && data[pos] != '\n') ++pos;
+        } else if (std::isspace(c)) {
+            ++pos;
+        } else {
+            break;
+        }
+    }
+    if (pos >= data.size() || !std::isdigit(static_cast<unsigned char>(data[pos]))) return false;
+    long long v = 0;
+    while (pos < data.size() && std::isdigit(static_cast<unsigned char>(data[pos]))) {
+        v = v * 10 + (data[pos] - '0');
+        if (v > (1 << 16)) return false;
+        ++pos;
+    }
+    value = static_cast<int>(v);
+    return true;
+}
+
+} // namespace
+
+bool loadImage(const std::string& path, GrayImage& image) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6')) return false;
+    int channels = data[1] == '5' ? 1 : 3;
+
+    size_t pos = 2;
+    int width, height, maxValue;
+    if (!readHeaderNumber(data, pos, width) || !readHeaderNumber(data, pos, height) ||
+        !readHeaderNumber(data, pos, maxValue)) {
+        return false;
+    }
+    if (width <= 0 || height <= 0 || maxValue <= 0 || maxValue > 255) return false;
+    // 最大值后面恰好一个空白字符，之后是像素数据
+    if (pos >= data.size() || !std::isspace(static_cast<unsigned char>(data[pos]))) return false;
+    ++pos;
+    size_t pixels = static_cast<size_t>(width) * height;
+    if (data.size() - pos < pixels * channels) return false;
+
+    image = GrayImage(width, height);
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(data.data()) + pos;
+    for (size_t i = 0; i < pixels; ++i) {
+        int v;
+        if (channels == 1) {
+            v = src[i];
+        } else {
+            const unsigned char* rgb = src + 3 * i;
+            v = (299 * rgb[0] + 587 * rgb[1] + 114 * rgb[2]) / 1000;
+        }
+        image.pixels[i] = static_cast<uint8_t>(maxValue == 255 ? v : v * 255 / maxValue);
+    }
+    return true;
+}
+
+bool saveImage(const std::string& path, const GrayImage& image) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out << "P5\n" << image.width << " " << image.height << "\n255\n";
+    out.write(reinterpret_cast<const char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+    return static_cast<bool>(out);
+}
+
+uint64_t differenceHash(const GrayImage& image) {
+    if (image.width <= 0 || image.height <= 0) return 0;
+    // 每个缩略图像素取原图对应矩形的平均值，原图比缩略图小时矩形至少含一个像素
+    double thumb[kThumbHeight][kThumbWidth];
+    for (int ty = 0; ty < kThumbHeight; ++ty) {
+        int y0 = ty * image.height / kThumbHeight;
+        int y1 = std::max(y0 + 1, (ty + 1) * image.height / kThumbHeight);
+        for (int tx = 0; tx < kThumbWidth; ++tx) {
+            int x0 = tx * image.width / kThumbWidth;
+            int x1 = std::max(x0 + 1, (tx + 1) * image.width / kThumbWidth);
+            uint64_t sum = 0;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) sum += image.at(x, y);
+            }
+            thumb[ty][tx] = static_cast<double>(sum) / ((y1 - y0) * (x1 - x0));
+        }
+    }
+    uint64_t hash = 0;
+    for (int ty = 0; ty < kThumbHeight; ++ty) {
+        for (int tx = 0; tx + 1 < kThumbWidth; ++tx) {
+            if (thumb[ty][tx] > thumb[ty][tx + 1]) hash |= uint64_t(1) << (ty * 8 + tx);
+        }
+    }
+    return hash;
+}
+
+bool hashImageFile(const std::string& path, uint64_t& hash) {
+    GrayImage image;
+    if (!loadImage(path, image)) return false;
+    hash = differenceHash(image);
+    return true;
+}
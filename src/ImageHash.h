@@ -0,0 +1,39 @@
+#ifndef IMAGEHASH_H
+#define IMAGEHASH_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "BitUtil.h"
+
+// 按图搜索默认接受的最大汉明距离：同一张照片经过缩放、压缩、调亮度后的差异哈希一般在这个范围内
+const int kSimilarImageDistance = 10;
+
+// 8 位灰度图像，pixels 按行存放，共 width * height 个像素
+struct GrayImage {
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;
+
+    GrayImage() : width(0), height(0) {}
+    GrayImage(int w, int h) : width(w), height(h), pixels(static_cast<size_t>(w) * h, 0) {}
+    uint8_t& at(int x, int y) { return pixels[static_cast<size_t>(y) * width + x]; }
+    uint8_t at(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+};
+
+// 读取二进制 PNM 图像：P5 灰度或 P6 彩色，最大值不超过 255，彩色按亮度转为灰度。
+// 文件不存在、格式不支持或数据不完整时返回 false
+bool loadImage(const std::string& path, GrayImage& image);
+// 保存为 P5 灰度图，写入失败时返回 false
+bool saveImage(const std::string& path, const GrayImage& image);
+
+// 差异哈希 dHash：按面积平均缩放到 9x8，每行相邻两个像素左边比右边亮记 1，按行排成 64 位。
+// 只看亮度的相对变化，对缩放、整体调亮调暗和轻微噪声不敏感；空图像返回 0
+uint64_t differenceHash(const GrayImage& image);
+// 读取图片并计算差异哈希，读取失败时返回 false
+bool hashImageFile(const std::string& path, uint64_t& hash);
+
+inline int hammingDistance(uint64_t a, uint64_t b) {
+    return popcount64(a ^ b);
+}
+
+#endif
@@ -0,0 +1,219 @@
+#include "ImageIndex.h"
+#include "BitUtil.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRADING_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// 条目少于该数量时直接扫描，分段表的探查反而更慢
+const size_t kMinEntriesForTables = 4096;
+// 顺序扫描每次计算的距离个数
+const size_t kScanBlock = 1024;
+
+// 把 [0, n) 条哈希与 query 的汉明距离写入 out
+void scalarDistances(const uint64_t* hashes, size_t n, uint64_t query, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<uint8_t>(popcount64(hashes[i] ^ query));
+}
+
+#ifdef TRADING_X86_SIMD
+
+__attribute__((target("popcnt")))
+void popcntDistances(const uint64_t* hashes, size_t n, uint64_t query, uint8_t* out) {
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<uint8_t>(__builtin_popcountll(hashes[i] ^ query));
+}
+
+// 每次 4 个哈希：按半字节查表求每个字节的位数，再用 SAD 把 8 个字节加到 64 位通道里
+__attribute__((target("avx2")))
+void avx2Distances(const uint64_t* hashes, size_t n, uint64_t query, uint8_t* out) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+    const __m256i q = _mm256_set1_epi64x(static_cast<long long>(query));
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes + i)), q);
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, lowNibble));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble));
+        __m256i sums = _mm256_sad_epu8(_mm256_add_epi8(lo, hi), zero);
+        out[i] = static_cast<uint8_t>(_mm256_extract_epi8(sums, 0));
+        out[i + 1] = static_cast<uint8_t>(_mm256_extract_epi8(sums, 8));
+        out[i + 2] = static_cast<uint8_t>(_mm256_extract_epi8(sums, 16));
+        out[i + 3] = static_cast<uint8_t>(_mm256_extract_epi8(sums, 24));
+    }
+    scalarDistances(hashes + i, n - i, query, out + i);
+}
+
+#endif // TRADING_X86_SIMD
+
+void distances(const uint64_t* hashes, size_t n, uint64_t query, uint8_t* out) {
+#ifdef TRADING_X86_SIMD
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    static const bool hasPopcnt = __builtin_cpu_supports("popcnt");
+    if (hasAvx2) return avx2Distances(hashes, n, query, out);
+    if (hasPopcnt) return popcntDistances(hashes, n, query, out);
+#endif
+    scalarDistances(hashes, n, query, out);
+}
+
+bool byItem(const ImageMatch& a, const ImageMatch& b) {
+    return a.itemId != b.itemId ? a.itemId < b.itemId : a.distance < b.distance;
+}
+
+bool byDistance(const ImageMatch& a, const ImageMatch& b) {
+    return a.distance != b.distance ? a.distance < b.distance : a.itemId < b.itemId;
+}
+
+// 同一商品只留最近的一条，再按 (距离, 商品ID) 取前 limit 条
+void keepBest(std::vector<ImageMatch>& found, size_t limit) {
+    std::sort(found.begin(), found.end(), byItem);
+    found.erase(std::unique(found.begin(), found.end(),
+                            [](const ImageMatch& a, const ImageMatch& b) { return a.itemId == b.itemId; }),
+                found.end());
+    if (found.size() > limit) {
+        std::partial_sort(found.begin(), found.begin() + limit, found.end(), byDistance);
+        found.resize(limit);
+    } else {
+        std::sort(found.begin(), found.end(), byDistance);
+    }
+}
+
+} // namespace
+
+ImageIndex::ImageIndex() {}
+
+void ImageIndex::add(int itemId, uint64_t hash) {
+    if (tables[0].empty()) {
+        for (auto& table : tables) table.resize(size_t(1) << kPieceBits);
+    }
+    uint32_t entry = static_cast<uint32_t>(hashes.size());
+    hashes.push_back(hash);
+    owners.push_back(itemId);
+    Slot slot = {static_cast<uint32_t>(hash), static_cast<uint32_t>(hash >> 32), entry};
+    for (int t = 0; t < kPieces; ++t) bucket(t, hash).push_back(slot);
+}
+
+bool ImageIndex::remove(int itemId, uint64_t hash) {
+    if (tables[0].empty()) return false;
+    std::vector<Slot>& first = bucket(0, hash);
+    auto pos = std::find_if(first.begin(), first.end(),
+                            [&](const Slot& s) { return s.hash() == hash && owners[s.entry] == itemId; });
+    if (pos == first.end()) return false;
+    uint32_t entry = pos->entry;
+    auto slotOf = [](std::vector<Slot>& b, uint32_t e) {
+        return std::find_if(b.begin(), b.end(), [e](const Slot& s) { return s.entry == e; });
+    };
+    for (int t = 0; t < kPieces; ++t) {
+        std::vector<Slot>& b = bucket(t, hash);
+        *slotOf(b, entry) = b.back();
+        b.pop_back();
+    }
+    // 最后一个条目搬到空位，分段表里的下标跟着改
+    uint32_t last = static_cast<uint32_t>(hashes.size() - 1);
+    if (entry != last) {
+        for (int t = 0; t < kPieces; ++t) slotOf(bucket(t, hashes[last]), last)->entry = entry;
+        hashes[entry] = hashes[last];
+        owners[entry] = owners[last];
+    }
+    hashes.pop_back();
+    owners.pop_back();
+    return true;
+}
+
+void ImageIndex::clear() {
+    hashes.clear();
+    owners.clear();
+    for (auto& table : tables) std::vector<std::vector<Slot>>().swap(table);
+}
+
+std::vector<ImageMatch> ImageIndex::nearest(uint64_t hash, size_t limit, int maxDistance) const {
+    if (maxDistance < 0) return std::vector<ImageMatch>();
+    if (limit == 0) limit = std::numeric_limits<size_t>::max();
+    maxDistance = std::min(maxDistance, 64);
+    if (hashes.size() < kMinEntriesForTables) return scan(hash, limit, maxDistance);
+
+    std::vector<ImageMatch> found;
+    // 探查一个桶和核对一个候选都按一次计，各自要随机访问内存，比顺序扫描一个哈希贵一个数量级
+    size_t budget = hashes.size() / 32;
+    size_t examined = 0;
+    size_t perBucket = 1 + (hashes.size() >> kPieceBits);
+    int query[kPieces];
+    for (int t = 0; t < kPieces; ++t) query[t] = piece(hash, t);
+
+    for (int s = 0; s * kPieces <= maxDistance; ++s) {
+        // 按哈希均匀分布估计这一级的代价，预计超出预算就不必开始
+        size_t buckets = 1;
+        for (int k = 0; k < s; ++k) buckets = buckets * (kPieceBits - k) / (k + 1);
+        if (examined + kPieces * buckets * perBucket > budget) return scan(hash, limit, maxDistance);
+        for (int t = 0; t < kPieces; ++t) {
+            // 与查询段相差恰好 s 位的所有段值：枚举 16 位中恰有 s 个 1 的掩码（Gosper）
+            int flips = s == 0 ? 0 : (1 << s) - 1;
+            while (flips < (1 << kPieceBits)) {
+                const std::vector<Slot>& b = tables[t][query[t] ^ flips];
+                examined += 1 + b.size();
+                for (const Slot& slot : b) {
+                    uint64_t h = slot.hash();
+                    int distance = popcount64(h ^ hash);
+                    if (distance > maxDistance) continue;
+                    // 每个条目只在各段距离的最小值 s 所在的第一张表里收一次
+                    bool seen = false;
+                    for (int u = 0; u < kPieces && !seen; ++u) {
+                        int d = popcount64(static_cast<uint64_t>(piece(h, u) ^ query[u]));
+                        seen = u < t ? d <= s : d < s;
+                    }
+                    if (!seen) found.push_back(ImageMatch{owners[slot.entry], distance});
+                }
+                if (examined > budget) return scan(hash, limit, maxDistance);
+                if (flips == 0) break;
+                int lowest = flips & -flips;
+                int ripple = flips + lowest;
+                flips = (((ripple ^ flips) >> 2) / lowest) | ripple;
+            }
+        }
+        // 距离不超过 complete 的条目已全部找到
+        int complete = std::min(maxDistance, kPieces * s + kPieces - 1);
+        if (complete == maxDistance) break;
+        keepBest(found, std::numeric_limits<size_t>::max());
+        size_t settled = std::upper_bound(found.begin(), found.end(), ImageMatch{std::numeric_limits<int>::max(), complete},
+                                          byDistance) - found.begin();
+        if (settled >= limit) break;
+    }
+    keepBest(found, limit);
+    return found;
+}
+
+std::vector<ImageMatch> ImageIndex::scan(uint64_t hash, size_t limit, int maxDistance) const {
+    std::vector<ImageMatch> found;
+    if (maxDistance < 0) return found;
+    if (limit == 0) limit = std::numeric_limits<size_t>::max();
+    // 已收集的结果超过 2*limit 时收缩到前 limit 条，之后只收距离不超过第 limit 条的
+    int threshold = std::min(maxDistance, 64);
+    uint8_t block[kScanBlock];
+    for (size_t begin = 0; begin < hashes.size(); begin += kScanBlock) {
+        size_t n = std::min(kScanBlock, hashes.size() - begin);
+        distances(&hashes[begin], n, hash, block);
+        for (size_t i = 0; i < n; ++i) {
+            if (block[i] <= threshold) found.push_back(ImageMatch{owners[begin + i], block[i]});
+        }
+        if (limit <= found.size() / 2) {
+            keepBest(found, limit);
+            if (found.size() == limit) threshold = found.back().distance;
+        }
+    }
+    keepBest(found, limit);
+    return found;
+}
+
+size_t ImageIndex::memoryBytes() const {
+    size_t bytes = hashes.capacity() * sizeof(uint64_t) + owners.capacity() * sizeof(int);
+    for (const auto& table : tables) {
+        bytes += table.capacity() * sizeof(std::vector<Slot>);
+        for (const auto& b : table) bytes += b.capacity() * sizeof(Slot);
+    }
+    return bytes;
+}
@@ -0,0 +1,57 @@
+#ifndef IMAGEINDEX_H
+#define IMAGEINDEX_H
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 按图搜索的一条结果
+struct ImageMatch {
+    int itemId;
+    int distance;   // 商品各图片与查询图片差异哈希的最小汉明距离
+};
+
+// 可购买商品图片差异哈希（见 ImageHash）的多索引哈希表。
+// 64 位哈希切成 4 段 16 位，每段一张表：段值 -> 含该段值的条目。
+// 按鸽巢原理，与查询距离不超过 4s+3 的哈希至少有一段与查询的对应段相差不超过 s 位，
+// 所以按 s = 0, 1, 2... 逐级探查各表中与查询段相差恰好 s 位的桶，每级结束后
+// 距离不超过 4s+3 的条目都已找到；凑够前 N 件或达到最大距离即可停止。
+// 桶里连同哈希一起存放，探查时顺序读取，不必按条目下标随机访问。
+// 探查的桶数加候选数（预计的或实际的）超过条目数的 1/32（要求的距离很大或哈希分布很集中）时改为顺序扫描全部哈希，
+// 扫描按CPU能力使用 AVX2 / POPCNT 计算汉明距离。
+// 条目连续存放在 hashes/owners 中，删除时用最后一个条目填补空位。
+struct ImageIndex {
+    static const int kPieces = 4;
+    static const int kPieceBits = 16;
+
+    ImageIndex();
+
+    void add(int itemId, uint64_t hash);
+    // 条目不存在时返回 false
+    bool remove(int itemId, uint64_t hash);
+    void clear();
+
+    // 与 hash 的距离不超过 maxDistance 的商品，每件商品按最近的一张图片计，
+    // 按 (距离, 商品ID) 升序取前 limit 件，limit 为 0 表示不限
+    std::vector<ImageMatch> nearest(uint64_t hash, size_t limit, int maxDistance) const;
+    // 同上，不走分段表，顺序扫描全部哈希
+    std::vector<ImageMatch> scan(uint64_t hash, size_t limit, int maxDistance) const;
+
+    size_t size() const { return hashes.size(); }
+    size_t memoryBytes() const;
+
+private:
+    // 桶中的一个条目，哈希拆成两半使结构体按 4 字节对齐
+    struct Slot {
+        uint32_t low;
+        uint32_t high;
+        uint32_t entry;
+        uint64_t hash() const { return (static_cast<uint64_t>(high) << 32) | low; }
+    };
+    static int piece(uint64_t hash, int t) { return static_cast<int>((hash >> (t * kPieceBits)) & 0xffff); }
+    std::vector<Slot>& bucket(int t, uint64_t hash) { return tables[t][piece(hash, t)]; }
+
+    std::vector<uint64_t> hashes;
+    std::vector<int> owners;                         // 条目 -> 商品ID
+    std::vector<std::vector<Slot>> tables[kPieces];  // 段值 -> 条目，第一次添加时分配
+};
+#endif
@@ -3,41 +3,56 @@
 #include <iomanip>
 #include <ctime>
 
-Item::Item(int id, const std::string& name, const std::string& desc, const std::string& cat, double price, int sellerId) : 
-    itemId(id), itemName(name), description(desc), category(cat), price(price), status(AVAILABLE), sellerId(sellerId) {
-    
-    // 初始化发布日期
+Item::Item(int id, const std::string& name, const std::string& desc, const std::string& cat, double price, int sellerId) :
+    Item(id, name, desc, cat, price, sellerId, today()) {}
+
+Item::Item(int id, const std::string& name, const std::string& desc, const std::string& cat, double price, int sellerId,
+           const std::string& publishDate) :
+    itemId(id), price(price), status(AVAILABLE), sellerId(sellerId) {
+    text.assign({name, desc, cat, publishDate});
+}
+
+std::string Item::today() {
+    // localtime 返回共享的静态缓冲区，多个线程同时发布商品时会互相覆盖，改用可重入版本
     time_t now = time(0);
-    tm *ltm = localtime(&now);
+    tm local;
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
     char buffer[11];
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d", ltm);
-    publishDate = std::string(buffer);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d", &local);
+    return buffer;
 }
 
+Item::Item(const Item& other, TextArena& arena) :
+    itemId(other.itemId), text(other.text, arena), price(other.price), images(other.images), imageHashes(other.imageHashes),
+    status(other.status), sellerId(other.sellerId) {}
+
 int Item::getItemId() const { return itemId; }
-std::string Item::getItemName() const { return itemName; }
-std::string Item::getDescription() const { return description; }
-std::string Item::getCategory() const { return category; }
+TextRef Item::getItemName() const { return text.field(NAME); }
+TextRef Item::getDescription() const { return text.field(DESCRIPTION); }
+TextRef Item::getCategory() const { return text.field(CATEGORY); }
+TextRef Item::getPublishDate() const { return text.field(PUBLISH_DATE); }
 double Item::getPrice() const { return price; }
 ItemStatus Item::getStatus() const { return status; }
 int Item::getSellerId() const { return sellerId; }
 
 void Item::setStatus(ItemStatus newStatus) { status = newStatus;}
 
-void Item::updateInfo(const std::string& name, const std::string& desc, const std::string& cat, double newPrice) {
-    itemName = name;
-    description = desc;
-    category = cat;
+void Item::updateInfo(const std::string& name, const std::string& desc, const std::string& cat, double newPrice, TextArena* arena) {
+    text.assign({name, desc, cat, getPublishDate()}, arena);
     price = newPrice;
 }
 
 void Item::displayInfo() const {
     std::cout << "商品ID: " << itemId << "\n";
-    std::cout << "名称: " << itemName << "\n";
-    std::cout << "描述: " << description << "\n";
-    std::cout << "分类: " << category << "\n";
+    std::cout << "名称: " << getItemName() << "\n";
+    std::cout << "描述: " << getDescription() << "\n";
+    std::cout << "分类: " << getCategory() << "\n";
     std::cout << "价格: " << std::fixed << std::setprecision(2) << price << "\n";
-    std::cout << "发布日期: " << publishDate << "\n";
+    std::cout << "发布日期: " << getPublishDate() << "\n";
     
     std::string statusStr;
     switch(status) {
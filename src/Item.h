@@ -2,30 +2,42 @@
 #define ITEM_H
 #include <string>
 #include <vector>
+#include <cstdint>
+#include "RecordText.h"
 
 enum ItemStatus { AVAILABLE, DELETED, SOLD };
 
 struct Item {
+    // text 中各字段的下标
+    enum TextField { NAME, DESCRIPTION, CATEGORY, PUBLISH_DATE, kTextFields };
+
     int itemId;
-    std::string itemName;
-    std::string description;
-    std::string category;
+    RecordText<kTextFields> text;   // 名称、描述、分类、发布日期，连续存放
     double price;
     std::vector<std::string> images;
+    std::vector<uint64_t> imageHashes;   // images 中各图片的差异哈希（见 ImageHash），与 images 一一对应
     ItemStatus status;
-    std::string publishDate;
     int sellerId;
 
     Item(int id, const std::string& name, const std::string& desc, const std::string& cat, double price, int sellerId);
+    // 指定发布日期（YYYY-MM-DD），批量发布时整批只取一次当天日期
+    Item(int id, const std::string& name, const std::string& desc, const std::string& cat, double price, int sellerId,
+         const std::string& publishDate);
+    // 当天日期，格式与发布日期相同
+    static std::string today();
+    // 复制商品，文本写入 arena（商品表内部使用）
+    Item(const Item& other, TextArena& arena);
     int getItemId() const;
-    std::string getItemName() const;
-    std::string getDescription() const;
-    std::string getCategory() const;
+    TextRef getItemName() const;
+    TextRef getDescription() const;
+    TextRef getCategory() const;
+    TextRef getPublishDate() const;
     double getPrice() const;
     ItemStatus getStatus() const;
     int getSellerId() const;
     void setStatus(ItemStatus newStatus);
-    void updateInfo(const std::string& name, const std::string& desc, const std::string& cat, double price);
+    // arena 非空时新文本写入该文本区，否则商品自己持有
+    void updateInfo(const std::string& name, const std::string& desc, const std::string& cat, double price, TextArena* arena = nullptr);
     void displayInfo() const;
     bool isAvailable() const;
 };
@@ -0,0 +1,63 @@
+#include "ItemClaims.h"
+#include <thread>
+
+ItemClaims::ItemClaims() : chunks(new std::atomic<Word*>[kMaxChunks]), count(0) {
+    for (int i = 0; i < kMaxChunks; ++i) chunks[i].store(nullptr, std::memory_order_relaxed);
+}
+
+ItemClaims::~ItemClaims() {
+    for (int i = 0; i < kMaxChunks; ++i) delete[] chunks[i].load(std::memory_order_relaxed);
+}
+
+bool ItemClaims::append(int itemId, ItemStatus status) {
+    int index = count.load(std::memory_order_relaxed);
+    if (itemId != index + 1 || (index >> kChunkBits) >= kMaxChunks) return false;
+    std::atomic<Word*>& chunk = chunks[index >> kChunkBits];
+    if (!chunk.load(std::memory_order_relaxed)) chunk.store(new Word[kChunkSize], std::memory_order_release);
+    chunk.load(std::memory_order_relaxed)[index & (kChunkSize - 1)].store(static_cast<uint8_t>(status), std::memory_order_relaxed);
+    // 计数最后发布，读到新计数的线程一定也能看到块和状态字
+    count.store(index + 1, std::memory_order_release);
+    return true;
+}
+
+ItemClaims::Word* ItemClaims::word(int itemId) const {
+    if (itemId < 1 || itemId > size()) return nullptr;
+    int index = itemId - 1;
+    return &chunks[index >> kChunkBits].load(std::memory_order_acquire)[index & (kChunkSize - 1)];
+}
+
+// 预留方只做比较交换和回写，不会阻塞，通常自旋几次就能等到；单核上或预留方被换出时让出时间片
+bool ItemClaims::acquire(Word& w, uint8_t desired) {
+    for (int spins = 0;; ++spins) {
+        uint8_t expected = AVAILABLE;
+        if (w.compare_exchange_weak(expected, desired, std::memory_order_acq_rel)) return true;
+        if (expected != AVAILABLE && expected != kReserved) return false;
+        if (expected == kReserved && spins >= 64) std::this_thread::yield();
+    }
+}
+
+bool ItemClaims::claim(int itemId, ItemStatus status) {
+    Word* w = status == AVAILABLE ? nullptr : word(itemId);
+    return w && acquire(*w, static_cast<uint8_t>(status));
+}
+
+bool ItemClaims::claimAll(const std::vector<int>& itemIds, ItemStatus status, size_t& conflict) {
+    std::vector<Word*> words(itemIds.size());
+    for (size_t i = 0; i < itemIds.size(); ++i) {
+        words[i] = status == AVAILABLE ? nullptr : word(itemIds[i]);
+        if (!words[i] || !acquire(*words[i], kReserved)) {
+            for (size_t k = 0; k < i; ++k) words[k]->store(AVAILABLE, std::memory_order_release);
+            conflict = i;
+            return false;
+        }
+    }
+    for (Word* w : words) w->store(static_cast<uint8_t>(status), std::memory_order_release);
+    return true;
+}
+
+ItemStatus ItemClaims::status(int itemId) const {
+    Word* w = word(itemId);
+    if (!w) return DELETED;
+    uint8_t value = w->load(std::memory_order_acquire);
+    return value == kReserved ? AVAILABLE : static_cast<ItemStatus>(value);
+}
@@ -0,0 +1,48 @@
+#ifndef ITEMCLAIMS_H
+#define ITEMCLAIMS_H
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "Item.h"
+
+// 商品状态的权威记录：每件商品一个原子状态字，按ID直接寻址。
+// 平台的商品表有两份副本（见 EpochReplicas），购买、删除要在副本之外决出唯一的一方：
+// 先在这里比较交换（只有 AVAILABLE 能变为 SOLD / DELETED），成功后再由写者把状态变化应用到两份副本（ItemStore::setStatus）。
+// 块目录构造时一次分配好，块只追加不搬动，claim / status 不加锁，可以与 append 同时执行。
+struct ItemClaims {
+    static const int kChunkBits = 16;
+    static const int kChunkSize = 1 << kChunkBits;
+    static const int kMaxChunks = 1 << 14;
+    static const int kCapacity = kMaxChunks * kChunkSize;   // 最多登记的商品数
+
+    ItemClaims();
+    ~ItemClaims();
+    ItemClaims(const ItemClaims&) = delete;
+    ItemClaims& operator=(const ItemClaims&) = delete;
+
+    // 登记新商品，itemId 必须等于 size()+1，否则返回 false；同一时刻只能有一个线程调用
+    bool append(int itemId, ItemStatus status);
+    // AVAILABLE -> SOLD / DELETED 的比较交换，只有一个调用者会成功；
+    // 商品正被 claimAll 预留时等预留落定，预留撤销后仍可能成功，只有已售出或已删除才失败
+    bool claim(int itemId, ItemStatus status);
+    // 全部成功或全部不变地把一批商品改为 status：先逐件预留，有一件已售出或已删除就撤销已预留的，
+    // 把那件商品的下标写入 conflict 并返回 false；全部预留到后再逐件改为 status。
+    // 遇到其他批次预留中的商品同样等它落定。itemIds 须升序且不重复，各批次按同样的顺序预留，
+    // 等待的一方只持有ID更小的预留，不会互相等待成环。预留期间 status() 仍报告 AVAILABLE
+    bool claimAll(const std::vector<int>& itemIds, ItemStatus status, size_t& conflict);
+    // 商品未登记时返回 DELETED
+    ItemStatus status(int itemId) const;
+    int size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    typedef std::atomic<uint8_t> Word;
+    static const uint8_t kReserved = 0xff;   // claimAll 预留中
+    Word* word(int itemId) const;
+    // AVAILABLE -> desired 的比较交换，遇到预留中的商品等它落定
+    static bool acquire(Word& w, uint8_t desired);
+
+    std::unique_ptr<std::atomic<Word*>[]> chunks;
+    std::atomic<int> count;
+};
+#endif
@@ -0,0 +1,86 @@
+#ifndef ITEMCOLUMNS_H
+#define ITEMCOLUMNS_H
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "Item.h"
+#include "Utf8.h"
+
+// 名称和描述的字符签名（每个字符散列到一位，ASCII 字母不分大小写）与字符数（超过 65535 记为 65535），
+// 相关度排序估计得分上界时一次读入
+struct TextSummary {
+    uint64_t nameSignature;
+    uint64_t descSignature;
+    uint16_t nameLength;
+    uint16_t descLength;
+};
+
+// 商品表的列存影子：第 id 行对应ID为 id 的商品，第0行是占位行（状态为 kNoStatus，任何过滤都不会选中），
+// 这样选择位图的第 i 位就是ID i，可以直接和按ID组织的位图求交。
+// 只保存过滤常用的定长字段，扫描价格/状态/分类时不必把整条 Item（含多个字符串）读进缓存。
+// 名称和描述另外存一份摘要（TextSummary），相关度排序用它估计得分上界，不必读取原文。
+struct ItemColumns {
+    static const uint8_t kNoStatus = 0xff;
+
+    std::vector<double> price;
+    std::vector<uint8_t> status;       // ItemStatus
+    std::vector<int32_t> categoryId;   // CategoryDictionary 中的分类ID
+    std::vector<int32_t> sellerId;
+    std::vector<TextSummary> text;
+
+    ItemColumns() { clear(); }
+
+    static uint64_t signatureBit(int32_t c) {
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        return uint64_t(1) << ((static_cast<uint32_t>(c) * 2654435761u) >> 26);
+    }
+
+    // 文本中全部字符的签名与字符数，非法字节按一个字符计、不进签名
+    static void summarize(TextRef field, uint64_t& signature, uint16_t& length) {
+        signature = 0;
+        size_t chars = 0;
+        size_t pos = 0;
+        while (pos < field.size()) {
+            int32_t c = decodeUtf8(field, pos);
+            if (c >= 0) signature |= signatureBit(c);
+            ++chars;
+        }
+        length = static_cast<uint16_t>(chars < 65535 ? chars : 65535);
+    }
+
+    void setText(int row, TextRef name, TextRef description) {
+        summarize(name, text[row].nameSignature, text[row].nameLength);
+        summarize(description, text[row].descSignature, text[row].descLength);
+    }
+
+    int rows() const { return static_cast<int>(price.size()); }
+
+    void append(const Item& item, int category) {
+        price.push_back(item.getPrice());
+        status.push_back(static_cast<uint8_t>(item.getStatus()));
+        categoryId.push_back(category);
+        sellerId.push_back(item.getSellerId());
+        text.push_back(TextSummary());
+        setText(rows() - 1, item.getItemName(), item.getDescription());
+    }
+
+    // 容量不够 rows 行时至少翻倍，连续的小批量追加不会每批都搬动各列
+    void reserve(size_t rows) {
+        if (price.capacity() >= rows) return;
+        rows = std::max(rows, price.capacity() * 2);
+        price.reserve(rows);
+        status.reserve(rows);
+        categoryId.reserve(rows);
+        sellerId.reserve(rows);
+        text.reserve(rows);
+    }
+
+    void clear() {
+        price.assign(1, 0.0);
+        status.assign(1, static_cast<uint8_t>(kNoStatus));
+        categoryId.assign(1, -1);
+        sellerId.assign(1, 0);
+        text.assign(1, TextSummary());
+    }
+};
+#endif
@@ -0,0 +1,109 @@
+#include "ItemOrder.h"
+#include <algorithm>
+#include <cstring>
+
+ItemOrder::ItemOrder(const std::string& sortBy) {
+    size_t begin = 0;
+    while (begin <= sortBy.size()) {
+        size_t end = sortBy.find(',', begin);
+        if (end == std::string::npos) end = sortBy.size();
+        std::string name = sortBy.substr(begin, end - begin);
+        if (name == "price_asc") keys.push_back(KEY_PRICE_ASC);
+        else if (name == "price_desc") keys.push_back(KEY_PRICE_DESC);
+        else if (name == "newest") keys.push_back(KEY_ID_DESC);
+        else if (name == "oldest") keys.push_back(KEY_ID_ASC);
+        else if (name == "date_asc") keys.push_back(KEY_DATE_ASC);
+        else if (name == "date_desc") keys.push_back(KEY_DATE_DESC);
+        else if (name == "relevance") keys.push_back(KEY_RELEVANCE);
+        begin = end + 1;
+    }
+}
+
+// 发布日期为 YYYY-MM-DD，按字节比较即按日期比较
+static int compareDate(const Item& a, const Item& b) {
+    TextRef x = a.getPublishDate();
+    TextRef y = b.getPublishDate();
+    int c = std::memcmp(x.data(), y.data(), std::min(x.size(), y.size()));
+    if (c != 0) return c;
+    return x.size() < y.size() ? -1 : (x.size() > y.size() ? 1 : 0);
+}
+
+bool ItemOrder::before(const Item& a, const Item& b) const {
+    for (SortKey key : keys) {
+        switch (key) {
+            case KEY_PRICE_ASC:
+                if (a.getPrice() != b.getPrice()) return a.getPrice() < b.getPrice();
+                break;
+            case KEY_PRICE_DESC:
+                if (a.getPrice() != b.getPrice()) return a.getPrice() > b.getPrice();
+                break;
+            case KEY_ID_ASC:
+                if (a.getItemId() != b.getItemId()) return a.getItemId() < b.getItemId();
+                break;
+            case KEY_ID_DESC:
+                if (a.getItemId() != b.getItemId()) return a.getItemId() > b.getItemId();
+                break;
+            case KEY_DATE_ASC:
+            case KEY_DATE_DESC: {
+                int c = compareDate(a, b);
+                if (c != 0) return key == KEY_DATE_ASC ? c < 0 : c > 0;
+                break;
+            }
+            case KEY_RELEVANCE:
+                // 得分不在商品上，由 RelevanceRanker 比较
+                break;
+        }
+    }
+    return false;
+}
+
+TopKCollector::TopKCollector(const ItemOrder& ord, size_t k) : order(ord), keep(k), seq(0) {
+    heap.reserve(std::min<size_t>(k, 4096));
+}
+
+bool TopKCollector::better(const Entry& a, const Entry& b) const {
+    if (order.before(*a.item, *b.item)) return true;
+    if (order.before(*b.item, *a.item)) return false;
+    return a.seq < b.seq;
+}
+
+void TopKCollector::offer(const Item* item) {
+    Entry entry{item, seq++};
+    if (keep == 0) return;
+    auto cmp = [this](const Entry& a, const Entry& b) { return better(a, b); };
+    if (heap.size() < keep) {
+        heap.push_back(entry);
+        std::push_heap(heap.begin(), heap.end(), cmp);
+    } else if (better(entry, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end(), cmp);
+    }
+}
+
+void TopKCollector::drain(std::vector<const Item*>& out, size_t offset) {
+    auto cmp = [this](const Entry& a, const Entry& b) { return better(a, b); };
+    std::sort_heap(heap.begin(), heap.end(), cmp);
+    for (size_t i = offset; i < heap.size(); ++i) out.push_back(heap[i].item);
+    heap.clear();
+}
+
+void orderRefs(std::vector<const Item*>& refs, const ItemOrder& order, size_t offset, size_t limit) {
+    if (limit > 0 && !order.empty() && offset + limit < refs.size()) {
+        TopKCollector top(order, offset + limit);
+        for (const Item* item : refs) top.offer(item);
+        refs.clear();
+        top.drain(refs, offset);
+        return;
+    }
+    if (!order.empty()) {
+        std::stable_sort(refs.begin(), refs.end(),
+                         [&order](const Item* a, const Item* b) { return order.before(*a, *b); });
+    }
+    if (offset >= refs.size()) {
+        refs.clear();
+        return;
+    }
+    refs.erase(refs.begin(), refs.begin() + offset);
+    if (limit > 0 && refs.size() > limit) refs.resize(limit);
+}
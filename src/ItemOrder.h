@@ -0,0 +1,63 @@
+#ifndef ITEMORDER_H
+#define ITEMORDER_H
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Item.h"
+
+// 单个排序键
+enum SortKey {
+    KEY_PRICE_ASC,
+    KEY_PRICE_DESC,
+    KEY_ID_ASC,       // oldest：发布先后
+    KEY_ID_DESC,      // newest：最新发布在前
+    KEY_DATE_ASC,     // 按发布日期，同一天的商品再看后面的键
+    KEY_DATE_DESC,
+    KEY_RELEVANCE     // 关键词相关度，只有商品表上的关键词查询才计分（见 RelevanceRanker），其余情况下忽略
+};
+
+// 多键排序：依次比较 keys，全部相同时保持输入顺序（稳定）。
+// sortBy 为逗号分隔的键名：price_asc / price_desc / newest / oldest / date_asc / date_desc / relevance，
+// 例如 "price_asc,newest" 表示价格从低到高、同价时新发布的在前；无法识别的键忽略。
+struct ItemOrder {
+    std::vector<SortKey> keys;
+
+    ItemOrder() {}
+    explicit ItemOrder(const std::string& sortBy);
+
+    bool empty() const { return keys.empty(); }
+    // a 是否严格排在 b 前面
+    bool before(const Item& a, const Item& b) const;
+};
+
+// 流式 Top-K：只保留排序最靠前的 keep 件商品（有界堆），不物化全部匹配结果。
+// 排序键相同的商品按 offer 的先后排列，结果与对全部商品稳定排序后取前 keep 件一致。
+struct TopKCollector {
+    TopKCollector(const ItemOrder& order, size_t keep);
+
+    void offer(const Item* item);
+    // 按顺序输出第 offset 名之后的结果（追加到 out）
+    void drain(std::vector<const Item*>& out, size_t offset);
+    size_t offered() const { return static_cast<size_t>(seq); }
+    bool full() const { return keep > 0 && heap.size() == keep; }
+    // 当前保留的最差一件，full() 时才有意义
+    const Item* worst() const { return heap.front().item; }
+
+private:
+    struct Entry {
+        const Item* item;
+        uint64_t seq;
+    };
+    bool better(const Entry& a, const Entry& b) const;
+
+    const ItemOrder& order;
+    size_t keep;
+    uint64_t seq;
+    std::vector<Entry> heap;   // 大顶堆，堆顶是当前保留的最差一件
+};
+
+// 按 order 排列 refs 并只保留第 [offset, offset + limit) 名；limit 为 0 表示不限。
+// 有限制时用有界堆选出前 offset + limit 名，不对全部结果排序
+void orderRefs(std::vector<const Item*>& refs, const ItemOrder& order, size_t offset, size_t limit);
+#endif
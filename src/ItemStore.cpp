@@ -0,0 +1,349 @@
+#include "ItemStore.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+// 墓碑数超过该下限且不少于可购买商品数时自动压实，保证扫描中墓碑占比不超过一半
+static const int kMinTombstonesToCompact = 1024;
+// 文本区中被替换的文本超过该下限且占到一半时自动重建
+static const size_t kMinTextGarbageToCompact = TextArena::kChunkBytes;
+
+// 一个块存放 kChunkSize 个商品，按需就地构造
+struct ItemStore::Chunk {
+    typename std::aligned_storage<sizeof(Item), alignof(Item)>::type slots[kChunkSize];
+    int used;
+
+    Chunk() : used(0) {}
+    ~Chunk() {
+        for (int i = 0; i < used; ++i) {
+            slot(i)->~Item();
+        }
+    }
+    Item* slot(int i) { return reinterpret_cast<Item*>(&slots[i]); }
+    const Item* slot(int i) const { return reinterpret_cast<const Item*>(&slots[i]); }
+};
+
+ItemStore::ItemStore()
+    : count(0), textGarbage(0), lengthMembers(1 << (2 * kLengthClassBits)), lengthSlots(1, -1),
+      textStamps(kTextStampBuckets, 0), version(0), tombstoneCount(0), soldCount(0), deletedCount(0) {}
+
+ItemStore::~ItemStore() {}
+
+// 容量不够时至少翻倍，连续的小批量追加不会每批都整体搬动
+template <typename T>
+static void reserveAtLeast(std::vector<T>& v, size_t size) {
+    if (v.capacity() < size) v.reserve(std::max(size, v.capacity() * 2));
+}
+
+Item* ItemStore::add(const Item& item) {
+    if (item.getItemId() != count + 1) {
+        return nullptr;
+    }
+    Item* slot = place(item);
+    if (slot->isAvailable()) prices.insert(slot->getPrice(), slot->getItemId());
+    ++version;
+    return slot;
+}
+
+bool ItemStore::addBatch(const std::vector<Item>& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (batch[i].getItemId() != count + 1 + static_cast<int>(i)) return false;
+    }
+    if (batch.empty()) return true;
+    size_t rows = static_cast<size_t>(count) + batch.size();
+    columns.reserve(rows + 1);
+    reserveAtLeast(lengthSlots, rows + 1);
+    reserveAtLeast(liveIds, liveIds.size() + batch.size());
+    std::vector<std::pair<double, int>> priced;
+    std::vector<std::pair<TextRef, TextRef>> phrases;
+    priced.reserve(batch.size());
+    phrases.reserve(batch.size());
+    for (const Item& item : batch) {
+        Item* slot = place(item, &phrases);
+        if (slot->isAvailable()) priced.push_back(std::make_pair(slot->getPrice(), slot->getItemId()));
+    }
+    prices.insertBatch(std::move(priced));
+    suggestPhrases.addBatch(phrases);
+    ++version;
+    return true;
+}
+
+// 在下一个槽位构造商品并登记到列存、分区和除价格索引外的各个索引；
+// 给了 phrases 时补全短语留给调用方整批登记
+Item* ItemStore::place(const Item& item, std::vector<std::pair<TextRef, TextRef>>* phrases) {
+    int offset = count & (kChunkSize - 1);
+    if (offset == 0) {
+        chunks.emplace_back(new Chunk());
+    }
+    Chunk& chunk = *chunks.back();
+    Item* slot = new (chunk.slot(offset)) Item(item, text);
+    chunk.used = offset + 1;
+    ++count;
+    int categoryId = categories.intern(slot->getCategory());
+    columns.append(*slot, categoryId);
+    lengthSlots.push_back(-1);
+    if (static_cast<int>(categoryItems.size()) <= categoryId) {
+        categoryItems.resize(categoryId + 1);
+    }
+    if (slot->getStatus() == AVAILABLE) {
+        touch(*slot, categoryId);
+        liveIds.push_back(slot->getItemId());
+        categoryItems[categoryId].add(slot->getItemId());
+        textPostings.add(slot->getItemId(), slot->getItemName(), slot->getDescription());
+        joinLengthGroup(slot->getItemId());
+        if (phrases) {
+            phrases->push_back(std::make_pair(slot->getItemName(), slot->getCategory()));
+        } else {
+            suggestPhrases.add(slot->getItemName(), slot->getCategory());
+        }
+        for (uint64_t hash : slot->imageHashes) imageHashes.add(slot->getItemId(), hash);
+    } else {
+        retiredIds.push_back(slot->getItemId());
+        if (slot->getStatus() == SOLD) ++soldCount; else ++deletedCount;
+    }
+    return slot;
+}
+
+Item* ItemStore::find(int itemId) {
+    if (itemId < 1 || itemId > count) return nullptr;
+    return &at(itemId - 1);
+}
+
+const Item* ItemStore::find(int itemId) const {
+    if (itemId < 1 || itemId > count) return nullptr;
+    return &at(itemId - 1);
+}
+
+int ItemStore::size() const { return count; }
+
+bool ItemStore::empty() const { return count == 0; }
+
+void ItemStore::clear() {
+    chunks.clear();
+    text.clear();
+    textGarbage = 0;
+    count = 0;
+    liveIds.clear();
+    retiredIds.clear();
+    columns.clear();
+    categories = CategoryDictionary();
+    categoryItems.clear();
+    textPostings.clear();
+    for (auto& group : lengthMembers) group.clear();
+    lengthSlots.assign(1, -1);
+    prices.clear();
+    suggestPhrases.clear();
+    imageHashes.clear();
+    tombstoneCount = soldCount = deletedCount = 0;
+    ++version;
+    // 分类ID会重新分配，所有版本号都推进一次，清空前缓存的结果不会再被当作有效
+    for (auto& stamp : categoryStamps) ++stamp;
+    for (auto& stamp : textStamps) ++stamp;
+}
+
+// liveIds 中墓碑为负数，按绝对值仍保持升序，可以直接二分
+static bool liveIdLess(int entry, int itemId) {
+    return std::abs(entry) < itemId;
+}
+
+bool ItemStore::setStatus(int itemId, ItemStatus status) {
+    if (!leaveHot(itemId, status)) return false;
+    prices.erase(columns.price[itemId], itemId);
+    ++version;
+    maybeCompact();
+    return true;
+}
+
+int ItemStore::setStatusBatch(const std::vector<int>& itemIds, ItemStatus status) {
+    std::vector<std::pair<double, int>> retired;
+    for (int itemId : itemIds) {
+        if (leaveHot(itemId, status)) retired.push_back(std::make_pair(columns.price[itemId], itemId));
+    }
+    if (retired.empty()) return 0;
+    prices.eraseBatch(retired);
+    ++version;
+    maybeCompact();
+    return static_cast<int>(retired.size());
+}
+
+// 可购买的商品改为 status，离开热分区和除价格索引外的各个索引；没有需要做的时返回 false
+bool ItemStore::leaveHot(int itemId, ItemStatus status) {
+    Item* item = find(itemId);
+    if (!item || !item->isAvailable() || status == AVAILABLE) return false;
+
+    touch(*item, columns.categoryId[itemId]);
+    if (status == SOLD) ++soldCount; else ++deletedCount;
+    // 下架：热分区留墓碑，移入冷分区
+    auto pos = std::lower_bound(liveIds.begin(), liveIds.end(), itemId, liveIdLess);
+    if (pos != liveIds.end() && *pos == itemId) {
+        *pos = -itemId;
+        ++tombstoneCount;
+    }
+    retiredIds.push_back(itemId);
+    categoryItems[columns.categoryId[itemId]].remove(itemId);
+    textPostings.remove(itemId, item->getItemName(), item->getDescription());
+    leaveLengthGroup(itemId);
+    suggestPhrases.remove(item->getItemName(), item->getCategory());
+    for (uint64_t hash : item->imageHashes) imageHashes.remove(itemId, hash);
+    item->setStatus(status);
+    columns.status[itemId] = static_cast<uint8_t>(status);
+    return true;
+}
+
+bool ItemStore::updateInfo(int itemId, const std::string& name, const std::string& desc, const std::string& cat, double price) {
+    Item* item = find(itemId);
+    if (!item) return false;
+    int oldCategory = columns.categoryId[itemId];
+    int newCategory = categories.intern(cat);
+    if (static_cast<int>(categoryItems.size()) <= newCategory) {
+        categoryItems.resize(newCategory + 1);
+    }
+    if (item->isAvailable()) {
+        touch(*item, oldCategory);
+        textPostings.remove(itemId, item->getItemName(), item->getDescription());
+        suggestPhrases.remove(item->getItemName(), item->getCategory());
+        leaveLengthGroup(itemId);
+    }
+    if (item->text.arenaBacked()) textGarbage += item->text.bytes();
+    item->updateInfo(name, desc, cat, price, &text);
+    if (item->isAvailable()) {
+        touch(*item, newCategory);
+        textPostings.add(itemId, item->getItemName(), item->getDescription());
+        suggestPhrases.add(item->getItemName(), item->getCategory());
+    }
+    if (item->isAvailable() && columns.price[itemId] != price) {
+        prices.erase(columns.price[itemId], itemId);
+        prices.insert(price, itemId);
+    }
+    columns.price[itemId] = price;
+    columns.categoryId[itemId] = newCategory;
+    columns.setText(itemId, item->getItemName(), item->getDescription());
+    if (item->isAvailable()) joinLengthGroup(itemId);
+    if (item->isAvailable() && oldCategory != newCategory) {
+        categoryItems[oldCategory].remove(itemId);
+        categoryItems[newCategory].add(itemId);
+    }
+    ++version;
+    maybeCompact();
+    return true;
+}
+
+// 名称字符数占高位、描述字符数占低位，各自超过上限的记为上限
+int ItemStore::lengthClass(int nameChars, int descChars) {
+    const int cap = (1 << kLengthClassBits) - 1;
+    return (std::min(nameChars, cap) << kLengthClassBits) | std::min(descChars, cap);
+}
+
+void ItemStore::joinLengthGroup(int itemId) {
+    const TextSummary& text = columns.text[itemId];
+    auto& group = lengthMembers[lengthClass(text.nameLength, text.descLength)];
+    lengthSlots[itemId] = static_cast<int>(group.size());
+    group.push_back(LengthGroupMember{itemId, text.nameSignature, text.descSignature});
+}
+
+// 组内无序，用最后一个成员填补空位
+void ItemStore::leaveLengthGroup(int itemId) {
+    const TextSummary& text = columns.text[itemId];
+    auto& group = lengthMembers[lengthClass(text.nameLength, text.descLength)];
+    int slot = lengthSlots[itemId];
+    group[slot] = group.back();
+    lengthSlots[group[slot].itemId] = slot;
+    group.pop_back();
+    lengthSlots[itemId] = -1;
+}
+
+// 码点散列到字符桶
+static int textBucket(int32_t c) {
+    return static_cast<int>((static_cast<uint32_t>(c) * 2654435761u) >> 20) & (ItemStore::kTextStampBuckets - 1);
+}
+
+void ItemStore::touch(const Item& item, int categoryId) {
+    if (static_cast<int>(categoryStamps.size()) <= categoryId) {
+        categoryStamps.resize(categoryId + 1, 0);
+    }
+    ++categoryStamps[categoryId];
+    // 非法字节不会出现在能匹配到商品的关键词里，跳过即可
+    for (TextRef text : {item.getItemName(), item.getDescription()}) {
+        size_t pos = 0;
+        while (pos < text.size()) {
+            int32_t c = decodeUtf8(text, pos);
+            if (c >= 0) ++textStamps[textBucket(c)];
+        }
+    }
+}
+
+unsigned long long ItemStore::categoryVersion(int categoryId) const {
+    if (categoryId < 0 || categoryId >= static_cast<int>(categoryStamps.size())) return 0;
+    return categoryStamps[categoryId];
+}
+
+int ItemStore::quietestTextBucket(const std::string& keyword) const {
+    int best = -1;
+    size_t pos = 0;
+    while (pos < keyword.size()) {
+        int32_t c = decodeUtf8(keyword, pos);
+        if (c < 0) return -1;
+        int bucket = textBucket(c);
+        if (best < 0 || textStamps[bucket] < textStamps[best]) best = bucket;
+    }
+    return best;
+}
+
+const RoaringBitmap* ItemStore::categoryBitmap(const std::string& category) const {
+    int id = categories.lookup(category);
+    return id < 0 ? nullptr : &categoryItems[id];
+}
+
+// 把所有商品的文本拷贝到新的文本区，旧文本区连同其中被替换的文本一起释放
+void ItemStore::compactText() {
+    TextArena fresh;
+    for (int i = 0; i < count; ++i) {
+        at(i).text.moveTo(fresh);
+    }
+    text.swap(fresh);
+    textGarbage = 0;
+}
+
+int ItemStore::compact() {
+    if (textGarbage > 0) compactText();
+    prices.compact();
+    if (tombstoneCount == 0) return 0;
+    int removed = tombstoneCount;
+    liveIds.erase(std::remove_if(liveIds.begin(), liveIds.end(), [](int id) { return id < 0; }), liveIds.end());
+    liveIds.shrink_to_fit();
+    tombstoneCount = 0;
+    return removed;
+}
+
+void ItemStore::maybeCompact() {
+    if (tombstoneCount >= kMinTombstonesToCompact && tombstoneCount >= liveCount()) {
+        compact();
+    } else if (textGarbage >= kMinTextGarbageToCompact && textGarbage * 2 >= text.usedBytes()) {
+        compactText();
+    }
+}
+
+int ItemStore::liveCount() const {
+    return static_cast<int>(liveIds.size()) - tombstoneCount;
+}
+
+CatalogStats ItemStore::stats() const {
+    CatalogStats s;
+    s.liveRows = liveCount();
+    s.soldRows = soldCount;
+    s.deletedRows = deletedCount;
+    s.tombstones = tombstoneCount;
+    s.textBytes = text.usedBytes();
+    s.textGarbage = textGarbage;
+    return s;
+}
+
+Item& ItemStore::at(int index) {
+    return *chunks[index >> kChunkBits]->slot(index & (kChunkSize - 1));
+}
+
+const Item& ItemStore::at(int index) const {
+    return *chunks[index >> kChunkBits]->slot(index & (kChunkSize - 1));
+}
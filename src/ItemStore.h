@@ -0,0 +1,236 @@
+#ifndef ITEMSTORE_H
+#define ITEMSTORE_H
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <cstddef>
+#include "Item.h"
+#include "ItemColumns.h"
+#include "CategoryDictionary.h"
+#include "RoaringBitmap.h"
+#include "TextArena.h"
+#include "TextIndex.h"
+#include "PriceIndex.h"
+#include "SuggestIndex.h"
+#include "ImageIndex.h"
+
+// 长度分组的成员：商品ID与名称/描述签名放在一起，相关度排序按组顺序读取，不必随机访问列存
+struct LengthGroupMember {
+    int itemId;
+    uint64_t nameSignature;
+    uint64_t descSignature;
+};
+
+// 商品表分区统计
+struct CatalogStats {
+    int liveRows;     // 热分区：可购买
+    int soldRows;     // 冷分区：已售出
+    int deletedRows;  // 冷分区：已删除
+    int tombstones;   // 热分区中已下架、等待压实的墓碑
+    size_t textBytes;    // 文本区中已写入的字节
+    size_t textGarbage;  // 其中被修改替换掉、等待压实回收的字节
+};
+
+// 按商品ID直接寻址的商品表
+// 商品ID由平台从1开始连续分配，第 id 号商品固定存放在第 id-1 个槽位，查找为 O(1)。
+// 槽位按固定大小的块分配，扩容只追加新块、从不搬动已有商品，
+// 因此 find 返回的 Item* 在之后继续发布商品时依然有效。
+// 商品的文本字段存放在商品表的文本区 text 里，不再每个字符串单独分配；
+// updateInfo 替换掉的旧文本记为垃圾，压实时把文本拷贝到新的文本区一并回收。
+//
+// 另外按状态分区：liveIds 按ID升序记录可购买的商品，浏览和搜索只扫描它；
+// 售出/删除的商品在 liveIds 中留下墓碑（取负ID）并移入冷分区 retiredIds，
+// 墓碑累积到一定数量时自动压实，也可以调用 compact() 手动压实。
+struct ItemStore {
+    static const int kChunkBits = 10;
+    static const int kChunkSize = 1 << kChunkBits;
+
+    ItemStore();
+    ~ItemStore();
+    ItemStore(const ItemStore&) = delete;
+    ItemStore& operator=(const ItemStore&) = delete;
+
+    // 追加商品，item 的ID必须等于 size()+1，否则返回 nullptr
+    Item* add(const Item& item);
+    // 批量追加，ID必须从 size()+1 起连续，否则返回 false 且不做任何修改。
+    // 各存储一次预留容量，价格索引整批归并一次，版本号只加一
+    bool addBatch(const std::vector<Item>& batch);
+    Item* find(int itemId);
+    const Item* find(int itemId) const;
+    int size() const;
+    bool empty() const;
+    void clear();
+
+    // 商品状态只能从 AVAILABLE 变为 SOLD 或 DELETED：改写 Item::status 与列存，并把商品移出热分区和各个索引。
+    // 和其余修改操作一样需要独占商品表；多个线程之间由谁卖出/删除在 ItemClaims 中决出，这里只应用结果。
+    // 商品不存在、目标状态是 AVAILABLE 或商品已不是 AVAILABLE 时返回 false
+    bool setStatus(int itemId, ItemStatus status);
+    // 对一批商品做 setStatus，价格索引整批删除，版本号只加一，压实只检查一次；返回状态改变了的商品数
+    int setStatusBatch(const std::vector<int>& itemIds, ItemStatus status);
+    // 修改商品信息（Item::updateInfo），同步更新分类ID、列存、分类位图、文本索引、价格索引和补全索引
+    bool updateInfo(int itemId, const std::string& name, const std::string& desc, const std::string& cat, double price);
+    // 清除热分区中的墓碑、回收文本区中被替换的文本并整理价格索引，返回清除的墓碑数量
+    int compact();
+    CatalogStats stats() const;
+    int liveCount() const;
+    // 定长字段的列存影子与分类字典，随发布和状态变化同步维护
+    const ItemColumns& columnar() const { return columns; }
+    const CategoryDictionary& categoryDictionary() const { return categories; }
+    // 某分类下可购买商品的ID位图，分类不存在时返回 nullptr
+    const RoaringBitmap* categoryBitmap(const std::string& category) const;
+    const RoaringBitmap& categoryBitmap(int categoryId) const { return categoryItems[categoryId]; }
+    // 可购买商品名称和描述的倒排索引
+    const TextIndex& textIndex() const { return textPostings; }
+    // 按名称、描述字符数分组的可购买商品（下标见 lengthClass，组内无序），相关度排序先看文本短、得分上界高的组
+    static const int kLengthClassBits = 6;
+    static int lengthClass(int nameChars, int descChars);
+    const std::vector<std::vector<LengthGroupMember>>& lengthGroups() const { return lengthMembers; }
+    // 可购买商品按 (价格, ID) 排序的索引，价格区间查询和按价格排序使用
+    const PriceIndex& priceIndex() const { return prices; }
+    // 可购买商品名称和分类名的前缀补全索引
+    const SuggestIndex& suggestions() const { return suggestPhrases; }
+    SuggestIndex& suggestions() { return suggestPhrases; }
+    // 可购买商品图片差异哈希的索引，按图搜索使用
+    const ImageIndex& imageIndex() const { return imageHashes; }
+    // 商品表版本号，每次发布、修改或状态变化（批量操作整批算一次）加一，用于判断查询视图是否过期
+    unsigned long long generation() const { return version; }
+    const std::vector<int>& retired() const { return retiredIds; }
+
+    // 查询结果的失效戳：可购买商品集合发生变化（发布、购买、删除、重新上架）或在售商品被修改时，
+    // 该商品所在分类（修改分类时新旧两个）的版本号加一，商品名称和描述中每个字符所在的字符桶也加一。
+    // 只依赖某个分类或某个关键词的查询结果，在对应的版本号不变时一定不变。版本号只增不减，clear() 也不归零
+    static const int kTextStampBuckets = 4096;
+    // 分类ID -1 表示分类不存在，返回 0
+    unsigned long long categoryVersion(int categoryId) const;
+    // keyword 各字符所在的桶中版本号最小的一个（变化最少，失效最少）；keyword 为空或不是合法 UTF-8 时返回 -1
+    int quietestTextBucket(const std::string& keyword) const;
+    unsigned long long textVersion(int bucket) const { return textStamps[bucket]; }
+
+    // 按ID顺序遍历全部商品（包含已售出/已删除）
+    template <typename StoreT, typename ItemT>
+    struct BasicIterator {
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Item value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef ItemT* pointer;
+        typedef ItemT& reference;
+
+        StoreT* store;
+        int index;
+
+        BasicIterator(StoreT* s, int i) : store(s), index(i) {}
+        reference operator*() const { return store->at(index); }
+        pointer operator->() const { return &store->at(index); }
+        BasicIterator& operator++() { ++index; return *this; }
+        BasicIterator operator++(int) { BasicIterator old = *this; ++index; return old; }
+        bool operator==(const BasicIterator& other) const { return index == other.index; }
+        bool operator!=(const BasicIterator& other) const { return index != other.index; }
+    };
+    typedef BasicIterator<ItemStore, Item> iterator;
+    typedef BasicIterator<const ItemStore, const Item> const_iterator;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    // 只遍历热分区中可购买的商品，按ID升序
+    struct AvailableRange {
+        struct const_iterator {
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Item value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Item* pointer;
+            typedef const Item& reference;
+
+            const ItemStore* store;
+            const int* pos;
+            const int* last;
+
+            const_iterator(const ItemStore* s, const int* p, const int* e) : store(s), pos(p), last(e) { skip(); }
+            void skip() { while (pos != last && *pos < 0) ++pos; }
+            reference operator*() const { return store->at(*pos - 1); }
+            pointer operator->() const { return &store->at(*pos - 1); }
+            const_iterator& operator++() { ++pos; skip(); return *this; }
+            bool operator==(const const_iterator& other) const { return pos == other.pos; }
+            bool operator!=(const const_iterator& other) const { return pos != other.pos; }
+        };
+
+        const ItemStore* store;
+        const_iterator begin() const {
+            const int* data = store->liveIds.data();
+            return const_iterator(store, data, data + store->liveIds.size());
+        }
+        const_iterator end() const {
+            const int* data = store->liveIds.data();
+            return const_iterator(store, data + store->liveIds.size(), data + store->liveIds.size());
+        }
+    };
+    AvailableRange available() const { return AvailableRange{this}; }
+
+    // 从ID大于 afterId 的可购买商品开始按ID升序遍历，visit 返回 false 时停止
+    // 定位用二分查找，分页时不需要经过前面的商品
+    template <typename Visit>
+    void scanAvailableAfter(int afterId, Visit visit) const {
+        auto pos = std::upper_bound(liveIds.begin(), liveIds.end(), afterId,
+                                    [](int id, int entry) { return id < std::abs(entry); });
+        for (; pos != liveIds.end(); ++pos) {
+            if (*pos < 0) continue;
+            if (!visit(at(*pos - 1))) return;
+        }
+    }
+
+    // 从ID小于 beforeId 的可购买商品开始按ID降序遍历
+    template <typename Visit>
+    void scanAvailableBefore(int beforeId, Visit visit) const {
+        auto pos = std::lower_bound(liveIds.begin(), liveIds.end(), beforeId,
+                                    [](int entry, int id) { return std::abs(entry) < id; });
+        while (pos != liveIds.begin()) {
+            --pos;
+            if (*pos < 0) continue;
+            if (!visit(at(*pos - 1))) return;
+        }
+    }
+
+private:
+    struct Chunk;
+
+    Item& at(int index);
+    const Item& at(int index) const;
+
+    Item* place(const Item& item, std::vector<std::pair<TextRef, TextRef>>* phrases = nullptr);
+    bool leaveHot(int itemId, ItemStatus status);
+    void maybeCompact();
+    void compactText();
+    // 商品的变化可能影响查询结果，推进它的分类和文本字符桶的版本号
+    void touch(const Item& item, int categoryId);
+    // 按列存中的摘要加入/离开长度分组
+    void joinLengthGroup(int itemId);
+    void leaveLengthGroup(int itemId);
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    int count;
+    TextArena text;             // 全部商品的文本
+    size_t textGarbage;         // text 中已被替换的字节数
+
+    std::vector<int> liveIds;     // 可购买商品ID，升序；墓碑记为 -id
+    std::vector<int> retiredIds;  // 已售出/已删除商品ID，按下架先后
+    ItemColumns columns;
+    CategoryDictionary categories;
+    std::vector<RoaringBitmap> categoryItems;   // 分类ID -> 可购买商品ID
+    TextIndex textPostings;                     // 名称/描述词项 -> 可购买商品ID
+    std::vector<std::vector<LengthGroupMember>> lengthMembers;   // 名称/描述字符数分组 -> 可购买商品
+    std::vector<int> lengthSlots;               // 商品ID -> 在所属长度分组中的下标，不在任何分组时为 -1
+    PriceIndex prices;                          // (价格, ID) -> 可购买商品
+    SuggestIndex suggestPhrases;                // 名称/分类名 -> 可购买商品数
+    ImageIndex imageHashes;                     // 图片差异哈希 -> 可购买商品
+    std::vector<unsigned long long> categoryStamps;   // 分类ID -> 版本号
+    std::vector<unsigned long long> textStamps;       // 字符桶 -> 版本号
+    unsigned long long version;
+    int tombstoneCount;
+    int soldCount;
+    int deletedCount;
+};
+#endif
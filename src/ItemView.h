@@ -0,0 +1,91 @@
+#ifndef ITEMVIEW_H
+#define ITEMVIEW_H
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <cstddef>
+#include "Item.h"
+
+// 查询结果视图：只保存指向商品的指针，不复制商品的字符串和图片。
+// 直接在 ItemStore 上得到的视图指向商品表中的商品，商品表之后发生修改（发布、购买、删除）时
+// 视图依然可以安全遍历，但其中商品的状态可能已不再满足查询条件；generation 记录生成视图时商品表的版本号。
+// TradingPlatform 返回的视图指向查询所在的那份副本，anchor 持有对它的登记（EpochReplicas::pin），
+// 视图和它的全部复制品释放之前这份副本不会被修改，看到的始终是查询时的商品表；
+// 持有期间写者会等待，所以视图用完应尽快释放，本线程在释放之前不能调用修改商品表的平台接口。
+// 由 of() 包装的 std::vector<Item> 视图只在该 vector 不被修改期间有效。
+// snapshot() 得到的快照视图指向自己持有的商品副本，不再登记副本，可以跨越写操作长期保存。
+// 在视图上筛选、排序得到的视图共享同一个 anchor。
+struct ItemView {
+    std::vector<const Item*> refs;
+    unsigned long long generation;
+    std::shared_ptr<const void> anchor;   // refs 所指商品的持有者：登记中的副本，或快照的商品副本
+
+    ItemView() : generation(0) {}
+
+    // 遍历时直接得到 const Item&
+    struct const_iterator {
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Item value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Item* pointer;
+        typedef const Item& reference;
+
+        std::vector<const Item*>::const_iterator it;
+
+        explicit const_iterator(std::vector<const Item*>::const_iterator i) : it(i) {}
+        reference operator*() const { return **it; }
+        pointer operator->() const { return *it; }
+        const_iterator& operator++() { ++it; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++it; return old; }
+        const_iterator& operator--() { --it; return *this; }
+        const_iterator& operator+=(difference_type n) { it += n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(it + n); }
+        difference_type operator-(const const_iterator& other) const { return it - other.it; }
+        reference operator[](difference_type n) const { return *it[n]; }
+        bool operator==(const const_iterator& other) const { return it == other.it; }
+        bool operator!=(const const_iterator& other) const { return it != other.it; }
+        bool operator<(const const_iterator& other) const { return it < other.it; }
+    };
+
+    const_iterator begin() const { return const_iterator(refs.begin()); }
+    const_iterator end() const { return const_iterator(refs.end()); }
+    size_t size() const { return refs.size(); }
+    bool empty() const { return refs.empty(); }
+    const Item& operator[](size_t i) const { return *refs[i]; }
+
+    // 只取商品ID
+    std::vector<int> ids() const {
+        std::vector<int> result;
+        result.reserve(refs.size());
+        for (const Item* item : refs) result.push_back(item->getItemId());
+        return result;
+    }
+
+    // 复制视图中的商品，返回指向副本的快照视图；复制快照视图只复制指针，副本由它们共享
+    ItemView snapshot() const {
+        std::shared_ptr<std::vector<Item>> copies = std::make_shared<std::vector<Item>>(toItems());
+        ItemView view;
+        view.generation = generation;
+        view.refs.reserve(copies->size());
+        for (const Item& item : *copies) view.refs.push_back(&item);
+        view.anchor = copies;
+        return view;
+    }
+
+    // 兼容旧接口：复制出 std::vector<Item>
+    std::vector<Item> toItems() const {
+        std::vector<Item> result;
+        result.reserve(refs.size());
+        for (const Item* item : refs) result.push_back(*item);
+        return result;
+    }
+
+    // 把已有的 std::vector<Item> 包装成视图
+    static ItemView of(const std::vector<Item>& items) {
+        ItemView view;
+        view.refs.reserve(items.size());
+        for (const auto& item : items) view.refs.push_back(&item);
+        return view;
+    }
+};
+#endif
@@ -0,0 +1,21 @@
+#ifndef LOCKSTRIPES_H
+#define LOCKSTRIPES_H
+#include <mutex>
+#include <cstddef>
+
+// 按ID分片的一组互斥锁：同一个ID总落在同一把锁上，不同ID大多落在不同的锁上，
+// 既不必每个对象带一把锁，也不会让所有操作排在一把全局锁后面。
+// 每把锁独占一条缓存行，相邻分片的加锁解锁互不干扰。
+template <size_t N>
+struct LockStripes {
+    static_assert((N & (N - 1)) == 0, "N must be a power of two");
+
+    std::mutex& of(int id) const { return stripes[static_cast<size_t>(id) & (N - 1)].lock; }
+
+private:
+    struct alignas(64) Stripe {
+        mutable std::mutex lock;
+    };
+    Stripe stripes[N];
+};
+#endif
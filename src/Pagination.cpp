@@ -0,0 +1,175 @@
+#include "Pagination.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// 游标格式：排序方式(1字节) + 价格(8字节) + 商品ID(4字节) + 校验(1字节)，整体编码为十六进制
+static const int kCursorBytes = 14;
+static const char* kHexDigits = "0123456789abcdef";
+
+static unsigned char cursorChecksum(const unsigned char* bytes) {
+    unsigned char sum = 0x5a;
+    for (int i = 0; i < kCursorBytes - 1; ++i) {
+        sum = static_cast<unsigned char>((sum << 1 | sum >> 7) ^ bytes[i]);
+    }
+    return sum;
+}
+
+std::string encodeCursor(PageOrder order, const Item& last) {
+    unsigned char bytes[kCursorBytes];
+    double price = last.getPrice();
+    int32_t id = last.getItemId();
+    bytes[0] = static_cast<unsigned char>(order);
+    std::memcpy(bytes + 1, &price, sizeof(price));
+    std::memcpy(bytes + 9, &id, sizeof(id));
+    bytes[kCursorBytes - 1] = cursorChecksum(bytes);
+
+    std::string token;
+    token.reserve(kCursorBytes * 2);
+    for (unsigned char b : bytes) {
+        token.push_back(kHexDigits[b >> 4]);
+        token.push_back(kHexDigits[b & 0xf]);
+    }
+    return token;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+bool decodeCursor(const std::string& token, PageOrder order, PageCursor& cursor) {
+    if (token.size() != kCursorBytes * 2) return false;
+    unsigned char bytes[kCursorBytes];
+    for (int i = 0; i < kCursorBytes; ++i) {
+        int hi = hexValue(token[2 * i]);
+        int lo = hexValue(token[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        bytes[i] = static_cast<unsigned char>(hi << 4 | lo);
+    }
+    if (bytes[kCursorBytes - 1] != cursorChecksum(bytes) || bytes[0] != static_cast<unsigned char>(order)) {
+        return false;
+    }
+    int32_t id;
+    cursor.order = order;
+    std::memcpy(&cursor.price, bytes + 1, sizeof(cursor.price));
+    std::memcpy(&id, bytes + 9, sizeof(id));
+    // 游标总是指向一件真实的商品；伪造的越界ID会让按ID翻页的 itemId ± 1 溢出
+    if (id < 1 || id == INT32_MAX) return false;
+    cursor.itemId = id;
+    return true;
+}
+
+bool pageOrderFromSortBy(const std::string& sortBy, PageOrder& order) {
+    if (sortBy.empty() || sortBy == "oldest") order = ORDER_BY_ID;
+    else if (sortBy == "newest") order = ORDER_BY_NEWEST;
+    else if (sortBy == "price_asc") order = ORDER_BY_PRICE_ASC;
+    else if (sortBy == "price_desc") order = ORDER_BY_PRICE_DESC;
+    else return false;
+    return true;
+}
+
+bool pageOrderBefore(PageOrder order, const Item& a, const Item& b) {
+    switch (order) {
+        case ORDER_BY_NEWEST:
+            return a.getItemId() > b.getItemId();
+        case ORDER_BY_PRICE_ASC:
+            if (a.getPrice() != b.getPrice()) return a.getPrice() < b.getPrice();
+            return a.getItemId() < b.getItemId();
+        case ORDER_BY_PRICE_DESC:
+            if (a.getPrice() != b.getPrice()) return a.getPrice() > b.getPrice();
+            return a.getItemId() < b.getItemId();
+        case ORDER_BY_ID:
+        default:
+            return a.getItemId() < b.getItemId();
+    }
+}
+
+bool afterCursor(const PageCursor& cursor, const Item& item) {
+    switch (cursor.order) {
+        case ORDER_BY_NEWEST:
+            return item.getItemId() < cursor.itemId;
+        case ORDER_BY_PRICE_ASC:
+            if (item.getPrice() != cursor.price) return item.getPrice() > cursor.price;
+            return item.getItemId() > cursor.itemId;
+        case ORDER_BY_PRICE_DESC:
+            if (item.getPrice() != cursor.price) return item.getPrice() < cursor.price;
+            return item.getItemId() > cursor.itemId;
+        case ORDER_BY_ID:
+        default:
+            return item.getItemId() > cursor.itemId;
+    }
+}
+
+// heap 是以“排序最靠后”为堆顶的堆，满了之后只接收比堆顶靠前的商品
+void PageBuffer::offer(const Item* item) {
+    PageOrder ord = order;
+    auto before = [ord](const Item* a, const Item* b) { return pageOrderBefore(ord, *a, *b); };
+    if (heap.size() < capacity) {
+        heap.push_back(item);
+        std::push_heap(heap.begin(), heap.end(), before);
+    } else if (before(item, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), before);
+        heap.back() = item;
+        std::push_heap(heap.begin(), heap.end(), before);
+    }
+}
+
+void PageBuffer::drainSorted(std::vector<const Item*>& out) {
+    PageOrder ord = order;
+    std::sort_heap(heap.begin(), heap.end(),
+                   [ord](const Item* a, const Item* b) { return pageOrderBefore(ord, *a, *b); });
+    out.insert(out.end(), heap.begin(), heap.end());
+    heap.clear();
+}
+
+bool beginPage(const PageRequest& request, ItemPage& page, PageCursor& cursor) {
+    page.items.refs.clear();
+    page.nextCursor.clear();
+    if (request.pageSize <= 0) return false;
+
+    if (request.cursor.empty()) {
+        cursor.order = request.order;
+        cursor.itemId = request.order == ORDER_BY_NEWEST ? INT_MAX : 0;
+        cursor.price = request.order == ORDER_BY_PRICE_DESC ? HUGE_VAL : -HUGE_VAL;
+        return true;
+    }
+    return decodeCursor(request.cursor, request.order, cursor);
+}
+
+void finishPage(const PageRequest& request, ItemPage& page) {
+    std::vector<const Item*>& refs = page.items.refs;
+    if (refs.size() > static_cast<size_t>(request.pageSize)) {
+        refs.resize(request.pageSize);
+        page.nextCursor = encodeCursor(request.order, *refs.back());
+    }
+}
+
+bool fetchAllItemsPage(const ItemStore& store, const PageRequest& request, ItemPage& page) {
+    PageCursor cursor;
+    if (!beginPage(request, page, cursor)) return false;
+    page.items.generation = store.generation();
+
+    std::vector<const Item*>& refs = page.items.refs;
+    const size_t want = static_cast<size_t>(request.pageSize) + 1;
+    if (request.order == ORDER_BY_ID) {
+        // 商品ID连续，直接按ID取
+        for (int id = cursor.itemId + 1; id <= store.size() && refs.size() < want; ++id) {
+            refs.push_back(store.find(id));
+        }
+    } else if (request.order == ORDER_BY_NEWEST) {
+        for (int id = std::min(cursor.itemId - 1, store.size()); id >= 1 && refs.size() < want; --id) {
+            refs.push_back(store.find(id));
+        }
+    } else {
+        PageBuffer buffer(request.order, want);
+        for (const auto& item : store) {
+            if (afterCursor(cursor, item)) buffer.offer(&item);
+        }
+        buffer.drainSorted(refs);
+    }
+    finishPage(request, page);
+    return true;
+}
@@ -0,0 +1,109 @@
+#ifndef PAGINATION_H
+#define PAGINATION_H
+#include <string>
+#include <vector>
+#include <climits>
+#include <cmath>
+#include "Item.h"
+#include "ItemStore.h"
+#include "ItemView.h"
+
+// 分页排序方式，价格相同时按商品ID升序，保证顺序稳定
+enum PageOrder {
+    ORDER_BY_ID,          // 按ID升序（发布先后）
+    ORDER_BY_NEWEST,      // 最新发布在前
+    ORDER_BY_PRICE_ASC,
+    ORDER_BY_PRICE_DESC
+};
+
+struct PageRequest {
+    int pageSize;
+    PageOrder order;
+    std::string cursor;   // 上一页返回的 nextCursor，首页留空
+
+    PageRequest(int size = 10, PageOrder ord = ORDER_BY_ID, const std::string& cur = "")
+        : pageSize(size), order(ord), cursor(cur) {}
+};
+
+struct ItemPage {
+    ItemView items;
+    std::string nextCursor;   // 为空表示已经是最后一页
+
+    bool hasMore() const { return !nextCursor.empty(); }
+};
+
+// 游标解码后的内容：上一页最后一件商品的排序键
+struct PageCursor {
+    PageOrder order;
+    double price;
+    int itemId;
+};
+
+// 游标对调用方不透明，只能原样传回；游标与排序方式不符或被篡改时解码失败
+std::string encodeCursor(PageOrder order, const Item& last);
+bool decodeCursor(const std::string& token, PageOrder order, PageCursor& cursor);
+// sortBy 为空、"oldest"、"newest"、"price_asc" 或 "price_desc" 时给出对应的分页顺序；
+// 相关度、日期和多键排序无法编码进游标，返回 false
+bool pageOrderFromSortBy(const std::string& sortBy, PageOrder& order);
+
+// a 在该排序方式下是否排在 b 前面
+bool pageOrderBefore(PageOrder order, const Item& a, const Item& b);
+// item 是否排在游标之后
+bool afterCursor(const PageCursor& cursor, const Item& item);
+
+// 管理员视图按价格分页时的候选缓冲：只保留排序最靠前的 capacity 件商品
+struct PageBuffer {
+    PageOrder order;
+    size_t capacity;
+    std::vector<const Item*> heap;
+
+    PageBuffer(PageOrder ord, size_t cap) : order(ord), capacity(cap) {}
+    void offer(const Item* item);
+    void drainSorted(std::vector<const Item*>& out);
+};
+
+// 校验请求、解码游标并清空 page；首页游标取排序起点
+bool beginPage(const PageRequest& request, ItemPage& page, PageCursor& cursor);
+// 多取的一件用来判断是否还有下一页，截掉后生成 nextCursor
+void finishPage(const PageRequest& request, ItemPage& page);
+
+// 在可购买分区上按游标取一页满足 filter 的商品。
+// 按ID/最新排序时从游标位置二分定位后顺序读取，代价与页大小成正比；
+// 按价格排序时从价格索引中游标的位置开始顺序读取，同样不会经过之前的页。
+template <typename Filter>
+bool fetchAvailablePage(const ItemStore& store, const PageRequest& request, Filter filter, ItemPage& page) {
+    PageCursor cursor;
+    if (!beginPage(request, page, cursor)) return false;
+    page.items.generation = store.generation();
+
+    std::vector<const Item*>& refs = page.items.refs;
+    const size_t want = static_cast<size_t>(request.pageSize) + 1;
+    auto collect = [&refs, want, &filter](const Item& item) {
+        if (filter(item)) refs.push_back(&item);
+        return refs.size() < want;
+    };
+
+    if (request.order == ORDER_BY_ID) {
+        store.scanAvailableAfter(cursor.itemId, collect);
+    } else if (request.order == ORDER_BY_NEWEST) {
+        store.scanAvailableBefore(cursor.itemId, collect);
+    } else {
+        // 从游标价格处进入价格索引，跳过同价中已经返回过的商品
+        auto visit = [&store, &cursor, &collect](int id, double) {
+            const Item& item = *store.find(id);
+            return !afterCursor(cursor, item) || collect(item);
+        };
+        if (request.order == ORDER_BY_PRICE_ASC) {
+            store.priceIndex().scanAscending(cursor.price, HUGE_VAL, visit);
+        } else {
+            store.priceIndex().scanDescending(-HUGE_VAL, cursor.price, visit);
+        }
+    }
+    finishPage(request, page);
+    return true;
+}
+
+// 管理员视图：分页遍历全部商品（包含已售出/已删除）
+bool fetchAllItemsPage(const ItemStore& store, const PageRequest& request, ItemPage& page);
+
+#endif
@@ -1,18 +1,39 @@
 #include "Platform.h"
+#include "ItemOrder.h"
+#include "Utf8.h"
 #include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <ctime>
 #include <iomanip>
 
-TradingPlatform::TradingPlatform() : nextUserId(1), nextItemId(1) {
+typedef std::shared_lock<std::shared_timed_mutex> ReadLock;
+typedef std::unique_lock<std::shared_timed_mutex> WriteLock;
+typedef std::lock_guard<std::mutex> StripeGuard;
+typedef std::lock_guard<std::mutex> WriteGuard;
+
+// 邮箱规范化：去掉首尾空白并转为小写，作为 emailIndex 的键
+static std::string normalizeEmail(const std::string& email) {
+    size_t begin = 0;
+    size_t end = email.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(email[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(email[end - 1]))) --end;
+    std::string key = email.substr(begin, end - begin);
+    for (auto& c : key) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+TradingPlatform::TradingPlatform() : items(catalog.replica(0)), nextUserId(1), nextItemId(1) {
     registerUser("admin", "admin123", "admin@nju.edu.cn", "13921590994", "231240015", "系统管理员", "匡亚明学院", ADMIN);
 }
 
 bool TradingPlatform::registerUser(const std::string& username, const std::string& password, const std::string& email, const std::string& phone, const std::string& studentId, const std::string& realName, const std::string& college, UserRole role) {
-    for (const auto& user : users) {
-        if (user->getEmail() == email) {
-            return false;
-        }
+    std::string key = normalizeEmail(email);
+    WriteLock lock(userTableLock);
+    if (emailIndex.count(key)) {
+        return false;
     }
     std::shared_ptr<User> newUser;
     if (role == ADMIN) {
@@ -21,174 +42,530 @@ bool TradingPlatform::registerUser(const std::string& username, const std::strin
         newUser = std::make_shared<RegularUser>(nextUserId++, username, password, email, phone, studentId, realName, college);
     }
     users.push_back(newUser);
+    emailIndex[key] = newUser->getUserId();
     return true;
 }
 
-std::shared_ptr<User> TradingPlatform::login(const std::string& email, const std::string& password) {
-    for (auto& user : users) {
-        if (user->getEmail() == email && user->login(password)) {
-            return user;
+int TradingPlatform::login(const std::string& email, const std::string& password) {
+    std::shared_ptr<User> user;
+    {
+        ReadLock lock(userTableLock);
+        auto it = emailIndex.find(normalizeEmail(email));
+        if (it == emailIndex.end()) {
+            return 0;
         }
+        user = userAt(it->second);
     }
-    return nullptr;
+    if (!user) return 0;
+    StripeGuard guard(userLocks.of(user->getUserId()));
+    if (user->login(password)) {
+        return user->getUserId();
+    }
+    return 0;
+}
+
+std::string TradingPlatform::openSession(const std::string& email, const std::string& password) {
+    int userId = login(email, password);
+    return userId ? sessions.create(userId) : std::string();
+}
+
+int TradingPlatform::sessionUser(const std::string& token) {
+    return sessions.validate(token);
+}
+
+bool TradingPlatform::closeSession(const std::string& token) {
+    return sessions.revoke(token);
+}
+
+size_t TradingPlatform::expireSessions() {
+    return sessions.expire();
+}
+
+bool TradingPlatform::updateUserProfile(int userId, const std::string& phone, const std::string& email, const std::string& password) {
+    WriteLock lock(userTableLock);
+    auto user = userAt(userId);
+    if (!user) return false;
+    StripeGuard guard(userLocks.of(userId));
+
+    std::string oldKey = normalizeEmail(user->getEmail());
+    std::string newKey = normalizeEmail(email);
+    if (newKey != oldKey) {
+        auto it = emailIndex.find(newKey);
+        if (it != emailIndex.end() && it->second != userId) {
+            return false;
+        }
+        emailIndex.erase(oldKey);
+        emailIndex[newKey] = userId;
+    }
+    user->updateProfile(phone, email, password);
+    return true;
 }
 
 int TradingPlatform::publishItem(const std::string& name, const std::string& description, const std::string& category, double price, int sellerId) {
-    Item newItem(nextItemId++, name, description, category, price, sellerId);
-    items.push_back(newItem);
-    auto user = std::dynamic_pointer_cast<RegularUser>(findUserById(sellerId));
+    return publishItem(name, description, category, price, sellerId, std::vector<std::string>());
+}
+
+int TradingPlatform::publishItem(const std::string& name, const std::string& description, const std::string& category, double price, int sellerId,
+                                 const std::vector<std::string>& images) {
+    // 构造商品、读图计算哈希都在锁外完成，写锁只用来分配ID并写入两份副本
+    Item item(0, name, description, category, price, sellerId);
+    for (const std::string& path : images) {
+        uint64_t hash;
+        if (!hashImageFile(path, hash)) return -1;
+        item.images.push_back(path);
+        item.imageHashes.push_back(hash);
+    }
+    {
+        WriteGuard guard(catalogWriteLock);
+        item.itemId = nextItemId;
+        // 先登记状态字：读者在副本中看到新商品时一定查得到它的状态；
+        // 这期间抢到它的买家要等本次写入结束才能取得写锁，把状态变化应用到副本
+        if (!claims.append(item.itemId, item.getStatus())) return -1;
+        catalog.write([&item](ItemStore& replica) { replica.add(item); });
+        ++nextItemId;
+    }
+    auto user = std::dynamic_pointer_cast<RegularUser>(liveUser(sellerId));
+    if (user) {
+        StripeGuard guard(userLocks.of(sellerId));
+        user->publishItem(item);
+    }
+    return item.getItemId();
+}
+
+// 已在 claims 中决出的状态变化应用到两份副本，把商品移出热分区和索引；一批商品只切换一次副本
+void TradingPlatform::retireItems(const std::vector<int>& itemIds, ItemStatus status) {
+    WriteGuard guard(catalogWriteLock);
+    catalog.write([&itemIds, status](ItemStore& replica) { replica.setStatusBatch(itemIds, status); });
+}
+
+// 整批只取一次日期、一次写锁、一次副本切换，卖家只查找一次
+std::vector<int> TradingPlatform::publishItems(const std::vector<ItemDraft>& drafts, int sellerId) {
+    std::vector<Item> batch;
+    batch.reserve(drafts.size());
+    std::string today = Item::today();
+    for (const ItemDraft& draft : drafts) {
+        batch.emplace_back(0, draft.name, draft.description, draft.category, draft.price, sellerId, today);
+        for (const std::string& path : draft.images) {
+            uint64_t hash;
+            if (!hashImageFile(path, hash)) return std::vector<int>();
+            batch.back().images.push_back(path);
+            batch.back().imageHashes.push_back(hash);
+        }
+    }
+    std::vector<int> ids;
+    if (batch.empty()) return ids;
+    ids.reserve(batch.size());
+    {
+        WriteGuard guard(catalogWriteLock);
+        // 先确认整批都能登记，否则中途失败时前面的商品已登记而 nextItemId 未前进，之后的发布全部失败
+        if (batch.size() > static_cast<size_t>(ItemClaims::kCapacity - claims.size())) return ids;
+        for (Item& item : batch) {
+            item.itemId = nextItemId + static_cast<int>(ids.size());
+            if (!claims.append(item.itemId, item.getStatus())) return std::vector<int>();
+            ids.push_back(item.itemId);
+        }
+        catalog.write([&batch](ItemStore& replica) { replica.addBatch(batch); });
+        nextItemId += static_cast<int>(batch.size());
+    }
+    auto user = std::dynamic_pointer_cast<RegularUser>(liveUser(sellerId));
     if (user) {
-        user->publishItem(newItem);
+        StripeGuard guard(userLocks.of(sellerId));
+        user->publishedItems.insert(user->publishedItems.end(), ids.begin(), ids.end());
+    }
+    return ids;
+}
+
+int TradingPlatform::setStatusBatch(const std::vector<int>& itemIds, ItemStatus status, int requesterId) {
+    auto requester = liveUser(requesterId);
+    if (!requester || status == AVAILABLE) return 0;
+    bool admin = requester->getRole() == ADMIN;
+    std::vector<int> allowed = catalog.read([&itemIds, requesterId, admin](const ItemStore& replica) {
+        std::vector<int> result;
+        result.reserve(itemIds.size());
+        for (int itemId : itemIds) {
+            const Item* item = replica.find(itemId);
+            if (item && (admin || item->getSellerId() == requesterId)) result.push_back(itemId);
+        }
+        return result;
+    });
+    std::vector<int> changed;
+    changed.reserve(allowed.size());
+    for (int itemId : allowed) {
+        if (claims.claim(itemId, status)) changed.push_back(itemId);
     }
-    return newItem.getItemId();
+    if (!changed.empty()) retireItems(changed, status);
+    return static_cast<int>(changed.size());
 }
 
 bool TradingPlatform::deleteItem(int itemId, int requesterId) {
-    auto requester = findUserById(requesterId);
+    auto requester = liveUser(requesterId);
     if (!requester) return false;
-    
-    auto itemIt = std::find_if(items.begin(), items.end(), [itemId](const Item& item) { 
-        return item.getItemId() == itemId; 
+    int sellerId = catalog.read([itemId](const ItemStore& replica) {
+        const Item* item = replica.find(itemId);
+        return item ? item->getSellerId() : 0;
     });
-    
-    if (itemIt != items.end()) {
-        if (requester->getRole() == ADMIN || itemIt->getSellerId() == requesterId) {
-            itemIt->setStatus(DELETED);
-            return true;
-        }
+    if (!sellerId || (requester->getRole() != ADMIN && sellerId != requesterId)) return false;
+    if (!claims.claim(itemId, DELETED)) return false;
+    retireItems(std::vector<int>(1, itemId), DELETED);
+    return true;
+}
+
+bool TradingPlatform::updateItem(int itemId, int requesterId, const std::string& name, const std::string& description, const std::string& category, double price) {
+    auto requester = liveUser(requesterId);
+    if (!requester) return false;
+    int sellerId = catalog.read([itemId](const ItemStore& replica) {
+        const Item* item = replica.find(itemId);
+        return item ? item->getSellerId() : 0;
+    });
+    if (!sellerId || (requester->getRole() != ADMIN && sellerId != requesterId)) return false;
+    // 商品可能刚被买走或删除，写锁内再看一次状态字
+    WriteGuard guard(catalogWriteLock);
+    if (claims.status(itemId) != AVAILABLE) return false;
+    bool updated = true;
+    catalog.write([&](ItemStore& replica) {
+        updated = replica.updateInfo(itemId, name, description, category, price) && updated;
+    });
+    return updated;
+}
+
+//字符串匹配搜索：先从文本索引取候选商品再核对名称，关键词无法走索引时扫描可购买分区
+// 先查缓存，未命中时执行 run 填写 page 并缓存结果；run 返回 false（如游标非法）时不缓存。
+// 调用方已登记在 items 所在的副本上；缓存锁只在查找和写入时持有，执行查询期间不占用
+template <typename Run>
+static bool cachedQuery(SearchCache& cache, std::mutex& cacheLock, const ItemStore& items, const char* kind,
+                        const SearchCriteria& criteria, ItemPage& page, Run run) {
+    std::string key = SearchCache::key(kind, criteria);
+    {
+        std::lock_guard<std::mutex> guard(cacheLock);
+        if (cache.lookup(key, items, page)) return true;
     }
-    return false;
+    if (!run(page)) return false;
+    // 近似匹配的商品不一定含有关键词的字符，不能按关键词的字符桶判断失效；
+    // 相关度得分取决于全表的商品数、平均字段长度和文档频率，其他分类或不相关的商品发布也会改变顺序，
+    // 这两种情况都只按商品表版本号判断
+    ItemOrder order(criteria.sortBy);
+    bool byRelevance = !criteria.keyword.empty() && !order.empty() && order.keys[0] == KEY_RELEVANCE;
+    std::lock_guard<std::mutex> guard(cacheLock);
+    cache.insert(key, items, byRelevance ? std::string() : criteria.category,
+                 byRelevance || criteria.maxDistance > 0 ? std::string() : criteria.keyword, page);
+    return true;
 }
 
-//字符串匹配搜索
-std::vector<Item> TradingPlatform::searchItemsByName(const std::string& keyword) const {
-    std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.isAvailable() && item.getItemName().find(keyword) != std::string::npos) {
-            result.push_back(item);
-        }
+// 登记到当前有效的副本上执行 query，返回的视图持有这次登记，直接指向副本中的商品，不复制
+template <typename Query>
+static ItemView pinnedView(const EpochReplicas<ItemStore>& catalog, Query query) {
+    std::shared_ptr<const ItemStore> replica = catalog.pin();
+    ItemView view = query(*replica);
+    view.anchor = replica;
+    return view;
+}
+
+// 同上，结果是一页；失败时 page 中不留登记
+template <typename Fetch>
+static bool pinnedPage(const EpochReplicas<ItemStore>& catalog, ItemPage& page, Fetch fetch) {
+    std::shared_ptr<const ItemStore> replica = catalog.pin();
+    if (!fetch(*replica)) {
+        page.items.anchor.reset();
+        return false;
     }
-    return result;
+    page.items.anchor = replica;
+    return true;
 }
 
-std::vector<Item> TradingPlatform::searchItemsByCategory(const std::string& category) const {
-    std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.isAvailable() && item.getCategory() == category) {
-            result.push_back(item);
+ItemView TradingPlatform::viewItemsByName(const std::string& keyword) const {
+    return pinnedView(catalog, [&](const ItemStore& replica) { return itemsByName(replica, keyword); });
+}
+
+ItemView TradingPlatform::itemsByName(const ItemStore& items, const std::string& keyword) const {
+    SearchCriteria criteria;
+    criteria.setKeyword(keyword);
+    ItemPage page;
+    cachedQuery(searchCache, cacheLock, items, "name", criteria, page, [&items, &keyword](ItemPage& out) {
+        ItemView& result = out.items;
+        result.generation = items.generation();
+        if (!isValidUtf8(keyword)) return true;
+
+        RoaringBitmap candidates;
+        if (items.textIndex().candidates(keyword, candidates)) {
+            candidates.forEach([&items, &result, &keyword](uint32_t id) {
+                const Item* item = items.find(static_cast<int>(id));
+                if (item->getItemName().find(keyword) != std::string::npos) {
+                    result.refs.push_back(item);
+                }
+            });
+            return true;
+        }
+        for (const auto& item : items.available()) {
+            if (item.getItemName().find(keyword) != std::string::npos) {
+                result.refs.push_back(&item);
+            }
         }
+        return true;
+    });
+    return page.items;
+}
+
+ItemView TradingPlatform::viewItemsByCategory(const std::string& category) const {
+    return pinnedView(catalog, [&](const ItemStore& replica) { return itemsByCategory(replica, category); });
+}
+
+ItemView TradingPlatform::itemsByCategory(const ItemStore& items, const std::string& category) const {
+    SearchCriteria criteria;
+    criteria.setCategory(category);
+    ItemPage page;
+    cachedQuery(searchCache, cacheLock, items, "category", criteria, page, [&items, &category](ItemPage& out) {
+        ItemView& result = out.items;
+        result.generation = items.generation();
+        const RoaringBitmap* postings = items.categoryBitmap(category);
+        if (!postings) return true;
+        result.refs.reserve(postings->cardinality());
+        postings->forEach([&items, &result](uint32_t id) {
+            result.refs.push_back(items.find(static_cast<int>(id)));
+        });
+        return true;
+    });
+    return page.items;
+}
+
+ItemView TradingPlatform::viewSearchResults(const SearchCriteria& criteria) const {
+    return pinnedView(catalog, [&](const ItemStore& replica) { return searchResults(replica, criteria); });
+}
+
+ItemView TradingPlatform::searchResults(const ItemStore& items, const SearchCriteria& criteria) const {
+    ItemPage page;
+    cachedQuery(searchCache, cacheLock, items, "select", criteria, page, [&items, &criteria](ItemPage& out) {
+        out.items = criteria.select(items);
+        return true;
+    });
+    return page.items;
+}
+
+ItemView TradingPlatform::viewAvailableItems() const {
+    return pinnedView(catalog, availableItems);
+}
+
+ItemView TradingPlatform::availableItems(const ItemStore& items) {
+    ItemView result;
+    result.generation = items.generation();
+    result.refs.reserve(items.liveCount());
+    for (const auto& item : items.available()) {
+        result.refs.push_back(&item);
     }
     return result;
 }
 
-std::vector<Item> TradingPlatform::getAvailableItems() const {
-    std::vector<Item> result;
+ItemView TradingPlatform::viewAllItems() const {
+    return pinnedView(catalog, allItems);
+}
+
+ItemView TradingPlatform::allItems(const ItemStore& items) {
+    ItemView result;
+    result.generation = items.generation();
+    result.refs.reserve(items.size());
     for (const auto& item : items) {
-        if (item.isAvailable()) {
-            result.push_back(item);
-        }
+        result.refs.push_back(&item);
     }
     return result;
 }
 
+bool TradingPlatform::browseItems(const PageRequest& request, ItemPage& page) const {
+    return pinnedPage(catalog, page, [&](const ItemStore& replica) {
+        return fetchAvailablePage(replica, request, [](const Item&) { return true; }, page);
+    });
+}
+
+bool TradingPlatform::browseAllItems(const PageRequest& request, ItemPage& page) const {
+    return pinnedPage(catalog, page, [&](const ItemStore& replica) { return fetchAllItemsPage(replica, request, page); });
+}
+
+bool TradingPlatform::searchItems(const SearchCriteria& criteria, ItemPage& page) const {
+    return pinnedPage(catalog, page, [&](const ItemStore& replica) {
+        return cachedQuery(searchCache, cacheLock, replica, "page", criteria, page,
+                           [&replica, &criteria](ItemPage& out) { return criteria.selectPage(replica, out); });
+    });
+}
+
+ItemView TradingPlatform::searchByImage(const std::string& imagePath, size_t limit, int maxDistance) const {
+    uint64_t hash;
+    if (!hashImageFile(imagePath, hash)) return ItemView();
+    return pinnedView(catalog, [&](const ItemStore& replica) {
+        return SearchEngine::imageSearch(replica, hash, limit, maxDistance);
+    });
+}
+
+std::vector<Suggestion> TradingPlatform::suggest(const std::string& prefix, size_t limit) const {
+    return catalog.read([&](const ItemStore& replica) { return replica.suggestions().complete(prefix, limit); });
+}
+
+std::vector<Item> TradingPlatform::searchItemsByName(const std::string& keyword) const {
+    return catalog.read([&](const ItemStore& replica) { return itemsByName(replica, keyword).toItems(); });
+}
+
+std::vector<Item> TradingPlatform::searchItemsByCategory(const std::string& category) const {
+    return catalog.read([&](const ItemStore& replica) { return itemsByCategory(replica, category).toItems(); });
+}
+
+std::vector<Item> TradingPlatform::getAvailableItems() const {
+    return catalog.read([](const ItemStore& replica) { return availableItems(replica).toItems(); });
+}
+
 std::vector<Item> TradingPlatform::getAllItems() const {
-    return items;
+    return catalog.read([](const ItemStore& replica) { return allItems(replica).toItems(); });
 }
 
 int TradingPlatform::getUserCount() const {
+    ReadLock lock(userTableLock);
     return users.size();
 }
 
 int TradingPlatform::getItemCount() const {
-    return items.size();
+    return catalog.read([](const ItemStore& replica) { return replica.size(); });
+}
+
+CatalogStats TradingPlatform::getCatalogStats() const {
+    return catalog.read([](const ItemStore& replica) { return replica.stats(); });
+}
+
+SearchCacheStats TradingPlatform::getSearchCacheStats() const {
+    std::lock_guard<std::mutex> guard(cacheLock);
+    return searchCache.stats();
+}
+
+void TradingPlatform::setSuggestCapacity(size_t capacity) {
+    WriteGuard guard(catalogWriteLock);
+    catalog.write([capacity](ItemStore& replica) { replica.suggestions().setCapacity(capacity); });
 }
 
+int TradingPlatform::compactCatalog() {
+    WriteGuard guard(catalogWriteLock);
+    int removed = 0;
+    catalog.write([&removed](ItemStore& replica) { removed = replica.compact(); });
+    return removed;
+}
+
+// 抢购靠 claims 中状态字的一次比较交换决出唯一的买家，不加任何锁，买家之间不互相等待；
+// 没抢到的直接返回，抢到的先记下购买记录，再取写锁把商品移出两份副本的索引
 bool TradingPlatform::purchaseItem(int itemId, int buyerId) {
-    auto itemIt = std::find_if(items.begin(), items.end(), [itemId](const Item& item) { 
-        return item.getItemId() == itemId && item.isAvailable(); 
-    });
-    
-    if (itemIt != items.end()) {
-        itemIt->setStatus(SOLD);
-        auto buyer = std::dynamic_pointer_cast<RegularUser>(findUserById(buyerId));
-        if (buyer) {
-            buyer->addPurchasedItem(itemId);
-        }
-        return true;
+    if (!claims.claim(itemId, SOLD)) return false;
+    auto buyer = std::dynamic_pointer_cast<RegularUser>(liveUser(buyerId));
+    if (buyer) {
+        StripeGuard userGuard(userLocks.of(buyerId));
+        buyer->addPurchasedItem(itemId);
     }
-    return false;
+    retireItems(std::vector<int>(1, itemId), SOLD);
+    return true;
 }
 
-bool TradingPlatform::addToCart(int itemId, int userId) {
-    auto user = findUserById(userId);
-    auto itemIt = std::find_if(items.begin(), items.end(), [itemId](const Item& item) { 
-        return item.getItemId() == itemId; 
-    });
-    
-    if (user && itemIt != items.end() && itemIt->isAvailable()) {
-        auto regularUser = std::dynamic_pointer_cast<RegularUser>(user);
-        if (regularUser) {
-            regularUser->addToCart(itemId);
-            return true;
+bool TradingPlatform::checkout(int userId) {
+    std::vector<int> unavailable;
+    return checkout(userId, unavailable);
+}
+
+// 持用户分片锁期间购物车不会变化；预留按商品ID升序进行，同时结账的买家不会互相撤销到都买不成
+bool TradingPlatform::checkout(int userId, std::vector<int>& unavailable) {
+    unavailable.clear();
+    auto buyer = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!buyer) return false;
+    std::vector<int> itemIds;
+    {
+        StripeGuard guard(userLocks.of(userId));
+        itemIds = buyer->cartItems;
+        std::sort(itemIds.begin(), itemIds.end());
+        itemIds.erase(std::unique(itemIds.begin(), itemIds.end()), itemIds.end());
+        if (itemIds.empty()) return false;
+        size_t conflict;
+        if (!claims.claimAll(itemIds, SOLD, conflict)) {
+            for (size_t i = 0; i < itemIds.size(); ++i) {
+                if (i == conflict || claims.status(itemIds[i]) != AVAILABLE) unavailable.push_back(itemIds[i]);
+            }
+            return false;
         }
+        buyer->purchasedItems.insert(buyer->purchasedItems.end(), itemIds.begin(), itemIds.end());
+        buyer->cartItems.clear();
     }
-    return false;
+    retireItems(itemIds, SOLD);
+    return true;
+}
+
+bool TradingPlatform::addToCart(int itemId, int userId) {
+    auto regularUser = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!regularUser) return false;
+    StripeGuard guard(userLocks.of(userId));
+    if (claims.status(itemId) != AVAILABLE) return false;
+    regularUser->addToCart(itemId);
+    return true;
 }
 
 bool TradingPlatform::removeFromCart(int itemId, int userId) {
-    auto user = findUserById(userId);
-    if (user) {
-        auto regularUser = std::dynamic_pointer_cast<RegularUser>(user);
-        if (regularUser) {
-            regularUser->removeFromCart(itemId);
-            return true;
-        }
-    }
-    return false;
+    auto regularUser = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!regularUser) return false;
+    StripeGuard guard(userLocks.of(userId));
+    regularUser->removeFromCart(itemId);
+    return true;
 }
 
 bool TradingPlatform::addToFavorites(int itemId, int userId) {
-    auto user = findUserById(userId);
-    auto itemIt = std::find_if(items.begin(), items.end(), [itemId](const Item& item) { 
-        return item.getItemId() == itemId; 
-    });
-    
-    if (user && itemIt != items.end() && itemIt->isAvailable()) {
-        auto regularUser = std::dynamic_pointer_cast<RegularUser>(user);
-        if (regularUser) {
-            regularUser->addToFavorites(itemId);
-            return true;
-        }
-    }
-    return false;
+    auto regularUser = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!regularUser) return false;
+    StripeGuard guard(userLocks.of(userId));
+    if (claims.status(itemId) != AVAILABLE) return false;
+    regularUser->addToFavorites(itemId);
+    return true;
 }
 
 bool TradingPlatform::removeFromFavorites(int itemId, int userId) {
-    auto user = findUserById(userId);
-    if (user) {
-        auto regularUser = std::dynamic_pointer_cast<RegularUser>(user);
-        if (regularUser) {
-            regularUser->removeFromFavorites(itemId);
-            return true;
-        }
-    }
-    return false;
+    auto regularUser = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!regularUser) return false;
+    StripeGuard guard(userLocks.of(userId));
+    regularUser->removeFromFavorites(itemId);
+    return true;
 }
 
-std::shared_ptr<User> TradingPlatform::findUserById(int userId) const {
-    for (const auto& user : users) {
-        if (user->getUserId() == userId) {
-            return user;
-        }
+std::shared_ptr<const User> TradingPlatform::findUserById(int userId) const {
+    auto user = liveUser(userId);
+    if (!user) return nullptr;
+    StripeGuard guard(userLocks.of(userId));
+    return user->clone();
+}
+
+bool TradingPlatform::userRole(int userId, UserRole& role) const {
+    auto user = liveUser(userId);
+    if (!user) return false;
+    role = user->getRole();
+    return true;
+}
+
+std::shared_ptr<User> TradingPlatform::liveUser(int userId) const {
+    ReadLock lock(userTableLock);
+    return userAt(userId);
+}
+
+std::vector<int> TradingPlatform::listUserItems(int userId, UserItemList list) const {
+    auto regularUser = std::dynamic_pointer_cast<RegularUser>(liveUser(userId));
+    if (!regularUser) return std::vector<int>();
+    StripeGuard guard(userLocks.of(userId));
+    switch (list) {
+        case LIST_CART: return regularUser->cartItems;
+        case LIST_FAVORITES: return regularUser->favorites;
+        case LIST_PURCHASED: return regularUser->purchasedItems;
+        case LIST_PUBLISHED: return regularUser->publishedItems;
     }
-    return nullptr;
+    return std::vector<int>();
 }
 
-Item* TradingPlatform::findItemById(int itemId) {
-    for (auto& item : items) {
-        if (item.getItemId() == itemId) {
-            return &item;
-        }
+// 用户ID从1开始连续分配且用户不会被移除，users[id-1] 即为该用户
+std::shared_ptr<User> TradingPlatform::userAt(int userId) const {
+    if (userId < 1 || userId > static_cast<int>(users.size())) {
+        return nullptr;
     }
-    return nullptr;
-}
\ No newline at end of file
+    return users[userId - 1];
+}
+
+std::shared_ptr<const Item> TradingPlatform::findItemById(int itemId) const {
+    std::shared_ptr<Item> copy = catalog.read([itemId](const ItemStore& replica) {
+        const Item* item = replica.find(itemId);
+        return item ? std::make_shared<Item>(*item) : std::shared_ptr<Item>();
+    });
+    if (copy) copy->setStatus(claims.status(itemId));
+    return copy;
+}
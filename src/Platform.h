@@ -2,33 +2,166 @@
 #define PLATFORM_H
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 #include "User.h"
 #include "Item.h"
+#include "ItemStore.h"
+#include "ItemView.h"
+#include "Pagination.h"
+#include "SearchEngine.h"
+#include "SearchCache.h"
+#include "EpochReplicas.h"
+#include "ItemClaims.h"
+#include "ImageHash.h"
+#include "LockStripes.h"
+#include "SessionStore.h"
 
+// 批量发布中的一件商品
+struct ItemDraft {
+    std::string name;
+    std::string description;
+    std::string category;
+    double price;
+    std::vector<std::string> images;   // 同 publishItem 的 images
+};
+
+// 用户名下的商品ID列表
+enum UserItemList { LIST_CART, LIST_FAVORITES, LIST_PURCHASED, LIST_PUBLISHED };
+
+// 交易平台，全部接口可以从多个线程同时调用。
+// 商品表连同全部索引保存两份（EpochReplicas）：
+//   查询登记到当前有效的一份上执行，整个查询看到的是同一时刻的商品表，不加锁，也不会被发布、购买等写操作阻塞；
+//   写操作持 catalogWriteLock 串行执行，先改另一份再切换，等旧副本上的查询结束后在旧副本上重放。
+//   长时间的查询只会推迟写者重放旧副本，不会推迟其他查询；代价是商品表占两份内存，每次修改执行两遍。
+// 购买和删除先在 claims 中对商品的状态字做比较交换决出唯一的一方，成功后才取写锁更新副本，
+// 同一件商品不会被卖出两次，抢购失败的买家不加任何锁就返回。
+// 其余状态按锁保护，加锁顺序固定为 userTableLock -> userLocks -> catalogWriteLock -> cacheLock：
+//   userTableLock  用户表和邮箱索引：注册、修改邮箱持写锁，其余持读锁
+//   userLocks      按用户ID分片：单个用户的资料、购物车、收藏和购买、发布记录
+//   cacheLock      搜索结果缓存；缓存只记商品ID，两份副本共用，命中时从查询所在的副本取回商品
+//   sessions       会话令牌表自带分片锁，不与以上的锁嵌套
+// 视图和分页不复制商品：它们指向查询所在的副本并持有对它的登记（见 ItemView），释放前看到的始终是查询时的商品表，
+// 其他线程的修改要等它们释放才能在这份副本上完成。所以视图应尽快释放，本线程持有视图时不能调用修改商品表的接口
+// （发布、购买、删除、修改、结账等），需要跨越写操作保存结果时用 snapshot() 复制。
+// findItemById 返回商品副本，不受此限制。
+// 直接访问 items / users 等成员不加锁，只能在没有其他线程调用平台接口时使用；
+// items 是第 0 份副本，只能读取，修改要经过平台接口，否则两份副本不再一致。
 struct TradingPlatform {
-    std::vector<std::shared_ptr<User>> users;
-    std::vector<Item> items;
+    static const size_t kLockStripes = 64;
+
+    std::vector<std::shared_ptr<User>> users;   // users[id-1] 即ID为 id 的用户
+    std::unordered_map<std::string, int> emailIndex; // 规范化邮箱 -> 用户ID
+    EpochReplicas<ItemStore> catalog;
+    ItemStore& items;                           // 第 0 份副本，按ID寻址，O(1) 查找
+    mutable SearchCache searchCache;            // 搜索结果缓存，按分类/关键词的版本号失效
+    ItemClaims claims;                          // 商品状态的权威记录
+    SessionStore sessions;                      // 登录令牌 -> 用户ID，自带分片锁
     int nextUserId;
     int nextItemId;
 
+    std::mutex catalogWriteLock;
+    mutable std::shared_timed_mutex userTableLock;
+    LockStripes<kLockStripes> userLocks;
+    mutable std::mutex cacheLock;
+
     TradingPlatform();
     bool registerUser(const std::string& username, const std::string& password, const std::string& email, const std::string& phone, const std::string& studentId, const std::string& realName, const std::string& college, UserRole role);
-    std::shared_ptr<User> login(const std::string& email, const std::string& password);
+    // 校验邮箱和密码，成功时返回用户ID，失败时返回 0；需要用户资料时再用 findUserById 取副本
+    int login(const std::string& email, const std::string& password);
+    // 校验密码后发放会话令牌，失败时返回空串；之后凭 sessionUser(令牌) 得到用户ID，不再比对密码。
+    // 令牌闲置超过 sessions.ttl() 秒即失效
+    std::string openSession(const std::string& email, const std::string& password);
+    // 令牌有效时返回用户ID并顺延有效期，否则返回 0
+    int sessionUser(const std::string& token);
+    bool closeSession(const std::string& token);
+    // 回收闲置过期的会话，返回回收的个数；由定时任务周期性调用
+    size_t expireSessions();
+    // 修改个人信息，邮箱会同步更新索引；新邮箱已被其他用户占用时返回 false 且不做任何修改
+    bool updateUserProfile(int userId, const std::string& phone, const std::string& email, const std::string& password);
     int publishItem(const std::string& name, const std::string& description, const std::string& category, double price, int sellerId);
+    // 带图片发布：images 为本地图片路径（二进制 PNM，见 ImageHash），发布时计算每张图片的差异哈希供按图搜索；
+    // 有图片无法读取时不发布，返回 -1
+    int publishItem(const std::string& name, const std::string& description, const std::string& category, double price, int sellerId,
+                    const std::vector<std::string>& images);
+    // 批量发布（社团跳蚤市场、毕业清仓）：整批分配一段连续ID、各索引整批更新一次，按 drafts 顺序返回新商品ID；
+    // 有图片无法读取时整批都不发布，返回空
+    std::vector<int> publishItems(const std::vector<ItemDraft>& drafts, int sellerId);
     bool deleteItem(int itemId, int requesterId);
+    // 批量把在售商品改为 SOLD（线下已售）或 DELETED，只处理 requester 是卖家（或管理员）且仍在售的商品，
+    // 一次写入更新索引，返回状态改变了的商品数
+    int setStatusBatch(const std::vector<int>& itemIds, ItemStatus status, int requesterId);
+    // 修改在售商品的信息，只有卖家本人或管理员可以修改；分类变化时同步分类位图
+    bool updateItem(int itemId, int requesterId, const std::string& name, const std::string& description, const std::string& category, double price);
+    // 查询返回登记着副本的视图，不复制商品，之后的修改不影响已返回的视图（写者等视图释放后才修改这份副本）。
+    // 按名称、分类、条件的查询和搜索分页都经过 searchCache
+    ItemView viewItemsByName(const std::string& keyword) const;
+    ItemView viewItemsByCategory(const std::string& category) const;
+    ItemView viewSearchResults(const SearchCriteria& criteria) const;
+    ItemView viewAvailableItems() const;
+    ItemView viewAllItems() const;
+    // 游标分页：在售商品 / 全部商品（管理员） / 搜索结果，游标非法时返回 false；页中的视图同样登记着副本
+    bool browseItems(const PageRequest& request, ItemPage& page) const;
+    bool browseAllItems(const PageRequest& request, ItemPage& page) const;
+    bool searchItems(const SearchCriteria& criteria, ItemPage& page) const;
+    // 输入补全：以 prefix 开头的在售商品名称和分类名，按在售件数从多到少取前 limit 条
+    std::vector<Suggestion> suggest(const std::string& prefix, size_t limit = 10) const;
+    // 按图搜索：与 imagePath 中的图片最相似的在售商品，按差异哈希的汉明距离从近到远取前 limit 件，
+    // 距离超过 maxDistance 的不算相似；图片无法读取时返回空视图
+    ItemView searchByImage(const std::string& imagePath, size_t limit = 10, int maxDistance = kSimilarImageDistance) const;
+    // 兼容接口，复制查询结果
     std::vector<Item> searchItemsByName(const std::string& keyword) const;
     std::vector<Item> searchItemsByCategory(const std::string& category) const;
     std::vector<Item> getAvailableItems() const;
     std::vector<Item> getAllItems() const;
     int getUserCount() const;
     int getItemCount() const;
+    CatalogStats getCatalogStats() const;   // 可购买 / 已下架 / 墓碑 行数
+    int compactCatalog();                   // 立即压实热分区中的墓碑
+    SearchCacheStats getSearchCacheStats() const;   // 命中 / 未命中 / 失效 / 淘汰次数
+    void setSuggestCapacity(size_t capacity);       // 见 SuggestIndex::setCapacity
     bool purchaseItem(int itemId, int buyerId);
+    // 结账：购物车中的商品全部买下或一件都不买。成功时全部记入购买记录并清空购物车；
+    // 有商品已售出、已删除或正被别人结账时返回 false，购物车不变，unavailable 为其中买不到的商品ID。
+    // 购物车为空时返回 false
+    bool checkout(int userId);
+    bool checkout(int userId, std::vector<int>& unavailable);
     bool addToCart(int itemId, int userId);
     bool removeFromCart(int itemId, int userId);
     bool addToFavorites(int itemId, int userId);
     bool removeFromFavorites(int itemId, int userId);
 
-    std::shared_ptr<User> findUserById(int userId) const;
-    Item* findItemById(int itemId);
+    // 用户的副本（包括购物车等列表），持该用户的分片锁复制，之后的修改与它无关；用户不存在时返回 nullptr
+    std::shared_ptr<const User> findUserById(int userId) const;
+    // 用户的角色，用户不存在时返回 false；角色注册后不再变化，不必复制整个用户
+    bool userRole(int userId, UserRole& role) const;
+    // 持该用户的分片锁复制一份列表，其他线程同时修改购物车等时也能安全读取；不是普通用户时返回空
+    std::vector<int> listUserItems(int userId, UserItemList list) const;
+    // 商品的副本，状态取自状态字（刚被买走、尚未移出索引的商品已显示为 SOLD），不存在时返回 nullptr
+    std::shared_ptr<const Item> findItemById(int itemId) const;
+    // 在当前有效的副本上以 const Item& 调用 visit，不复制商品；商品不存在时返回 false。visit 中不能再调用平台接口
+    template <typename Visit>
+    bool readItem(int itemId, Visit visit) const {
+        return catalog.read([itemId, &visit](const ItemStore& replica) {
+            const Item* item = replica.find(itemId);
+            if (!item) return false;
+            visit(*item);
+            return true;
+        });
+    }
+
+private:
+    // 以下在调用方已登记在 items 这份副本上时执行，返回指向该副本的视图
+    ItemView itemsByName(const ItemStore& items, const std::string& keyword) const;
+    ItemView itemsByCategory(const ItemStore& items, const std::string& category) const;
+    ItemView searchResults(const ItemStore& items, const SearchCriteria& criteria) const;
+    static ItemView availableItems(const ItemStore& items);
+    static ItemView allItems(const ItemStore& items);
+    std::shared_ptr<User> userAt(int userId) const;
+    // 平台中的用户本身，读写其资料和列表要持 userLocks.of(userId)
+    std::shared_ptr<User> liveUser(int userId) const;
+    void retireItems(const std::vector<int>& itemIds, ItemStatus status);
 };
 #endif
\ No newline at end of file
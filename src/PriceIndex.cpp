@@ -0,0 +1,109 @@
+#include "PriceIndex.h"
+#include <cmath>
+
+// 缓冲上限取主数组大小的平方根量级：插入时在缓冲内搬动的条目数和归并的摊还代价大致相当
+static const size_t kMinDeltaEntries = 1024;
+// 墓碑超过该下限且占到主数组一半时归并
+static const size_t kMinTombstonesToCompact = 1024;
+
+size_t PriceIndex::deltaLimit() const {
+    size_t limit = 2 * static_cast<size_t>(std::sqrt(static_cast<double>(runs.size())));
+    return std::max(limit, kMinDeltaEntries);
+}
+
+void PriceIndex::insert(double price, int itemId) {
+    Entry entry{price, itemId};
+    delta.insert(std::upper_bound(delta.begin(), delta.end(), entry, entryLess), entry);
+    if (delta.size() >= deltaLimit()) compact();
+}
+
+void PriceIndex::insertBatch(std::vector<std::pair<double, int>> entries) {
+    if (entries.empty()) return;
+    std::sort(entries.begin(), entries.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+        return entryLess(Entry{a.first, a.second}, Entry{b.first, b.second});
+    });
+    size_t middle = delta.size();
+    delta.reserve(middle + entries.size());
+    for (const auto& e : entries) delta.push_back(Entry{e.first, e.second});
+    std::inplace_merge(delta.begin(), delta.begin() + middle, delta.end(), entryLess);
+    if (delta.size() >= deltaLimit()) compact();
+}
+
+bool PriceIndex::erase(double price, int itemId) {
+    if (!eraseEntry(price, itemId)) return false;
+    maybeCompact();
+    return true;
+}
+
+size_t PriceIndex::eraseBatch(const std::vector<std::pair<double, int>>& entries) {
+    size_t erased = 0;
+    for (const auto& e : entries) erased += eraseEntry(e.first, e.second);
+    maybeCompact();
+    return erased;
+}
+
+bool PriceIndex::eraseEntry(double price, int itemId) {
+    Entry key{price, itemId};
+    auto j = std::lower_bound(delta.begin(), delta.end(), key, entryLess);
+    if (j != delta.end() && j->itemId == itemId && j->price == price) {
+        delta.erase(j);
+        return true;
+    }
+    auto i = std::lower_bound(runs.begin(), runs.end(), key, entryLess);
+    if (i == runs.end() || i->itemId != itemId || i->price != price) return false;
+    i->itemId = -itemId;
+    ++tombstones;
+    return true;
+}
+
+void PriceIndex::maybeCompact() {
+    if (tombstones >= kMinTombstonesToCompact && tombstones * 2 >= runs.size()) compact();
+}
+
+void PriceIndex::clear() {
+    runs.clear();
+    delta.clear();
+    tombstones = 0;
+}
+
+void PriceIndex::compact() {
+    if (delta.empty() && tombstones == 0) return;
+    std::vector<Entry> merged;
+    merged.reserve(runs.size() - tombstones + delta.size());
+    auto i = runs.begin();
+    auto j = delta.begin();
+    while (i != runs.end() || j != delta.end()) {
+        if (i != runs.end() && i->itemId < 0) {
+            ++i;
+        } else if (j == delta.end() || (i != runs.end() && entryLess(*i, *j))) {
+            merged.push_back(*i++);
+        } else {
+            merged.push_back(*j++);
+        }
+    }
+    runs.swap(merged);
+    delta.clear();
+    tombstones = 0;
+}
+
+size_t PriceIndex::countInRange(double lo, double hi) const {
+    if (!(lo <= hi)) return 0;
+    auto count = [lo, hi](const std::vector<Entry>& entries) {
+        return static_cast<size_t>(std::upper_bound(entries.begin(), entries.end(), hi, priceAbove) -
+                                   std::lower_bound(entries.begin(), entries.end(), lo, priceBelow));
+    };
+    return count(runs) + count(delta);
+}
+
+bool PriceIndex::covers(double lo, double hi) const {
+    bool inside = true;
+    scanAscending(-HUGE_VAL, lo, [&inside, lo](int, double price) {
+        inside = price >= lo;
+        return false;
+    });
+    scanDescending(hi, HUGE_VAL, [&inside, hi](int, double price) {
+        inside = inside && price <= hi;
+        return false;
+    });
+    return inside;
+}
@@ -0,0 +1,97 @@
+#ifndef PRICEINDEX_H
+#define PRICEINDEX_H
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdlib>
+#include <cstddef>
+
+// 可购买商品按 (价格, 商品ID) 排序的有序索引，用于价格区间查询和按价格排序。
+// 主体是一个有序数组 runs，新插入的条目先放进同样有序的小缓冲 delta，
+// 缓冲满了再整体归并进 runs，避免每次发布都搬动整个数组。
+// 删除时 delta 中的条目直接移除，runs 中的条目留下墓碑（取负ID），归并时一并清除。
+// 区间扫描把 runs 和 delta 按序归并输出，同价的商品总是按ID升序。
+struct PriceIndex {
+    PriceIndex() : tombstones(0) {}
+
+    void insert(double price, int itemId);
+    // 批量插入 (价格, 商品ID)：整批排序后一次归并进缓冲，批量较大时直接归并进主数组
+    void insertBatch(std::vector<std::pair<double, int>> entries);
+    // 条目不存在时返回 false
+    bool erase(double price, int itemId);
+    // 批量删除，返回删除的条目数；整批删完后才检查是否需要归并
+    size_t eraseBatch(const std::vector<std::pair<double, int>>& entries);
+    void clear();
+    // 把缓冲归并进主数组并清除墓碑
+    void compact();
+
+    size_t size() const { return runs.size() - tombstones + delta.size(); }
+    // 价格在 [lo, hi] 内的条目数上界（可能包含尚未清除的墓碑），二分求得，用于估算查询代价
+    size_t countInRange(double lo, double hi) const;
+    // 全部条目的价格都在 [lo, hi] 内（索引为空时也成立），此时价格条件不必逐个检查
+    bool covers(double lo, double hi) const;
+    size_t memoryBytes() const { return (runs.capacity() + delta.capacity()) * sizeof(Entry); }
+
+    // 按价格升序访问 [lo, hi] 内的商品，visit(商品ID, 价格) 返回 false 时停止
+    template <typename Visit>
+    void scanAscending(double lo, double hi, Visit visit) const {
+        auto i = std::lower_bound(runs.begin(), runs.end(), lo, priceBelow);
+        auto j = std::lower_bound(delta.begin(), delta.end(), lo, priceBelow);
+        while (true) {
+            while (i != runs.end() && i->itemId < 0) ++i;
+            bool fromRuns = i != runs.end() && i->price <= hi;
+            bool fromDelta = j != delta.end() && j->price <= hi;
+            if (!fromRuns && !fromDelta) return;
+            const Entry& next = fromRuns && (!fromDelta || entryLess(*i, *j)) ? *i++ : *j++;
+            if (!visit(next.itemId, next.price)) return;
+        }
+    }
+
+    // 按价格降序访问 [lo, hi] 内的商品ID；同价的商品仍按ID升序，与分页和稳定排序的约定一致
+    template <typename Visit>
+    void scanDescending(double lo, double hi, Visit visit) const {
+        auto i = std::upper_bound(runs.begin(), runs.end(), hi, priceAbove);
+        auto j = std::upper_bound(delta.begin(), delta.end(), hi, priceAbove);
+        // 反向归并得到的是同价ID降序，先攒下一组同价商品再正序输出
+        std::vector<int> group;
+        double groupPrice = 0;
+        auto flush = [&group, &groupPrice, &visit]() {
+            for (size_t k = group.size(); k > 0; --k) {
+                if (!visit(group[k - 1], groupPrice)) return false;
+            }
+            group.clear();
+            return true;
+        };
+        while (true) {
+            while (i != runs.begin() && (i - 1)->itemId < 0) --i;
+            bool fromRuns = i != runs.begin() && (i - 1)->price >= lo;
+            bool fromDelta = j != delta.begin() && (j - 1)->price >= lo;
+            if (!fromRuns && !fromDelta) break;
+            const Entry& next = fromRuns && (!fromDelta || entryLess(*(j - 1), *(i - 1))) ? *--i : *--j;
+            if (!group.empty() && next.price != groupPrice && !flush()) return;
+            groupPrice = next.price;
+            group.push_back(next.itemId);
+        }
+        flush();
+    }
+
+private:
+    struct Entry {
+        double price;
+        int itemId;   // runs 中的墓碑为 -itemId
+    };
+    static bool priceBelow(const Entry& e, double price) { return e.price < price; }
+    static bool priceAbove(double price, const Entry& e) { return price < e.price; }
+    static bool entryLess(const Entry& a, const Entry& b) {
+        if (a.price != b.price) return a.price < b.price;
+        return std::abs(a.itemId) < std::abs(b.itemId);
+    }
+    size_t deltaLimit() const;
+    bool eraseEntry(double price, int itemId);
+    void maybeCompact();
+
+    std::vector<Entry> runs;    // 有序主数组
+    std::vector<Entry> delta;   // 有序插入缓冲
+    size_t tombstones;          // runs 中的墓碑数
+};
+#endif
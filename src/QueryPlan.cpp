@@ -0,0 +1,122 @@
+#include "QueryPlan.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+const char* accessPathName(AccessPath path) {
+    switch (path) {
+        case PATH_FILTER_KERNEL: return "filter_kernel";
+        case PATH_CANDIDATES: return "candidates";
+        case PATH_PRICE_RANGE: return "price_range";
+        case PATH_PRICE_ORDER: return "price_order";
+        case PATH_RELEVANCE: return "relevance";
+        default: return "?";
+    }
+}
+
+QueryPlan::QueryPlan()
+    : maxDistance(0), minPrice(0), maxPrice(0), offset(0), limit(0),
+      tableRows(0), liveRows(0), categoryRows(-1), keywordRows(-1), priceRows(0), candidateRows(-1),
+      estimatedRows(0), keywordRecheck(false), priceOrdered(false), relevanceOrdered(false), path(PATH_FILTER_KERNEL), threads(1),
+      executed(false), rowsExamined(0), rowsMatched(0), rowsReturned(0) {
+    std::fill(cost, cost + kAccessPaths, -1.0);
+}
+
+// 各路径的单位代价：逐个检查候选的价格列约 64；从价格索引取一个条目置位约 2，清零选择位图约每行 1/16；
+// 按价格顺序扫描时每个条目都要随机读商品（约 40），还要查候选位图时约 110；每件匹配的商品读取并核对约 40。
+// 非价格顺序的路径在按价格排序且不限数量时还要对全部匹配排序。
+// 按相关度排序时逐个候选只读列存算上界约 16，有数量限制时读原文计分的候选约为 K·ln(匹配数 / K)。
+void QueryPlan::choose() {
+    bool hasCandidates = candidateRows >= 0;
+    double selective = hasCandidates ? candidateRows : liveRows;
+    estimatedRows = liveRows > 0 ? selective * std::min(priceRows, liveRows) / liveRows : 0;
+    double accept = 40 * estimatedRows;
+    bool ordered = priceOrdered || relevanceOrdered;
+    double sorting = ordered && limit == 0 ? 20 * estimatedRows * std::log2(estimatedRows + 1) : 0;
+
+    std::fill(cost, cost + kAccessPaths, -1.0);
+    if (relevanceOrdered) {
+        double scored = estimatedRows;
+        double k = static_cast<double>(offset + limit);
+        if (limit > 0 && estimatedRows > k) scored = k * (1 + std::log(estimatedRows / k));
+        cost[PATH_RELEVANCE] = 16 * selective + 40 * scored + sorting;
+        path = PATH_RELEVANCE;
+        return;
+    }
+    cost[PATH_FILTER_KERNEL] = tableRows + accept + sorting;
+    if (hasCandidates) cost[PATH_CANDIDATES] = 64 * selective + accept + sorting;
+    cost[PATH_PRICE_RANGE] = tableRows / 16 + 2 * priceRows + accept + sorting;
+    if (priceOrdered) {
+        double visited = priceRows;
+        if (limit > 0 && selective > 0) {
+            // 扫到第 offset + limit 个匹配约需经过的条目数
+            visited = std::min(visited, (offset + limit) * (liveRows / selective + 1));
+        }
+        cost[PATH_PRICE_ORDER] = (hasCandidates ? 110 : 40) * visited;
+    }
+
+    path = PATH_FILTER_KERNEL;
+    for (int p = 0; p < kAccessPaths; ++p) {
+        if (cost[p] >= 0 && cost[p] < cost[path]) path = static_cast<AccessPath>(p);
+    }
+}
+
+// 一行条件说明：名称、估计行数、在所选路径中的作用
+static void describe(std::ostringstream& out, const std::string& name, double rows, const char* role) {
+    out << "  " << std::left << std::setw(28) << name << " est " << std::right << std::setw(10)
+        << static_cast<long long>(rows) << "  " << role << "\n";
+}
+
+std::string QueryPlan::explain() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(0);
+    out << "access: " << accessPathName(path) << "  cost " << cost[path] << "  (";
+    bool first = true;
+    for (int p = 0; p < kAccessPaths; ++p) {
+        if (cost[p] < 0) continue;
+        out << (first ? "" : ", ") << accessPathName(static_cast<AccessPath>(p)) << " " << cost[p];
+        first = false;
+    }
+    out << ")\n";
+    if (threads > 1) out << "parallel: " << threads << " threads over row morsels, work stealing\n";
+
+    bool drivenByPrice = path == PATH_PRICE_RANGE || path == PATH_PRICE_ORDER;
+    describe(out, "status = available", liveRows,
+             path == PATH_FILTER_KERNEL ? "drive: filter kernel" : "implied: indexes hold available items only");
+    if (categoryRows >= 0) {
+        describe(out, "category = " + category, categoryRows,
+                 path == PATH_CANDIDATES ? "drive: category bitmap" : "filter: category bitmap");
+    }
+    if (!keyword.empty()) {
+        std::string role;
+        if (keywordRows < 0) {
+            role = "filter: scan text (not indexable)";
+        } else {
+            role = path == PATH_CANDIDATES || path == PATH_RELEVANCE ? "drive: text index" : "filter: text index";
+            if (keywordRecheck) role += ", recheck text";
+        }
+        std::string condition = "keyword \"" + keyword + "\"";
+        if (maxDistance > 0) condition += " within " + std::to_string(maxDistance) + " edits";
+        describe(out, condition, keywordRows < 0 ? liveRows : keywordRows, role.c_str());
+    }
+    std::ostringstream range;
+    range << "price in [" << minPrice << ", " << maxPrice << "]";
+    describe(out, range.str(), priceRows,
+             drivenByPrice ? (path == PATH_PRICE_ORDER ? "drive: price index, ordered" : "drive: price index")
+                           : (path == PATH_FILTER_KERNEL ? "drive: filter kernel" : "filter: price column"));
+    if (!sortBy.empty() || limit > 0) {
+        out << "order: " << (sortBy.empty() ? "id" : sortBy);
+        if (limit > 0) out << "  offset " << offset << " limit " << limit;
+        if (path == PATH_PRICE_ORDER) out << "  (read in index order)";
+        if (path == PATH_RELEVANCE) out << "  (BM25F, candidates skipped by column score bounds)";
+        out << "\n";
+    }
+    out << "rows: estimated " << estimatedRows;
+    if (executed) {
+        out << ", examined " << rowsExamined << (path == PATH_RELEVANCE ? ", scored " : ", matched ") << rowsMatched
+            << ", returned " << rowsReturned;
+    }
+    out << "\n";
+    return out.str();
+}
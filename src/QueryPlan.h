@@ -0,0 +1,60 @@
+#ifndef QUERYPLAN_H
+#define QUERYPLAN_H
+#include <string>
+#include <cstddef>
+
+// SearchCriteria::select(商品表) 的访问路径，都只含可购买商品
+enum AccessPath {
+    PATH_FILTER_KERNEL,   // 列存过滤核一次性判断状态和价格，得到按行的选择位图
+    PATH_CANDIDATES,      // 从候选集（分类位图 / 文本索引）出发，逐个检查价格列
+    PATH_PRICE_RANGE,     // 从价格索引取出 [minPrice, maxPrice] 内的商品构成选择位图，代替过滤核
+    PATH_PRICE_ORDER,     // 按首个排序键的价格顺序扫描价格索引，结果已经有序，有数量限制时凑够即停
+    PATH_RELEVANCE,       // 首个排序键是相关度：遍历文本候选集按 BM25F 计分，用列存上界跳过排不进前 K 名的候选
+    kAccessPaths
+};
+
+const char* accessPathName(AccessPath path);
+
+// 查询计划：各条件的估计行数、各访问路径的估计代价和选中的路径，执行后再填入实际行数。
+// 估计行数取自各索引自身的统计：分类位图和文本候选集的基数、价格索引的区间计数、可购买商品数，
+// 多个条件按互相独立估计。代价单位约为过滤核处理一行的耗时，按 1M 商品粗略标定。
+struct QueryPlan {
+    // 条件，未指定的条件行数为 -1
+    std::string category;
+    std::string keyword;
+    int maxDistance;        // 关键词允许的编辑距离，0 为精确匹配
+    double minPrice;
+    double maxPrice;
+    std::string sortBy;
+    size_t offset;
+    size_t limit;
+
+    // 统计与估计
+    double tableRows;       // 商品表总行数（含已下架）
+    double liveRows;        // 可购买商品数，即状态条件的行数
+    double categoryRows;    // 分类位图基数
+    double keywordRows;     // 文本索引候选数；关键词无法走索引时为 -1，只能逐个核对
+    double priceRows;       // 价格索引中区间内的条目数
+    double candidateRows;   // 分类与关键词候选求交后的行数，两者都未指定时为 -1
+    double estimatedRows;   // 估计满足全部条件的行数
+    bool keywordRecheck;    // 需要读商品原文核对关键词
+    bool priceOrdered;      // 首个排序键是价格
+    bool relevanceOrdered;  // 首个排序键是相关度且关键词能走文本索引，只有 PATH_RELEVANCE 适用
+    double cost[kAccessPaths];   // 不适用的路径为 -1
+    AccessPath path;
+    int threads;            // 执行所用的线程数，只有全表扫描会大于 1
+
+    // 执行后的实际值，未执行时为 0
+    bool executed;
+    size_t rowsExamined;    // 逐个检查过的行（过滤核/价格索引选出的行、候选、价格索引条目）
+    size_t rowsMatched;     // 满足全部条件、送去排序截取的行（有数量限制时按价格或得分上界提前淘汰的不计）
+    size_t rowsReturned;    // 排序、截取后返回的行
+
+    QueryPlan();
+
+    // 根据已填好的统计估计匹配行数和各路径代价，选出代价最低的路径
+    void choose();
+    // 可读的计划说明，执行过的计划同时给出估计与实际行数
+    std::string explain() const;
+};
+#endif
@@ -0,0 +1,116 @@
+#ifndef RECORDTEXT_H
+#define RECORDTEXT_H
+#include <initializer_list>
+#include <cstdint>
+#include <cstring>
+#include "TextArena.h"
+
+// 一条记录的 N 个文本字段，首尾相接存放在一块连续内存里，第 i 个字段为 [ends[i-1], ends[i])。
+// 默认自己持有这块内存，整条记录只分配一次；放进 TextArena 后指向文本区，不再单独分配。
+// 复制出来的 RecordText 总是自己持有内存，不依赖原文本区的生命周期。
+template <int N>
+struct RecordText {
+    RecordText() : base(""), inArena(false) {
+        for (int i = 0; i < N; ++i) ends[i] = 0;
+    }
+    RecordText(std::initializer_list<TextRef> fields) : RecordText() { assign(fields); }
+    RecordText(const RecordText& other) : RecordText() { copyFrom(other, nullptr); }
+    // 把 other 的文本拷贝进 arena
+    RecordText(const RecordText& other, TextArena& arena) : RecordText() { copyFrom(other, &arena); }
+    RecordText(RecordText&& other) noexcept : RecordText() {
+        if (other.inArena) {
+            copyFrom(other, nullptr);
+        } else {
+            swapOwned(other);
+        }
+    }
+    RecordText& operator=(const RecordText& other) {
+        if (this != &other) copyFrom(other, nullptr);
+        return *this;
+    }
+    RecordText& operator=(RecordText&& other) noexcept {
+        if (this == &other) return *this;
+        if (other.inArena) {
+            copyFrom(other, nullptr);
+        } else {
+            release();
+            swapOwned(other);
+        }
+        return *this;
+    }
+    ~RecordText() { release(); }
+
+    TextRef field(int i) const {
+        uint32_t begin = i == 0 ? 0 : ends[i - 1];
+        return TextRef(base + begin, ends[i] - begin);
+    }
+
+    // 替换全部字段；arena 非空时新文本写入文本区，否则自己持有。
+    // fields 可以引用本记录当前的文本
+    void assign(std::initializer_list<TextRef> fields, TextArena* arena = nullptr) {
+        TextRef copy[N];
+        int n = 0;
+        for (const TextRef& f : fields) {
+            if (n < N) copy[n++] = f;
+        }
+        build(copy, arena);
+    }
+
+    // 把文本搬进 arena（已在别的文本区中的也会拷贝一份）
+    void moveTo(TextArena& arena) {
+        TextRef copy[N];
+        for (int i = 0; i < N; ++i) copy[i] = field(i);
+        build(copy, &arena);
+    }
+
+    size_t bytes() const { return ends[N - 1]; }
+    bool arenaBacked() const { return inArena; }
+
+private:
+    void copyFrom(const RecordText& other, TextArena* arena) {
+        TextRef copy[N];
+        for (int i = 0; i < N; ++i) copy[i] = other.field(i);
+        build(copy, arena);
+    }
+
+    // 先写好新内存再释放旧内存，fields 引用旧文本也没问题
+    void build(const TextRef* fields, TextArena* arena) {
+        size_t total = 0;
+        for (int i = 0; i < N; ++i) total += fields[i].size();
+        char* buffer = nullptr;
+        if (total > 0) {
+            buffer = arena ? arena->allocate(total) : new char[total];
+        }
+        uint32_t offset = 0;
+        uint32_t newEnds[N];
+        for (int i = 0; i < N; ++i) {
+            if (fields[i].size()) std::memcpy(buffer + offset, fields[i].data(), fields[i].size());
+            offset += static_cast<uint32_t>(fields[i].size());
+            newEnds[i] = offset;
+        }
+        release();
+        base = buffer ? buffer : "";
+        inArena = buffer && arena;
+        for (int i = 0; i < N; ++i) ends[i] = newEnds[i];
+    }
+
+    void release() {
+        if (!inArena && bytes() > 0) delete[] base;
+        base = "";
+        inArena = false;
+        for (int i = 0; i < N; ++i) ends[i] = 0;
+    }
+
+    void swapOwned(RecordText& other) {
+        base = other.base;
+        inArena = false;
+        for (int i = 0; i < N; ++i) ends[i] = other.ends[i];
+        other.base = "";
+        for (int i = 0; i < N; ++i) other.ends[i] = 0;
+    }
+
+    const char* base;
+    uint32_t ends[N];
+    bool inArena;
+};
+#endif
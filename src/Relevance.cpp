@@ -0,0 +1,143 @@
+#include "Relevance.h"
+#include <algorithm>
+#include <cmath>
+
+const double RelevanceRanker::kNameWeight = 3.0;
+const double RelevanceRanker::kDescWeight = 1.0;
+const double RelevanceRanker::kK1 = 1.2;
+const double RelevanceRanker::kB = 0.75;
+
+RelevanceRanker::RelevanceRanker(const ItemStore& s, const std::vector<QueryTerm>& queryTerms, const ItemOrder& r)
+    : store(s), columns(s.columnar()), rest(r), keep(0) {
+    TextStats stats = s.textIndex().stats();
+    averageName = stats.averageNameChars > 0 ? stats.averageNameChars : 1;
+    averageDesc = stats.averageDescChars > 0 ? stats.averageDescChars : 1;
+    double n = static_cast<double>(stats.documents);
+    for (const QueryTerm& q : queryTerms) {
+        Term term;
+        term.text = q.text;
+        term.latin = !q.text.empty() && static_cast<unsigned char>(q.text[0]) < 0x80;
+        term.signature = 0;
+        size_t pos = 0;
+        while (pos < q.text.size()) term.signature |= ItemColumns::signatureBit(decodeUtf8(q.text, pos));
+        term.inNames = q.nameDocuments > 0;
+        term.inDescs = q.descDocuments > 0;
+        double df = static_cast<double>(std::min(q.documents, stats.documents));
+        term.idf = std::log(1 + (n - df + 0.5) / (df + 0.5));
+        terms.push_back(term);
+    }
+}
+
+// 字段长度归一的倒数，字段越短权重越高；空字段按最有利的 1 / (1 - b) 计
+double RelevanceRanker::nameNorm(int chars) const {
+    return 1 / (1 - kB + kB * chars / averageName);
+}
+
+double RelevanceRanker::descNorm(int chars) const {
+    return 1 / (1 - kB + kB * chars / averageDesc);
+}
+
+// 词项在两个字段中的加权出现次数先合并再做一次饱和（BM25F），对出现情况单调不减，
+// 所以把“可能出现”当作出现算出的就是上界
+static double termScore(double idf, bool inName, bool inDesc, double nameWeight, double descWeight) {
+    double x = (inName ? nameWeight : 0) + (inDesc ? descWeight : 0);
+    return idf * x * (RelevanceRanker::kK1 + 1) / (RelevanceRanker::kK1 + x);
+}
+
+double RelevanceRanker::boundOf(uint64_t nameSignature, uint64_t descSignature, double nameWeight,
+                                double descWeight) const {
+    double sum = 0;
+    for (const Term& term : terms) {
+        sum += termScore(term.idf, term.inNames && (nameSignature & term.signature) == term.signature,
+                         term.inDescs && (descSignature & term.signature) == term.signature, nameWeight, descWeight);
+    }
+    return sum;
+}
+
+double RelevanceRanker::bound(int itemId) const {
+    const TextSummary& text = columns.text[itemId];
+    return boundOf(text.nameSignature, text.descSignature, kNameWeight * nameNorm(text.nameLength),
+                   kDescWeight * descNorm(text.descLength));
+}
+
+std::vector<RelevanceRanker::GroupBound> RelevanceRanker::groupOrder() {
+    const std::vector<std::vector<LengthGroupMember>>& groups = store.lengthGroups();
+    const int mask = (1 << ItemStore::kLengthClassBits) - 1;
+    std::vector<GroupBound> order;
+    groupUpper.assign(groups.size(), 0);
+    for (size_t k = 0; k < groups.size(); ++k) {
+        if (groups[k].empty()) continue;
+        // 组内字符数不少于组号（超过上限的组也是），按全部片段都出现计
+        GroupBound group;
+        group.lengthClass = static_cast<int>(k);
+        group.nameWeight = kNameWeight * nameNorm(group.lengthClass >> ItemStore::kLengthClassBits);
+        group.descWeight = kDescWeight * descNorm(group.lengthClass & mask);
+        group.upper = boundOf(~uint64_t(0), ~uint64_t(0), group.nameWeight, group.descWeight);
+        groupUpper[k] = group.upper;
+        order.push_back(group);
+    }
+    std::sort(order.begin(), order.end(),
+              [](const GroupBound& a, const GroupBound& b) { return a.upper > b.upper; });
+    return order;
+}
+
+static void lowerAscii(TextRef text, std::string& out) {
+    out.assign(text.data(), text.size());
+    for (char& c : out) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+}
+
+// 长度取列存中的字符数，与上界使用同一组权重，出现情况相同时得分与上界完全相等
+double RelevanceRanker::score(const Item& item) {
+    int itemId = item.getItemId();
+    lowerAscii(item.getItemName(), nameText);
+    lowerAscii(item.getDescription(), descText);
+    double nameWeight = kNameWeight * nameNorm(columns.text[itemId].nameLength);
+    double descWeight = kDescWeight * descNorm(columns.text[itemId].descLength);
+    double sum = 0;
+    for (const Term& term : terms) {
+        // 中文片段按原文查找；拉丁片段已是小写，在转小写后的文本中查找
+        bool inName, inDesc;
+        if (term.latin) {
+            inName = nameText.find(term.text) != std::string::npos;
+            inDesc = descText.find(term.text) != std::string::npos;
+        } else {
+            inName = item.getItemName().find(term.text) != std::string::npos;
+            inDesc = item.getDescription().find(term.text) != std::string::npos;
+        }
+        sum += termScore(term.idf, inName, inDesc, nameWeight, descWeight);
+    }
+    return sum;
+}
+
+bool RelevanceRanker::better(const Entry& a, const Entry& b) const {
+    if (a.score != b.score) return a.score > b.score;
+    if (rest.before(*a.item, *b.item)) return true;
+    if (rest.before(*b.item, *a.item)) return false;
+    return a.item->getItemId() < b.item->getItemId();
+}
+
+void RelevanceRanker::offer(double score, const Item* item) {
+    Entry entry{score, item};
+    auto cmp = [this](const Entry& a, const Entry& b) { return better(a, b); };
+    if (keep == 0 || heap.size() < keep) {
+        heap.push_back(entry);
+        if (keep > 0) std::push_heap(heap.begin(), heap.end(), cmp);
+    } else if (better(entry, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end(), cmp);
+    }
+}
+
+void RelevanceRanker::drain(std::vector<const Item*>& out, size_t offset) {
+    auto cmp = [this](const Entry& a, const Entry& b) { return better(a, b); };
+    if (keep > 0) {
+        std::sort_heap(heap.begin(), heap.end(), cmp);
+    } else {
+        std::sort(heap.begin(), heap.end(), cmp);
+    }
+    for (size_t i = offset; i < heap.size(); ++i) out.push_back(heap[i].item);
+    heap.clear();
+}
@@ -0,0 +1,153 @@
+#ifndef RELEVANCE_H
+#define RELEVANCE_H
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "ItemStore.h"
+#include "ItemOrder.h"
+#include "TextIndex.h"
+
+// 按 BM25F 相关度给关键词搜索的候选商品计分并选出前若干名。
+// 关键词的每个片段（见 TextIndex::candidates）是一个词项，逆文档频率取自文本索引中该片段的文档数，
+// 名称和描述分别按字符数相对平均长度归一，名称权重 3、描述权重 1。
+// 商品名称和描述都很短，词频几乎总是 0 或 1，这里词频只看片段是否出现，重复堆砌关键词也不加分。
+//
+// 得分随字段变长而降低，商品表按名称、描述字符数把可购买商品分组（ItemStore::lengthGroups），
+// 假设全部片段在两个字段都出现即得到每组的得分上界；文本索引记录了各词项出现在哪个字段，
+// 片段不可能出现在某个字段（如只在描述里出现的“全新”）时，上界不计该字段，组的先后只取决于另一个字段的长度。有数量限制时按组上界从高到低访问，
+// 某组的上界已低于当前第 K 名的得分时，后面的组都不必再看（提前终止）。
+// 组内成员带着名称、描述的字符签名，由签名判断片段“可能出现”在哪个字段得到每件商品的上界，
+// 排不进前 K 名的直接跳过，只有可能进入的才读原文计分。
+// 上界拉不开差距、要看的组太多时，改为直接扫描余下的候选，
+// 签名和字符数取自列存（ItemColumns::text）。
+struct RelevanceRanker {
+    static const double kNameWeight;
+    static const double kDescWeight;
+    static const double kK1;
+    static const double kB;
+
+    // rest 为相关度之后的排序键，得分相同时依次比较，仍相同时按ID升序
+    RelevanceRanker(const ItemStore& store, const std::vector<QueryTerm>& terms, const ItemOrder& rest);
+
+    // 读商品原文计算得分
+    double score(const Item& item);
+    // 只读列存的上界
+    double bound(int itemId) const;
+
+    // 访问 candidates：passes(id) 只读列存做廉价过滤，verify(item) 读原文核对，两者都通过的商品计分；
+    // 按得分取第 [offset, offset + limit) 名追加到 out，limit 为 0 表示全部计分。
+    // examined / scored 累加检查过的候选数和读原文计分的商品数
+    template <typename Passes, typename Verify>
+    void rank(const RoaringBitmap& candidates, Passes passes, Verify verify, size_t offset, size_t limit,
+              std::vector<const Item*>& out, size_t& examined, size_t& scored) {
+        keep = limit > 0 ? offset + limit : 0;
+        heap.clear();
+        // upper 为该商品的得分上界，只在已凑满前 K 名时才需要
+        auto visit = [&](int itemId, double upper) {
+            ++examined;
+            if (!passes(itemId)) return;
+            if (full() && prunes(upper, itemId)) return;
+            const Item* item = store.find(itemId);
+            if (!verify(*item)) return;
+            ++scored;
+            offer(score(*item), item);
+        };
+        if (keep == 0) {
+            candidates.forEach([&](uint32_t id) { visit(static_cast<int>(id), 0); });
+            drain(out, offset);
+            return;
+        }
+
+        // 逐组检查的代价约为组的大小之和，超过候选数的两倍时改为直接扫描余下的候选
+        const std::vector<std::vector<LengthGroupMember>>& groups = store.lengthGroups();
+        std::vector<GroupBound> order = groupOrder();
+        std::vector<char> visited(groups.size(), 0);
+        std::vector<const RoaringBitmap::Container*> byKey;
+        for (const RoaringBitmap::Container& c : candidates.containers) {
+            byKey.resize(c.key + 1, nullptr);
+            byKey[c.key] = &c;
+        }
+        uint64_t budget = 2 * candidates.cardinality();
+        uint64_t spent = 0;
+        bool finished = true;
+        for (const GroupBound& group : order) {
+            // 后面的组上界只会更低；同分的商品可能ID更小，所以只在严格更低时停止
+            if (full() && group.upper < heap.front().score) break;
+            const std::vector<LengthGroupMember>& members = groups[group.lengthClass];
+            spent += members.size();
+            if (spent > budget) {
+                finished = false;
+                break;
+            }
+            for (const LengthGroupMember& m : members) {
+                uint32_t key = static_cast<uint32_t>(m.itemId) >> 16;
+                if (key >= byKey.size() || !byKey[key] || !byKey[key]->contains(static_cast<uint16_t>(m.itemId))) {
+                    continue;
+                }
+                visit(m.itemId, full() ? memberBound(m, group) : 0);
+            }
+            visited[group.lengthClass] = 1;
+        }
+        if (!finished) {
+            candidates.forEach([&](uint32_t id) {
+                const TextSummary& text = columns.text[id];
+                int lengthClass = ItemStore::lengthClass(text.nameLength, text.descLength);
+                if (visited[lengthClass] || (full() && groupUpper[lengthClass] < heap.front().score)) return;
+                visit(static_cast<int>(id), full() ? bound(static_cast<int>(id)) : 0);
+            });
+        }
+        drain(out, offset);
+    }
+
+private:
+    struct Term {
+        std::string text;
+        bool latin;          // 拉丁片段不区分大小写
+        uint64_t signature;  // 片段全部字符的签名位
+        bool inNames;        // 文本索引中有名称/描述含有该片段的商品，没有时该字段不计入上界
+        bool inDescs;
+        double idf;
+    };
+    struct Entry {
+        double score;
+        const Item* item;
+    };
+    struct GroupBound {
+        double upper;
+        int lengthClass;
+        double nameWeight;   // 按组内最短的字段长度归一后的权重
+        double descWeight;
+    };
+    // 非空的长度分组按上界从高到低排列，同时填好 groupUpper
+    std::vector<GroupBound> groupOrder();
+    double boundOf(uint64_t nameSignature, uint64_t descSignature, double nameWeight, double descWeight) const;
+    double memberBound(const LengthGroupMember& m, const GroupBound& group) const {
+        return boundOf(m.nameSignature, m.descSignature, group.nameWeight, group.descWeight);
+    }
+    double nameNorm(int chars) const;
+    double descNorm(int chars) const;
+    bool better(const Entry& a, const Entry& b) const;
+    bool full() const { return keep > 0 && heap.size() == keep; }
+    // 上界排不进当前前 K 名：严格更低，或相等、没有其他排序键且ID更大（同分时排在后面）
+    bool prunes(double upper, int itemId) const {
+        const Entry& worst = heap.front();
+        return upper < worst.score ||
+               (upper == worst.score && rest.empty() && itemId > worst.item->getItemId());
+    }
+    void offer(double score, const Item* item);
+    void drain(std::vector<const Item*>& out, size_t offset);
+
+    const ItemStore& store;
+    const ItemColumns& columns;
+    const ItemOrder& rest;
+    std::vector<Term> terms;
+    double averageName;
+    double averageDesc;
+    size_t keep;
+    std::vector<Entry> heap;   // keep > 0 时为大顶堆，堆顶是当前保留的最差一件
+    std::vector<double> groupUpper;   // 长度分组 -> 得分上界
+    std::string nameText;      // 计分时转小写的名称/描述，复用缓冲
+    std::string descText;
+};
+#endif
@@ -0,0 +1,230 @@
+#include "RequestHandler.h"
+
+static void writeItem(WireWriter& out, const Item& item) {
+    out.i32(item.getItemId());
+    out.str(item.getItemName());
+    out.str(item.getDescription());
+    out.str(item.getCategory());
+    out.f64(item.getPrice());
+    out.u8(static_cast<uint8_t>(item.getStatus()));
+    out.i32(item.getSellerId());
+    out.str(item.getPublishDate());
+}
+
+static void writePage(WireWriter& out, const ItemPage& page) {
+    out.u32(static_cast<uint32_t>(page.items.size()));
+    for (const Item& item : page.items) writeItem(out, item);
+    out.str(page.nextCursor);
+}
+
+// 分页请求的公共部分：排序方式、页大小、游标
+static bool readPageRequest(WireReader& in, PageRequest& request) {
+    uint8_t order;
+    int32_t pageSize;
+    if (!in.u8(order) || !in.i32(pageSize) || !in.str(request.cursor)) return false;
+    if (order > ORDER_BY_PRICE_DESC || pageSize > kWirePageLimit) return false;
+    request.order = static_cast<PageOrder>(order);
+    request.pageSize = pageSize;
+    return true;
+}
+
+static WireStatus result(bool ok) {
+    return ok ? WIRE_OK : WIRE_FAILED;
+}
+
+RequestHandler::RequestHandler(TradingPlatform& platform) : platform(platform) {}
+
+// 先按成功写帧头和内容，状态不是 WIRE_OK 时回填状态码；除结账失败外丢掉已写的内容。
+// 对端不接受超出 kWireMaxFrame 的帧，这样的响应改为 WIRE_TOO_LARGE
+void RequestHandler::handle(WireSession& session, const WireFrame& request, std::string& out) const {
+    size_t start = beginFrame(out, request.requestId, WIRE_OK);
+    WireReader in(request.body.data(), request.body.size());
+    WireWriter writer(out);
+    WireStatus status = dispatch(session, request.code, in, writer);
+    if (out.size() - start - 4 > kWireMaxFrame) status = WIRE_TOO_LARGE;
+    if (status != WIRE_OK) {
+        if (!(status == WIRE_FAILED && request.code == WIRE_CHECKOUT)) out.resize(start + kWireHeader);
+        out[start + kWireHeader - 1] = static_cast<char>(status);
+    }
+    endFrame(out, start);
+}
+
+bool RequestHandler::attach(WireSession& session, const std::string& token) const {
+    int userId = platform.sessionUser(token);
+    UserRole role;
+    if (!userId || !platform.userRole(userId, role)) return false;
+    session.token = token;
+    session.userId = userId;
+    session.role = role;
+    return true;
+}
+
+// 需要登录的操作每次都凭令牌校验一次（一次分片哈希查找），会话过期或在别处注销后立即生效
+WireStatus RequestHandler::dispatch(WireSession& session, uint8_t op, WireReader& in, WireWriter& out) const {
+    if (op >= kWireOps) return WIRE_UNKNOWN_OP;
+    bool needsLogin = op >= WIRE_PUBLISH && op != WIRE_RESUME;
+    if (needsLogin) {
+        if (session.userId == 0) return WIRE_NOT_LOGGED_IN;
+        if (platform.sessionUser(session.token) != session.userId) {
+            session = WireSession();
+            return WIRE_NOT_LOGGED_IN;
+        }
+    }
+    bool adminOnly = op >= WIRE_ADMIN_BROWSE_ALL && op <= WIRE_ADMIN_COMPACT;
+    if (adminOnly && session.role != ADMIN) return WIRE_FORBIDDEN;
+
+    switch (op) {
+        case WIRE_PING:
+            return in.done() ? WIRE_OK : WIRE_MALFORMED;
+        case WIRE_REGISTER: {
+            std::string username, password, email, phone, studentId, realName, college;
+            in.str(username), in.str(password), in.str(email), in.str(phone);
+            in.str(studentId), in.str(realName), in.str(college);
+            if (!in.done()) return WIRE_MALFORMED;
+            return result(platform.registerUser(username, password, email, phone, studentId, realName, college, REGULAR_USER));
+        }
+        case WIRE_LOGIN: {
+            std::string email, password;
+            in.str(email), in.str(password);
+            if (!in.done()) return WIRE_MALFORMED;
+            std::string token = platform.openSession(email, password);
+            if (token.empty() || !attach(session, token)) return WIRE_FAILED;
+            out.i32(session.userId);
+            out.u8(static_cast<uint8_t>(session.role));
+            out.str(session.token);
+            return WIRE_OK;
+        }
+        case WIRE_RESUME: {
+            std::string token;
+            in.str(token);
+            if (!in.done()) return WIRE_MALFORMED;
+            if (!attach(session, token)) return WIRE_FAILED;
+            out.i32(session.userId);
+            out.u8(static_cast<uint8_t>(session.role));
+            return WIRE_OK;
+        }
+        case WIRE_LOGOUT:
+            if (!in.done()) return WIRE_MALFORMED;
+            if (!session.token.empty()) platform.closeSession(session.token);
+            session = WireSession();
+            return WIRE_OK;
+        case WIRE_BROWSE:
+        case WIRE_ADMIN_BROWSE_ALL: {
+            PageRequest request;
+            if (!readPageRequest(in, request) || !in.done()) return WIRE_MALFORMED;
+            ItemPage page;
+            bool ok = op == WIRE_BROWSE ? platform.browseItems(request, page) : platform.browseAllItems(request, page);
+            if (!ok) return WIRE_FAILED;
+            writePage(out, page);
+            return WIRE_OK;
+        }
+        case WIRE_SEARCH: {
+            std::string keyword, category, sortBy, cursor;
+            double minPrice = 0, maxPrice = 0;
+            int32_t pageSize = 0;
+            in.str(keyword), in.str(category), in.f64(minPrice), in.f64(maxPrice);
+            in.str(sortBy), in.i32(pageSize), in.str(cursor);
+            if (!in.done() || pageSize > kWirePageLimit) return WIRE_MALFORMED;
+            SearchCriteria criteria;
+            criteria.setKeyword(keyword);
+            criteria.setCategory(category);
+            criteria.setPriceRange(minPrice, maxPrice);
+            criteria.setSortBy(sortBy);
+            criteria.setPage(pageSize, cursor);
+            ItemPage page;
+            if (!platform.searchItems(criteria, page)) return WIRE_FAILED;
+            writePage(out, page);
+            return WIRE_OK;
+        }
+        case WIRE_ITEM_DETAIL: {
+            int32_t itemId = 0;
+            in.i32(itemId);
+            if (!in.done()) return WIRE_MALFORMED;
+            auto item = platform.findItemById(itemId);
+            if (!item) return WIRE_FAILED;
+            writeItem(out, *item);
+            return WIRE_OK;
+        }
+        case WIRE_SUGGEST: {
+            std::string prefix;
+            uint32_t limit = 0;
+            in.str(prefix), in.u32(limit);
+            if (!in.done() || limit > static_cast<uint32_t>(kWirePageLimit)) return WIRE_MALFORMED;
+            std::vector<Suggestion> hints = platform.suggest(prefix, limit);
+            out.u32(static_cast<uint32_t>(hints.size()));
+            for (const Suggestion& hint : hints) {
+                out.str(hint.text);
+                out.i32(hint.items);
+                out.u8(hint.category ? 1 : 0);
+            }
+            return WIRE_OK;
+        }
+        case WIRE_PUBLISH:
+        case WIRE_UPDATE_ITEM: {
+            int32_t itemId = 0;
+            std::string name, description, category;
+            double price = 0;
+            if (op == WIRE_UPDATE_ITEM) in.i32(itemId);
+            in.str(name), in.str(description), in.str(category), in.f64(price);
+            if (!in.done()) return WIRE_MALFORMED;
+            if (op == WIRE_UPDATE_ITEM) {
+                return result(platform.updateItem(itemId, session.userId, name, description, category, price));
+            }
+            int published = platform.publishItem(name, description, category, price, session.userId);
+            if (published < 0) return WIRE_FAILED;
+            out.i32(published);
+            return WIRE_OK;
+        }
+        case WIRE_DELETE_ITEM:
+        case WIRE_PURCHASE:
+        case WIRE_ADD_TO_CART:
+        case WIRE_REMOVE_FROM_CART:
+        case WIRE_ADD_FAVORITE:
+        case WIRE_REMOVE_FAVORITE: {
+            int32_t itemId = 0;
+            in.i32(itemId);
+            if (!in.done()) return WIRE_MALFORMED;
+            switch (op) {
+                case WIRE_DELETE_ITEM: return result(platform.deleteItem(itemId, session.userId));
+                case WIRE_PURCHASE: return result(platform.purchaseItem(itemId, session.userId));
+                case WIRE_ADD_TO_CART: return result(platform.addToCart(itemId, session.userId));
+                case WIRE_REMOVE_FROM_CART: return result(platform.removeFromCart(itemId, session.userId));
+                case WIRE_ADD_FAVORITE: return result(platform.addToFavorites(itemId, session.userId));
+                default: return result(platform.removeFromFavorites(itemId, session.userId));
+            }
+        }
+        case WIRE_LIST: {
+            uint8_t list = 0;
+            in.u8(list);
+            if (!in.done() || list > LIST_PUBLISHED) return WIRE_MALFORMED;
+            out.ids(platform.listUserItems(session.userId, static_cast<UserItemList>(list)));
+            return WIRE_OK;
+        }
+        case WIRE_CHECKOUT: {
+            if (!in.done()) return WIRE_MALFORMED;
+            std::vector<int> unavailable;
+            bool ok = platform.checkout(session.userId, unavailable);
+            out.ids(unavailable);
+            return result(ok);
+        }
+        case WIRE_ADMIN_STATS: {
+            if (!in.done()) return WIRE_MALFORMED;
+            CatalogStats stats = platform.getCatalogStats();
+            SearchCacheStats cache = platform.getSearchCacheStats();
+            out.i32(platform.getUserCount());
+            out.i32(platform.getItemCount());
+            out.i32(stats.liveRows);
+            out.i32(stats.soldRows);
+            out.i32(stats.deletedRows);
+            out.i32(stats.tombstones);
+            out.u64(cache.hits);
+            out.u64(cache.misses);
+            return WIRE_OK;
+        }
+        case WIRE_ADMIN_COMPACT:
+            if (!in.done()) return WIRE_MALFORMED;
+            out.i32(platform.compactCatalog());
+            return WIRE_OK;
+    }
+    return WIRE_UNKNOWN_OP;
+}
@@ -0,0 +1,31 @@
+#ifndef REQUESTHANDLER_H
+#define REQUESTHANDLER_H
+#include <string>
+#include "Platform.h"
+#include "WireProtocol.h"
+
+// 一个连接上的会话：登录后记下令牌和用户，之后的请求只凭令牌校验，以该用户身份执行
+struct WireSession {
+    std::string token;
+    int userId;       // 0 表示未登录
+    UserRole role;
+
+    WireSession() : userId(0), role(REGULAR_USER) {}
+};
+
+// 把协议请求翻译成 TradingPlatform 的调用。自身没有可变状态，多个线程可以同时调用 handle，
+// 同一个会话的请求须由调用方依次处理
+struct RequestHandler {
+    explicit RequestHandler(TradingPlatform& platform);
+
+    // 处理一帧请求，把响应帧追加到 out
+    void handle(WireSession& session, const WireFrame& request, std::string& out) const;
+
+private:
+    WireStatus dispatch(WireSession& session, uint8_t op, WireReader& in, WireWriter& out) const;
+    // 以令牌对应的用户登入会话，令牌无效时返回 false
+    bool attach(WireSession& session, const std::string& token) const;
+
+    TradingPlatform& platform;
+};
+#endif
@@ -0,0 +1,243 @@
+#include "RoaringBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+// ---------------- 容器 ----------------
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (dense) {
+        return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(values.begin(), values.end(), low);
+}
+
+bool RoaringBitmap::Container::add(uint16_t low) {
+    if (dense) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (bits[low >> 6] & mask) return false;
+        bits[low >> 6] |= mask;
+        ++cardinality;
+        return true;
+    }
+    auto pos = std::lower_bound(values.begin(), values.end(), low);
+    if (pos != values.end() && *pos == low) return false;
+    values.insert(pos, low);
+    ++cardinality;
+    if (cardinality > kArrayLimit) toBitset();
+    return true;
+}
+
+bool RoaringBitmap::Container::remove(uint16_t low) {
+    if (dense) {
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(bits[low >> 6] & mask)) return false;
+        bits[low >> 6] &= ~mask;
+        --cardinality;
+        if (cardinality <= kArrayLimit) toArray();
+        return true;
+    }
+    auto pos = std::lower_bound(values.begin(), values.end(), low);
+    if (pos == values.end() || *pos != low) return false;
+    values.erase(pos);
+    --cardinality;
+    return true;
+}
+
+void RoaringBitmap::Container::toBitset() {
+    bits.assign(kBitsetWords, 0);
+    for (uint16_t low : values) {
+        bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    std::vector<uint16_t>().swap(values);
+    dense = true;
+}
+
+void RoaringBitmap::Container::toArray() {
+    values.clear();
+    values.reserve(cardinality);
+    for (int w = 0; w < kBitsetWords; ++w) {
+        uint64_t word = bits[w];
+        while (word) {
+            values.push_back(static_cast<uint16_t>(w * 64 + lowestSetBit(word)));
+            word &= word - 1;
+        }
+    }
+    std::vector<uint64_t>().swap(bits);
+    dense = false;
+}
+
+// ---------------- 位图 ----------------
+
+static bool containerKeyLess(const RoaringBitmap::Container& c, uint16_t key) {
+    return c.key < key;
+}
+
+RoaringBitmap::Container* RoaringBitmap::findContainer(uint16_t key) {
+    auto pos = std::lower_bound(containers.begin(), containers.end(), key, containerKeyLess);
+    return (pos != containers.end() && pos->key == key) ? &*pos : nullptr;
+}
+
+const RoaringBitmap::Container* RoaringBitmap::findContainer(uint16_t key) const {
+    auto pos = std::lower_bound(containers.begin(), containers.end(), key, containerKeyLess);
+    return (pos != containers.end() && pos->key == key) ? &*pos : nullptr;
+}
+
+bool RoaringBitmap::add(uint32_t id) {
+    uint16_t key = static_cast<uint16_t>(id >> 16);
+    auto pos = std::lower_bound(containers.begin(), containers.end(), key, containerKeyLess);
+    if (pos == containers.end() || pos->key != key) {
+        pos = containers.insert(pos, Container(key));
+    }
+    if (!pos->add(static_cast<uint16_t>(id & 0xffff))) return false;
+    ++total;
+    return true;
+}
+
+bool RoaringBitmap::remove(uint32_t id) {
+    uint16_t key = static_cast<uint16_t>(id >> 16);
+    auto pos = std::lower_bound(containers.begin(), containers.end(), key, containerKeyLess);
+    if (pos == containers.end() || pos->key != key) return false;
+    if (!pos->remove(static_cast<uint16_t>(id & 0xffff))) return false;
+    --total;
+    if (pos->cardinality == 0) containers.erase(pos);
+    return true;
+}
+
+bool RoaringBitmap::contains(uint32_t id) const {
+    const Container* c = findContainer(static_cast<uint16_t>(id >> 16));
+    return c && c->contains(static_cast<uint16_t>(id & 0xffff));
+}
+
+void RoaringBitmap::clear() {
+    containers.clear();
+    total = 0;
+}
+
+// 两个容器求交，结果写入 out（out 为空数组容器）
+static void intersectContainers(const RoaringBitmap::Container& a, const RoaringBitmap::Container& b,
+                                RoaringBitmap::Container& out) {
+    if (a.dense && b.dense) {
+        out.bits.assign(RoaringBitmap::kBitsetWords, 0);
+        uint32_t card = 0;
+        for (int w = 0; w < RoaringBitmap::kBitsetWords; ++w) {
+            out.bits[w] = a.bits[w] & b.bits[w];
+            card += popcount64(out.bits[w]);
+        }
+        out.dense = true;
+        out.cardinality = card;
+        if (card <= RoaringBitmap::kArrayLimit) out.toArray();
+    } else if (a.dense || b.dense) {
+        const RoaringBitmap::Container& sparse = a.dense ? b : a;
+        const RoaringBitmap::Container& bitset = a.dense ? a : b;
+        for (uint16_t low : sparse.values) {
+            if (bitset.contains(low)) out.values.push_back(low);
+        }
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    } else {
+        std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                              std::back_inserter(out.values));
+        out.cardinality = static_cast<uint32_t>(out.values.size());
+    }
+}
+
+RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        const Container& a = containers[i];
+        const Container& b = other.containers[j];
+        if (a.key < b.key) {
+            ++i;
+        } else if (b.key < a.key) {
+            ++j;
+        } else {
+            Container out(a.key);
+            intersectContainers(a, b, out);
+            if (out.cardinality > 0) {
+                result.total += out.cardinality;
+                result.containers.push_back(std::move(out));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::unite(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.containers.push_back(containers[i++]);
+        } else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            result.containers.push_back(other.containers[j++]);
+        } else {
+            const Container& a = containers[i];
+            const Container& b = other.containers[j];
+            if (!a.dense && !b.dense) {
+                // 两个数组容器归并，超过上限再转位图
+                Container out(a.key);
+                std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                               std::back_inserter(out.values));
+                out.cardinality = static_cast<uint32_t>(out.values.size());
+                if (out.cardinality > kArrayLimit) out.toBitset();
+                result.containers.push_back(std::move(out));
+            } else {
+                Container out = a.dense ? a : b;
+                (a.dense ? b : a).forEachLow([&out](uint16_t low) { out.add(low); });
+                result.containers.push_back(std::move(out));
+            }
+            ++i;
+            ++j;
+        }
+        result.total += result.containers.back().cardinality;
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::intersectDense(const std::vector<uint64_t>& dense) const {
+    RoaringBitmap result;
+    for (const Container& c : containers) {
+        size_t baseWord = static_cast<size_t>(c.key) * kBitsetWords;
+        if (baseWord >= dense.size()) break;
+        Container out(c.key);
+        if (c.dense) {
+            out.bits.assign(kBitsetWords, 0);
+            uint32_t card = 0;
+            for (int w = 0; w < kBitsetWords && baseWord + w < dense.size(); ++w) {
+                out.bits[w] = c.bits[w] & dense[baseWord + w];
+                card += popcount64(out.bits[w]);
+            }
+            out.dense = true;
+            out.cardinality = card;
+            if (card <= kArrayLimit) out.toArray();
+        } else {
+            for (uint16_t low : c.values) {
+                size_t word = baseWord + (low >> 6);
+                if (word < dense.size() && ((dense[word] >> (low & 63)) & 1)) out.values.push_back(low);
+            }
+            out.cardinality = static_cast<uint32_t>(out.values.size());
+        }
+        if (out.cardinality > 0) {
+            result.total += out.cardinality;
+            result.containers.push_back(std::move(out));
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> RoaringBitmap::toVector() const {
+    std::vector<uint32_t> ids;
+    ids.reserve(static_cast<size_t>(total));
+    forEach([&ids](uint32_t id) { ids.push_back(id); });
+    return ids;
+}
+
+size_t RoaringBitmap::memoryBytes() const {
+    size_t bytes = containers.capacity() * sizeof(Container);
+    for (const Container& c : containers) {
+        bytes += c.values.capacity() * sizeof(uint16_t) + c.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
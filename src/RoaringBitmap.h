@@ -0,0 +1,139 @@
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "BitUtil.h"
+
+// 压缩位图（Roaring 结构）：按ID高16位分桶，每桶是一个容器。
+// 桶内元素不多于 4096 个时用有序 uint16 数组存放，超过后换成 65536 位的定长位图，
+// 稀疏和稠密的集合都能省内存，求交时按容器类型选择归并、探测或逐字按位与。
+struct RoaringBitmap {
+    static const uint32_t kArrayLimit = 4096;
+    static const int kBitsetWords = 1024;
+
+    struct Container {
+        uint16_t key;                  // ID 的高16位
+        bool dense;                    // true 时 bits 有效，否则 values 有效
+        uint32_t cardinality;
+        std::vector<uint16_t> values;  // 稀疏：升序的低16位
+        std::vector<uint64_t> bits;    // 稠密：1024 个字
+
+        explicit Container(uint16_t k) : key(k), dense(false), cardinality(0) {}
+        bool contains(uint16_t low) const;
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        void toBitset();
+        void toArray();
+
+        template <typename Visit>
+        void forEachLow(Visit visit) const {
+            if (dense) {
+                for (int w = 0; w < kBitsetWords; ++w) {
+                    uint64_t word = bits[w];
+                    while (word) {
+                        visit(static_cast<uint16_t>(w * 64 + lowestSetBit(word)));
+                        word &= word - 1;
+                    }
+                }
+            } else {
+                for (uint16_t low : values) visit(low);
+            }
+        }
+    };
+
+    std::vector<Container> containers;   // 按 key 升序
+    uint64_t total;
+
+    RoaringBitmap() : total(0) {}
+
+    bool add(uint32_t id);
+    bool remove(uint32_t id);
+    bool contains(uint32_t id) const;
+    uint64_t cardinality() const { return total; }
+    bool empty() const { return total == 0; }
+    void clear();
+
+    // 交集 / 并集，返回新位图
+    RoaringBitmap intersect(const RoaringBitmap& other) const;
+    RoaringBitmap unite(const RoaringBitmap& other) const;
+    // 与普通位图求交：dense 的第 i 位对应 ID i
+    RoaringBitmap intersectDense(const std::vector<uint64_t>& dense) const;
+
+    // 按升序访问每个ID
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const Container& c : containers) {
+            uint32_t high = static_cast<uint32_t>(c.key) << 16;
+            c.forEachLow([high, &visit](uint16_t low) { visit(high | low); });
+        }
+    }
+
+    // 从ID不小于 first 的元素开始按升序访问，visit 返回 false 时停止
+    template <typename Visit>
+    void scanFrom(uint32_t first, Visit visit) const {
+        const uint16_t firstKey = static_cast<uint16_t>(first >> 16);
+        auto c = std::lower_bound(containers.begin(), containers.end(), firstKey,
+                                  [](const Container& entry, uint16_t key) { return entry.key < key; });
+        for (; c != containers.end(); ++c) {
+            const uint32_t high = static_cast<uint32_t>(c->key) << 16;
+            const uint16_t from = c->key == firstKey ? static_cast<uint16_t>(first & 0xffff) : 0;
+            if (c->dense) {
+                for (int w = from / 64; w < kBitsetWords; ++w) {
+                    uint64_t word = c->bits[w];
+                    if (w == from / 64) word &= ~uint64_t(0) << (from & 63);
+                    for (; word; word &= word - 1) {
+                        if (!visit(high | static_cast<uint32_t>(w * 64 + lowestSetBit(word)))) return;
+                    }
+                }
+            } else {
+                for (auto v = std::lower_bound(c->values.begin(), c->values.end(), from); v != c->values.end(); ++v) {
+                    if (!visit(high | *v)) return;
+                }
+            }
+        }
+    }
+
+    // 从ID小于 bound 的元素开始按降序访问，visit 返回 false 时停止
+    template <typename Visit>
+    void scanBefore(uint32_t bound, Visit visit) const {
+        if (bound == 0) return;
+        const uint32_t last = bound - 1;
+        const uint16_t lastKey = static_cast<uint16_t>(last >> 16);
+        auto c = std::upper_bound(containers.begin(), containers.end(), lastKey,
+                                  [](uint16_t key, const Container& entry) { return key < entry.key; });
+        while (c != containers.begin()) {
+            --c;
+            const uint32_t high = static_cast<uint32_t>(c->key) << 16;
+            const int to = c->key == lastKey ? static_cast<int>(last & 0xffff) : 0xffff;
+            if (c->dense) {
+                for (int w = to / 64; w >= 0; --w) {
+                    uint64_t word = c->bits[w];
+                    if (w == to / 64 && (to & 63) != 63) word &= (uint64_t(1) << ((to & 63) + 1)) - 1;
+                    while (word) {
+                        int bit = highestSetBit(word);
+                        if (!visit(high | static_cast<uint32_t>(w * 64 + bit))) return;
+                        word &= ~(uint64_t(1) << bit);
+                    }
+                }
+            } else {
+                auto v = std::upper_bound(c->values.begin(), c->values.end(), static_cast<uint16_t>(to));
+                while (v != c->values.begin()) {
+                    --v;
+                    if (!visit(high | *v)) return;
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> toVector() const;
+    // 估算占用的堆内存字节数
+    size_t memoryBytes() const;
+
+private:
+    Container* findContainer(uint16_t key);
+    const Container* findContainer(uint16_t key) const;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "SearchCache.h"
+#include "ItemOrder.h"
+#include <cstring>
+#include <iterator>
+
+SearchCache::SearchCache(size_t entries, size_t refLimit) : maxEntries(entries), maxRefs(refLimit), refs(0) {
+    std::memset(&counters, 0, sizeof(counters));
+}
+
+// 字段之间用 \x1f 分隔，避免 "a" + "bc" 与 "ab" + "c" 拼成同一个键
+static void appendField(std::string& out, const std::string& field) {
+    out += field;
+    out += '\x1f';
+}
+
+static void appendBytes(std::string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+    out += '\x1f';
+}
+
+std::string SearchCache::key(const char* kind, const SearchCriteria& criteria) {
+    std::string out;
+    appendField(out, kind);
+    appendField(out, criteria.keyword);
+    appendBytes(out, &criteria.maxDistance, sizeof(criteria.maxDistance));
+    appendField(out, criteria.category);
+    appendBytes(out, &criteria.minPrice, sizeof(criteria.minPrice));
+    appendBytes(out, &criteria.maxPrice, sizeof(criteria.maxPrice));
+    // "price_asc,bogus" 与 "price_asc" 的排序相同
+    ItemOrder order(criteria.sortBy);
+    for (SortKey k : order.keys) out += static_cast<char>('a' + k);
+    out += '\x1f';
+    appendBytes(out, &criteria.limit, sizeof(criteria.limit));
+    appendBytes(out, &criteria.offset, sizeof(criteria.offset));
+    appendBytes(out, &criteria.pageSize, sizeof(criteria.pageSize));
+    appendField(out, criteria.cursor);
+    return out;
+}
+
+bool SearchCache::valid(const Entry& entry, const ItemStore& store) const {
+    if (entry.categoryId >= 0 && store.categoryVersion(entry.categoryId) == entry.categoryStamp) return true;
+    if (entry.textBucket >= 0 && store.textVersion(entry.textBucket) == entry.textStamp) return true;
+    if (entry.categoryId < 0 && entry.textBucket < 0) return store.generation() == entry.generation;
+    return false;
+}
+
+bool SearchCache::lookup(const std::string& key, const ItemStore& store, ItemPage& page) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++counters.misses;
+        return false;
+    }
+    auto pos = it->second;
+    bool fresh = valid(*pos, store);
+    ItemView view;
+    if (fresh) view.refs.reserve(pos->ids.size());
+    for (int id : pos->ids) {
+        if (!fresh) break;
+        const Item* item = store.find(id);
+        fresh = item && item->isAvailable();
+        view.refs.push_back(item);
+    }
+    if (!fresh) {
+        ++counters.invalidations;
+        ++counters.misses;
+        erase(pos);
+        return false;
+    }
+    ++counters.hits;
+    lru.splice(lru.begin(), lru, pos);
+    view.generation = store.generation();
+    page.items = std::move(view);
+    page.nextCursor = pos->nextCursor;
+    return true;
+}
+
+void SearchCache::insert(const std::string& key, const ItemStore& store, const std::string& category,
+                         const std::string& keyword, const ItemPage& page) {
+    if (maxEntries == 0 || page.items.size() > maxRefs) return;
+    auto it = index.find(key);
+    if (it != index.end()) erase(it->second);
+
+    Entry entry;
+    entry.key = key;
+    entry.ids = page.items.ids();
+    entry.nextCursor = page.nextCursor;
+    entry.categoryId = -1;
+    entry.categoryStamp = 0;
+    entry.textBucket = -1;
+    entry.textStamp = 0;
+    entry.generation = store.generation();
+    if (!category.empty()) {
+        entry.categoryId = store.categoryDictionary().lookup(category);
+        if (entry.categoryId >= 0) entry.categoryStamp = store.categoryVersion(entry.categoryId);
+    }
+    if (!keyword.empty()) {
+        entry.textBucket = store.quietestTextBucket(keyword);
+        if (entry.textBucket >= 0) entry.textStamp = store.textVersion(entry.textBucket);
+    }
+    lru.push_front(std::move(entry));
+    index[key] = lru.begin();
+    refs += page.items.size();
+    evict();
+}
+
+void SearchCache::erase(std::list<Entry>::iterator pos) {
+    refs -= pos->ids.size();
+    index.erase(pos->key);
+    lru.erase(pos);
+}
+
+void SearchCache::evict() {
+    while (!lru.empty() && (lru.size() > maxEntries || refs > maxRefs)) {
+        erase(std::prev(lru.end()));
+        ++counters.evictions;
+    }
+}
+
+void SearchCache::clear() {
+    lru.clear();
+    index.clear();
+    refs = 0;
+}
+
+void SearchCache::setCapacity(size_t entries, size_t refLimit) {
+    maxEntries = entries;
+    maxRefs = refLimit;
+    evict();
+}
+
+SearchCacheStats SearchCache::stats() const {
+    SearchCacheStats s = counters;
+    s.entries = lru.size();
+    s.cachedRefs = refs;
+    return s;
+}
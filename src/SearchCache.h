@@ -0,0 +1,67 @@
+#ifndef SEARCHCACHE_H
+#define SEARCHCACHE_H
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include "ItemStore.h"
+#include "Pagination.h"
+#include "SearchEngine.h"
+
+struct SearchCacheStats {
+    unsigned long long hits;
+    unsigned long long misses;         // 含已失效的条目
+    unsigned long long invalidations;  // 查到条目但版本号已变化
+    unsigned long long evictions;      // 超出容量被淘汰
+    size_t entries;
+    size_t cachedRefs;                 // 全部条目中的商品数
+};
+
+// 查询结果缓存，按最近最少使用淘汰，条目数和缓存的商品ID总数都有上限。
+// 键由查询种类和规范化后的查询条件组成（见 key）。每个条目记录它依赖的失效戳：
+//   指定了分类时记录该分类的版本号，指定了关键词时记录关键词中变化最少的字符桶的版本号
+//   （见 ItemStore::categoryVersion / quietestTextBucket），两者都没有时记录商品表版本号。
+// 能改变结果的商品一定同时在该分类中、含有关键词的每个字符，所以任一失效戳未变化即说明结果仍然有效；
+// 其他分类或不相关的商品发布、售出都不会使条目失效。
+// 命中时还会确认结果中的商品仍可购买，已售出的商品不会从缓存中返回。
+// 条目只记商品ID，不记商品地址，命中时按ID在传入的商品表中取回商品，
+// 所以同一个缓存可以服务内容一致的多份商品表（平台的两份副本，见 EpochReplicas）。
+struct SearchCache {
+    explicit SearchCache(size_t maxEntries = 256, size_t maxRefs = 1 << 20);
+
+    // 查询条件的规范化键：排序键按解析结果归一，价格按二进制精确比较
+    static std::string key(const char* kind, const SearchCriteria& criteria);
+
+    // 命中且仍然有效时写入 page（视图的版本号为当前商品表版本号）并返回 true
+    bool lookup(const std::string& key, const ItemStore& store, ItemPage& page);
+    // category / keyword 为该查询的分类和关键词条件，为空表示没有该条件
+    void insert(const std::string& key, const ItemStore& store, const std::string& category,
+                const std::string& keyword, const ItemPage& page);
+    void clear();
+    void setCapacity(size_t maxEntries, size_t maxRefs);
+    SearchCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::vector<int> ids;             // 结果中的商品ID，命中时在查询的商品表中取回商品
+        std::string nextCursor;
+        int categoryId;                   // -1 表示不依赖分类
+        unsigned long long categoryStamp;
+        int textBucket;                   // -1 表示不依赖关键词
+        unsigned long long textStamp;
+        unsigned long long generation;    // 分类和关键词都不依赖时使用
+    };
+    bool valid(const Entry& entry, const ItemStore& store) const;
+    void erase(std::list<Entry>::iterator pos);
+    void evict();
+
+    std::list<Entry> lru;   // 表头最近使用
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t maxEntries;
+    size_t maxRefs;
+    size_t refs;
+    SearchCacheStats counters;
+};
+#endif
@@ -1,86 +1,671 @@
 #include "SearchEngine.h"
+#include "FilterKernel.h"
+#include "Utf8.h"
+#include "ItemOrder.h"
+#include "Relevance.h"
+#include "FuzzyMatch.h"
+#include "WorkStealingPool.h"
+#include "ImageHash.h"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <limits>
+#include <memory>
 
 
 //该文件中部分函数并没有被使用到，但是可以作为后续接口，进一步拓展软件功能，因此我还保留
-SearchCriteria::SearchCriteria() : minPrice(0), maxPrice(1000000) {}
+SearchCriteria::SearchCriteria()
+    : maxDistance(0), minPrice(0), maxPrice(1000000), pageSize(10), limit(0), offset(0), threads(1),
+      parallelMinRows(kParallelScanMinRows) {}
 
 void SearchCriteria::setKeyword(const std::string& kw) { keyword = kw; }
+void SearchCriteria::setMaxDistance(int distance) { maxDistance = distance > 0 ? distance : 0; }
 void SearchCriteria::setCategory(const std::string& cat) { category = cat; }
 void SearchCriteria::setPriceRange(double min, double max) { 
     minPrice = min; 
     maxPrice = max; 
 }
 void SearchCriteria::setSortBy(const std::string& sort) { sortBy = sort; }
+void SearchCriteria::setPage(int size, const std::string& pageCursor) {
+    pageSize = size;
+    cursor = pageCursor;
+}
+void SearchCriteria::setLimit(size_t count, size_t skip) {
+    limit = count;
+    offset = skip;
+}
+void SearchCriteria::setThreads(int count, int minRows) {
+    threads = count > 1 ? count : 1;
+    parallelMinRows = minRows;
+}
+
+// 按字节查找在 UTF-8 下只有关键词本身完整时才可靠：不完整的多字节序列可能命中别的汉字的一部分，
+// 所以非法的关键词不匹配任何商品
+static bool containsKeyword(const Item& item, const std::string& keyword) {
+    return keyword.empty() ||
+           (isValidUtf8(keyword) &&
+            (item.getItemName().find(keyword) != std::string::npos ||
+             item.getDescription().find(keyword) != std::string::npos));
+}
+
+// 关键词条件：精确匹配按字节查找；允许编辑距离时先建好模式的位掩码，逐件核对时复用
+struct KeywordFilter {
+    const std::string& keyword;
+    std::unique_ptr<FuzzyPattern> fuzzy;
+
+    KeywordFilter(const std::string& kw, int maxDistance) : keyword(kw) {
+        if (maxDistance > 0 && !kw.empty()) fuzzy.reset(new FuzzyPattern(kw, maxDistance));
+    }
+    bool operator()(const Item& item) const {
+        if (!fuzzy) return containsKeyword(item, keyword);
+        return fuzzy->matches(item.getItemName()) || fuzzy->matches(item.getDescription());
+    }
+};
+
+static bool matchesAll(const SearchCriteria& criteria, const Item& item, const KeywordFilter& matchKeyword) {
+    if (!item.isAvailable()) return false;
+
+    if (item.getPrice() < criteria.minPrice || item.getPrice() > criteria.maxPrice) {
+        return false;
+    }
+
+    if (!matchKeyword(item)) {
+        return false;
+    }
+
+    if (!criteria.category.empty() && item.getCategory() != criteria.category) {
+        return false;
+    }
+    return true;
+}
+
+bool SearchCriteria::matches(const Item& item) const {
+    return matchesAll(*this, item, KeywordFilter(keyword, maxDistance));
+}
+
+// 商品到达 ResultSink 的顺序
+enum InputOrder {
+    INPUT_AS_GIVEN,     // 视图原有顺序，不排序时保持
+    INPUT_ID_ASC,       // 扫描商品表
+    INPUT_PRICE_ASC,    // 价格索引升序扫描，同价按ID升序
+    INPUT_PRICE_DESC    // 价格索引降序扫描，同价按ID升序
+};
+
+// 收集查询结果。有排序且有数量限制时边扫描边选，只保留前 offset + limit 件：
+//   一般情况用有界堆（TopKCollector）；
+//   商品到达的顺序已经符合排序（按ID升序扫描且首个排序键是ID，或按价格顺序扫描且只按价格排序）时，
+//   直接保留最前/最后的若干件；
+// 否则先全部收集，最后再排序、截取。
+struct ResultSink {
+    enum Mode { COLLECT_ALL, TOP_K, FIRST_K, LAST_K };
+
+    ItemView& result;
+    ItemOrder order;
+    size_t offset;
+    size_t limit;
+    Mode mode;
+    bool presorted;   // 到达顺序即结果顺序，收集完不必再排序
+    TopKCollector top;
+
+    ResultSink(ItemView& r, const std::string& sortBy, size_t skip, size_t count, InputOrder input)
+        : result(r), order(sortBy), offset(skip), limit(count), mode(COLLECT_ALL), presorted(false),
+          top(order, count > 0 ? skip + count : 0) {
+        bool byPrice = input == INPUT_PRICE_ASC || input == INPUT_PRICE_DESC;
+        if (byPrice) {
+            SortKey priceKey = input == INPUT_PRICE_ASC ? KEY_PRICE_ASC : KEY_PRICE_DESC;
+            presorted = !order.empty() && order.keys[0] == priceKey &&
+                        (order.keys.size() == 1 || order.keys[1] == KEY_ID_ASC);
+            // 其余情况下排序键相同（或不排序）的商品应按ID升序，而到达顺序是价格顺序，补上ID作为最后一个键
+            if (!presorted) order.keys.push_back(KEY_ID_ASC);
+        }
+        if (count == 0 || order.empty()) return;
+        mode = TOP_K;
+        if (presorted) mode = FIRST_K;
+        if (input == INPUT_ID_ASC && order.keys[0] == KEY_ID_ASC) mode = FIRST_K;
+        if (input == INPUT_ID_ASC && order.keys[0] == KEY_ID_DESC) mode = LAST_K;
+    }
+
+    // 并行扫描时每块只需交出的件数：有界堆或按到达顺序取前若干件时为 offset + limit，0 表示全部
+    size_t partialLimit() const {
+        return mode == TOP_K || mode == FIRST_K ? offset + limit : 0;
+    }
+
+    // FIRST_K 已凑够 offset + limit 件，后面到达的商品都排在它们之后
+    bool satisfied() const {
+        return mode == FIRST_K && result.refs.size() >= offset + limit;
+    }
+
+    // 价格为首个排序键且堆已满时，价格严格更差的商品不可能进入结果，不必读取商品
+    bool rejectsPrice(double price) const {
+        if (mode != TOP_K || !top.full()) return false;
+        if (order.keys[0] == KEY_PRICE_ASC) return price > top.worst()->getPrice();
+        if (order.keys[0] == KEY_PRICE_DESC) return price < top.worst()->getPrice();
+        return false;
+    }
+
+    void add(const Item* item) {
+        std::vector<const Item*>& refs = result.refs;
+        switch (mode) {
+            case TOP_K:
+                top.offer(item);
+                break;
+            case FIRST_K:
+                if (refs.size() < offset + limit) refs.push_back(item);
+                break;
+            case LAST_K:
+                refs.push_back(item);
+                if (refs.size() >= 2 * (offset + limit)) refs.erase(refs.begin(), refs.begin() + (offset + limit));
+                break;
+            default:
+                refs.push_back(item);
+        }
+    }
+
+    void finish() {
+        std::vector<const Item*>& refs = result.refs;
+        switch (mode) {
+            case TOP_K:
+                top.drain(refs, offset);
+                break;
+            case LAST_K:
+                if (refs.size() > offset + limit) refs.erase(refs.begin(), refs.end() - (offset + limit));
+                std::reverse(refs.begin(), refs.end());
+                orderRefs(refs, ItemOrder(), offset, limit);
+                break;
+            case FIRST_K:
+                orderRefs(refs, ItemOrder(), offset, limit);
+                break;
+            default:
+                orderRefs(refs, presorted ? ItemOrder() : order, offset, limit);
+        }
+    }
+};
+
+ItemView SearchCriteria::select(const ItemView& items) const {
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    ResultSink sink(result, sortBy, offset, limit, INPUT_AS_GIVEN);
+    KeywordFilter matchKeyword(keyword, maxDistance);
+    for (const Item* item : items.refs) {
+        if (matchesAll(*this, *item, matchKeyword)) {
+            sink.add(item);
+        }
+    }
+    sink.finish();
+    return result;
+}
+
+static const RoaringBitmap kNoItems;
+
+// 取出分类位图和文本索引的候选集（两者都有时求交），并从各索引的统计填好计划、选出访问路径。
+// 没有候选集条件时 postings 为空；分类不存在时候选集为空集。terms 为关键词的各个片段，相关度计分使用
+static void preparePlan(const SearchCriteria& criteria, const ItemStore& store, QueryPlan& plan,
+                        RoaringBitmap& textCandidates, const RoaringBitmap*& postings, bool& exact,
+                        std::vector<QueryTerm>& terms) {
+    plan.category = criteria.category;
+    plan.keyword = criteria.keyword;
+    plan.maxDistance = criteria.maxDistance;
+    plan.minPrice = criteria.minPrice;
+    plan.maxPrice = criteria.maxPrice;
+    plan.sortBy = criteria.sortBy;
+    plan.offset = criteria.offset;
+    plan.limit = criteria.limit;
+    plan.tableRows = store.size();
+    plan.liveRows = store.liveCount();
+    plan.priceRows = store.priceIndex().countInRange(criteria.minPrice, criteria.maxPrice);
+
+    postings = nullptr;
+    exact = false;
+    if (!criteria.category.empty()) {
+        postings = store.categoryBitmap(criteria.category);
+        if (!postings) postings = &kNoItems;
+        plan.categoryRows = static_cast<double>(postings->cardinality());
+    }
+    if (!criteria.keyword.empty()) {
+        bool indexed;
+        if (criteria.maxDistance > 0) {
+            // 近似搜索：候选集取关键词各分段的候选集之并，总要核对原文
+            FuzzyPattern pattern(criteria.keyword, criteria.maxDistance);
+            indexed = store.textIndex().candidatesAny(pattern.pieces(), textCandidates);
+        } else {
+            indexed = store.textIndex().candidates(criteria.keyword, textCandidates, &exact, &terms);
+        }
+        if (indexed) {
+            plan.keywordRows = static_cast<double>(textCandidates.cardinality());
+            if (postings) textCandidates = textCandidates.intersect(*postings);
+            postings = &textCandidates;
+        }
+        plan.keywordRecheck = !exact;
+    }
+    if (postings) plan.candidateRows = static_cast<double>(postings->cardinality());
+
+    ItemOrder order(criteria.sortBy);
+    plan.priceOrdered = !order.empty() && (order.keys[0] == KEY_PRICE_ASC || order.keys[0] == KEY_PRICE_DESC);
+    // 没有关键词、关键词不能走索引或是近似搜索时不计分，按其余排序键排列
+    plan.relevanceOrdered = !order.empty() && order.keys[0] == KEY_RELEVANCE && plan.keywordRows >= 0 &&
+                            criteria.maxDistance <= 0;
+    plan.choose();
+    // 路径按单线程代价选出；走全表扫描且商品表足够大时才并行
+    if (plan.path == PATH_FILTER_KERNEL && criteria.threads > 1 && plan.tableRows >= criteria.parallelMinRows) {
+        plan.threads = criteria.threads;
+    }
+}
+
+QueryPlan SearchCriteria::plan(const ItemStore& store) const {
+    QueryPlan result;
+    RoaringBitmap textCandidates;
+    const RoaringBitmap* postings;
+    bool exact;
+    std::vector<QueryTerm> terms;
+    preparePlan(*this, store, result, textCandidates, postings, exact, terms);
+    return result;
+}
+
+std::string SearchCriteria::explain(const ItemStore& store) const {
+    QueryPlan executed;
+    select(store, &executed);
+    return executed.explain();
+}
+
+// 并行全表扫描的块大小（行数，64 的倍数）：一块的价格、状态、分类列约 200KB，在二级缓存内过滤和核对
+static const int kMorselRows = 1 << 14;
+
+// 商品表按 kMorselRows 行切块，由工作窃取线程池并行过滤；每块先在本块内收集匹配的商品
+// （有界堆排序时只留本块的前 offset + limit 名，按ID顺序取前若干件时凑够即停），
+// 最后按块号顺序送入 sink，到达顺序与单线程扫描相同，同序的商品仍按ID升序，结果与单线程完全一致
+static void scanMorsels(const ItemStore& store, const ColumnFilter& filter, const RoaringBitmap* postings,
+                        const KeywordFilter& matchKeyword, bool exact, ResultSink& sink, int threads,
+                        size_t& examined, size_t& matched) {
+    struct Part {
+        std::vector<const Item*> items;
+        size_t examined = 0;
+        size_t matched = 0;
+    };
+    const ItemColumns& columns = store.columnar();
+    const int rows = columns.rows();
+    std::vector<Part> parts((rows + kMorselRows - 1) / kMorselRows);
+    const size_t keep = sink.partialLimit();
+    const bool ranked = sink.mode == ResultSink::TOP_K;
+    WorkStealingPool::shared().run(parts.size(), threads, [&](size_t m) {
+        Part& part = parts[m];
+        int begin = static_cast<int>(m) * kMorselRows;
+        int end = std::min(rows, begin + kMorselRows);
+        // 选择位图按行号寻址，每个线程复用自己的一份
+        static thread_local std::vector<uint64_t> selection;
+        filterColumns(columns, filter, begin, end, selection);
+        TopKCollector top(sink.order, ranked ? keep : 0);
+        for (int w = begin / 64; w < (end + 63) / 64; ++w) {
+            for (uint64_t word = selection[w]; word; word &= word - 1) {
+                int id = w * 64 + lowestSetBit(word);
+                if (postings && !postings->contains(static_cast<uint32_t>(id))) continue;
+                ++part.examined;
+                const Item* item = store.find(id);
+                if (!exact && !matchKeyword(*item)) continue;
+                ++part.matched;
+                if (ranked) {
+                    top.offer(item);
+                } else {
+                    part.items.push_back(item);
+                    if (keep > 0 && part.items.size() >= keep) return;
+                }
+            }
+        }
+        if (ranked) top.drain(part.items, 0);
+    });
+    for (const Part& part : parts) {
+        examined += part.examined;
+        matched += part.matched;
+        for (const Item* item : part.items) {
+            if (sink.satisfied()) return;
+            sink.add(item);
+        }
+    }
+}
+
+// 按计划选出的路径驱动查询，其余条件下推为过滤：候选集与选择位图按位求交或逐个查位图，
+// 价格条件在候选路径上逐个检查价格列，候选集不精确时再逐个核对关键词原文。
+ItemView SearchCriteria::select(const ItemStore& store, QueryPlan* explainPlan) const {
+    ItemView result;
+    result.generation = store.generation();
+
+    QueryPlan local;
+    QueryPlan& plan = explainPlan ? *explainPlan : local;
+    RoaringBitmap textCandidates;
+    const RoaringBitmap* postings;
+    bool exact;   // 文本索引的候选集已经精确时不必再读商品文本核对
+    std::vector<QueryTerm> terms;
+    preparePlan(*this, store, plan, textCandidates, postings, exact, terms);
+
+    const ItemColumns& columns = store.columnar();
+    const PriceIndex& prices = store.priceIndex();
+    ItemOrder order(sortBy);
+    bool descending = !order.empty() && order.keys[0] == KEY_PRICE_DESC;
+    InputOrder input = INPUT_ID_ASC;
+    if (plan.path == PATH_PRICE_ORDER) input = descending ? INPUT_PRICE_DESC : INPUT_PRICE_ASC;
+    ResultSink sink(result, sortBy, offset, limit, input);
+    KeywordFilter matchKeyword(keyword, maxDistance);
+    size_t examined = 0, matched = 0;
+    auto accept = [&store, &columns, &sink, &matchKeyword, &exact, &matched](int id) {
+        if (sink.rejectsPrice(columns.price[id])) return;
+        const Item* item = store.find(id);
+        if (exact || matchKeyword(*item)) {
+            ++matched;
+            sink.add(item);
+        }
+    };
+
+    if (plan.path == PATH_RELEVANCE) {
+        // 得分相同时按相关度之后的排序键
+        ItemOrder rest;
+        rest.keys.assign(order.keys.begin() + 1, order.keys.end());
+        RelevanceRanker ranker(store, terms, rest);
+        double lo = minPrice, hi = maxPrice;
+        bool anyPrice = prices.covers(lo, hi);
+        ranker.rank(*postings,
+                    [&columns, lo, hi, anyPrice](int id) {
+                        return anyPrice || (columns.price[id] >= lo && columns.price[id] <= hi);
+                    },
+                    [&matchKeyword, &exact](const Item& item) { return exact || matchKeyword(item); },
+                    offset, limit, result.refs, examined, matched);
+    } else if (plan.path == PATH_PRICE_ORDER) {
+        // 扫描方向与首个排序键一致，价格已经排不进结果时后面的商品只会更差
+        auto visit = [&store, &sink, &matchKeyword, &exact, &examined, &matched, postings](int id, double price) {
+            ++examined;
+            if (sink.rejectsPrice(price)) return false;
+            if (!postings || postings->contains(static_cast<uint32_t>(id))) {
+                const Item* item = store.find(id);
+                if (exact || matchKeyword(*item)) {
+                    ++matched;
+                    sink.add(item);
+                }
+            }
+            return !sink.satisfied();
+        };
+        if (descending) {
+            prices.scanDescending(minPrice, maxPrice, visit);
+        } else {
+            prices.scanAscending(minPrice, maxPrice, visit);
+        }
+    } else if (plan.path == PATH_CANDIDATES) {
+        double lo = minPrice, hi = maxPrice;
+        postings->forEach([&columns, &accept, &examined, lo, hi](uint32_t id) {
+            ++examined;
+            double p = columns.price[id];
+            if (p >= lo && p <= hi) accept(static_cast<int>(id));
+        });
+    } else if (plan.path == PATH_FILTER_KERNEL && plan.threads > 1) {
+        ColumnFilter filter;
+        filter.status = AVAILABLE;
+        filter.minPrice = minPrice;
+        filter.maxPrice = maxPrice;
+        scanMorsels(store, filter, postings, matchKeyword, exact, sink, plan.threads, examined, matched);
+    } else {
+        std::vector<uint64_t> selection;
+        if (plan.path == PATH_PRICE_RANGE) {
+            selection.assign((columns.rows() + 63) / 64, 0);
+            prices.scanAscending(minPrice, maxPrice, [&selection, &examined](int id, double) {
+                ++examined;
+                selection[id >> 6] |= uint64_t(1) << (id & 63);
+                return true;
+            });
+        } else {
+            ColumnFilter filter;
+            filter.status = AVAILABLE;
+            filter.minPrice = minPrice;
+            filter.maxPrice = maxPrice;
+            filterColumns(columns, filter, selection);
+        }
+        auto check = [&accept, &examined, &plan](int id) {
+            if (plan.path == PATH_FILTER_KERNEL) ++examined;
+            accept(id);
+        };
+        if (postings) {
+            postings->intersectDense(selection).forEach([&check](uint32_t id) {
+                check(static_cast<int>(id));
+            });
+        } else {
+            forEachSelectedRow(selection, check);
+        }
+    }
+    if (plan.path != PATH_RELEVANCE) sink.finish();
+
+    plan.executed = true;
+    plan.rowsExamined = examined;
+    plan.rowsMatched = matched;
+    plan.rowsReturned = result.size();
+    return result;
+}
+
+// 分页查询同样由 preparePlan 取出候选集、按一页的件数估计代价，再从游标位置继续读取，每次多取一件判断是否还有下一页：
+//   按ID/最新排序：有候选集时在候选位图中从游标处顺序读取；价格区间内的商品比顺序读到一页要经过的商品少时，
+//   收集区间内游标之后的商品只留最靠前的一页；否则沿可购买分区顺序读取。
+//   按价格排序：计划选中候选路径时遍历候选集，只留游标之后最靠前的一页；否则从价格索引中游标的位置起顺序读取。
+bool SearchCriteria::selectPage(const ItemStore& store, ItemPage& page) const {
+    PageOrder order;
+    if (!pageOrderFromSortBy(sortBy, order)) {
+        page.items.refs.clear();
+        page.nextCursor.clear();
+        return false;
+    }
+    PageRequest request(pageSize, order, cursor);
+    PageCursor from;
+    if (!beginPage(request, page, from)) return false;
+    page.items.generation = store.generation();
+
+    SearchCriteria paged(*this);
+    paged.offset = 0;
+    paged.limit = static_cast<size_t>(pageSize) + 1;
+    paged.threads = 1;
+    QueryPlan plan;
+    RoaringBitmap textCandidates;
+    const RoaringBitmap* postings;
+    bool exact;
+    std::vector<QueryTerm> terms;
+    preparePlan(paged, store, plan, textCandidates, postings, exact, terms);
+
+    const ItemColumns& columns = store.columnar();
+    const PriceIndex& prices = store.priceIndex();
+    KeywordFilter matchKeyword(keyword, maxDistance);
+    std::vector<const Item*>& refs = page.items.refs;
+    const size_t want = paged.limit;
+    const double lo = minPrice, hi = maxPrice;
+    auto collect = [&refs, want](const Item* item) {
+        refs.push_back(item);
+        return refs.size() < want;
+    };
+
+    if (order == ORDER_BY_ID || order == ORDER_BY_NEWEST) {
+        const bool newest = order == ORDER_BY_NEWEST;
+        const int after = std::max(from.itemId, 0);
+        // 顺序读到一页约需经过的商品数
+        double sequential = plan.estimatedRows > 0 ? want * plan.liveRows / plan.estimatedRows : plan.liveRows;
+        if (postings) {
+            // 候选位图只含可购买商品，已满足分类条件
+            auto visit = [&](uint32_t id) {
+                double p = columns.price[id];
+                if (p < lo || p > hi) return true;
+                const Item* item = store.find(static_cast<int>(id));
+                return (!exact && !matchKeyword(*item)) || collect(item);
+            };
+            if (newest) {
+                postings->scanBefore(static_cast<uint32_t>(after), visit);
+            } else {
+                postings->scanFrom(static_cast<uint32_t>(after) + 1, visit);
+            }
+        } else if (plan.priceRows < std::min(sequential, plan.liveRows)) {
+            PageBuffer buffer(order, want);
+            prices.scanAscending(lo, hi, [&](int id, double) {
+                if (newest ? id < after : id > after) {
+                    const Item* item = store.find(id);
+                    if (exact || matchKeyword(*item)) buffer.offer(item);
+                }
+                return true;
+            });
+            buffer.drainSorted(refs);
+        } else {
+            auto visit = [&](const Item& item) { return !matchesAll(*this, item, matchKeyword) || collect(&item); };
+            if (newest) {
+                store.scanAvailableBefore(from.itemId, visit);
+            } else {
+                store.scanAvailableAfter(from.itemId, visit);
+            }
+        }
+    } else if (postings && plan.path == PATH_CANDIDATES) {
+        PageBuffer buffer(order, want);
+        postings->forEach([&](uint32_t id) {
+            double p = columns.price[id];
+            if (p < lo || p > hi) return;
+            const Item* item = store.find(static_cast<int>(id));
+            if (afterCursor(from, *item) && (exact || matchKeyword(*item))) buffer.offer(item);
+        });
+        buffer.drainSorted(refs);
+    } else {
+        // 从游标价格处进入价格索引，跳过同价中已经返回过的商品
+        auto visit = [&](int id, double) {
+            const Item* item = store.find(id);
+            if (!afterCursor(from, *item)) return true;
+            if (postings && !postings->contains(static_cast<uint32_t>(id))) return true;
+            return (!exact && !matchKeyword(*item)) || collect(item);
+        };
+        if (order == ORDER_BY_PRICE_ASC) {
+            prices.scanAscending(std::max(lo, from.price), hi, visit);
+        } else {
+            prices.scanDescending(lo, std::min(hi, from.price), visit);
+        }
+    }
+    finishPage(request, page);
+    return true;
+}
 
 std::vector<Item> SearchCriteria::apply(const std::vector<Item>& allItems) const {
-    std::vector<Item> result;
-    
-    for (const auto& item : allItems) {
-        if (!item.isAvailable()) continue;
-        
-        if (item.getPrice() < minPrice || item.getPrice() > maxPrice) {
-            continue;
-        }
-        
-        if (!keyword.empty() && 
-            item.getItemName().find(keyword) == std::string::npos &&
-            item.getDescription().find(keyword) == std::string::npos) {
-            continue;
-        }
-        
-        if (!category.empty() && item.getCategory() != category) {
-            continue;
-        }
-        
-        result.push_back(item);
-    }
-    
-    if (sortBy == "price_asc") {
-        std::sort(result.begin(), result.end(), 
-                 [](const Item& a, const Item& b) { return a.getPrice() < b.getPrice(); });
-    } else if (sortBy == "price_desc") {
-        std::sort(result.begin(), result.end(), 
-                 [](const Item& a, const Item& b) { return a.getPrice() > b.getPrice(); });
-    }
-    
+    return select(ItemView::of(allItems)).toItems();
+}
+
+std::vector<Item> SearchCriteria::apply(const ItemStore& store) const {
+    return select(store).toItems();
+}
+
+ItemView SearchEngine::textSearch(const ItemView& items, const std::string& keyword) {
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    for (const Item* item : items.refs) {
+        if (item->isAvailable() && containsKeyword(*item, keyword)) {
+            result.refs.push_back(item);
+        }
+    }
     return result;
 }
 
-std::vector<Item> SearchEngine::textSearch(const std::vector<Item>& items, 
-                                          const std::string& keyword) {
-    std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.isAvailable() && 
-            (item.getItemName().find(keyword) != std::string::npos ||
-             item.getDescription().find(keyword) != std::string::npos)) {
-            result.push_back(item);
+ItemView SearchEngine::textSearch(const ItemStore& store, const std::string& keyword) {
+    SearchCriteria criteria;
+    criteria.setKeyword(keyword);
+    criteria.setPriceRange(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    return criteria.select(store);
+}
+
+ItemView SearchEngine::fuzzySearch(const ItemView& items, const std::string& keyword, int maxDistance) {
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    KeywordFilter matchKeyword(keyword, maxDistance);
+    for (const Item* item : items.refs) {
+        if (item->isAvailable() && matchKeyword(*item)) {
+            result.refs.push_back(item);
         }
     }
     return result;
 }
 
-std::vector<Item> SearchEngine::categorySearch(const std::vector<Item>& items, 
-                                              const std::string& category) {
-    std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.isAvailable() && item.getCategory() == category) {
-            result.push_back(item);
+ItemView SearchEngine::fuzzySearch(const ItemStore& store, const std::string& keyword, int maxDistance) {
+    SearchCriteria criteria;
+    criteria.setKeyword(keyword);
+    criteria.setMaxDistance(maxDistance);
+    criteria.setPriceRange(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    return criteria.select(store);
+}
+
+ItemView SearchEngine::categorySearch(const ItemView& items, const std::string& category) {
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    for (const Item* item : items.refs) {
+        if (item->isAvailable() && item->getCategory() == category) {
+            result.refs.push_back(item);
         }
     }
     return result;
 }
 
-std::vector<Item> SearchEngine::sortByPrice(const std::vector<Item>& items, 
-                                           bool ascending) {
-    std::vector<Item> result = items;
-    if (ascending) {
-        std::sort(result.begin(), result.end(), 
-                 [](const Item& a, const Item& b) { return a.getPrice() < b.getPrice(); });
+ItemView SearchEngine::imageSearch(const ItemView& items, uint64_t imageHash, size_t limit, int maxDistance) {
+    std::vector<ImageMatch> matches;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const Item& item = items[i];
+        if (!item.isAvailable() || item.imageHashes.empty()) continue;
+        int best = std::numeric_limits<int>::max();
+        for (uint64_t hash : item.imageHashes) best = std::min(best, hammingDistance(hash, imageHash));
+        // 视图里的商品不一定按ID排列，暂存下标，排序时按ID比较
+        if (best <= maxDistance) matches.push_back(ImageMatch{static_cast<int>(i), best});
+    }
+    auto closer = [&items](const ImageMatch& a, const ImageMatch& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        return items[a.itemId].getItemId() < items[b.itemId].getItemId();
+    };
+    if (limit != 0 && matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), closer);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), closer);
+    }
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    for (const ImageMatch& m : matches) result.refs.push_back(items.refs[m.itemId]);
+    return result;
+}
+
+ItemView SearchEngine::imageSearch(const ItemStore& store, uint64_t imageHash, size_t limit, int maxDistance) {
+    ItemView result;
+    result.generation = store.generation();
+    for (const ImageMatch& m : store.imageIndex().nearest(imageHash, limit, maxDistance)) {
+        result.refs.push_back(store.find(m.itemId));
+    }
+    return result;
+}
+
+ItemView SearchEngine::sortByPrice(const ItemView& items, bool ascending) {
+    return orderBy(items, ascending ? "price_asc" : "price_desc");
+}
+
+ItemView SearchEngine::orderBy(const ItemView& items, const std::string& sortBy, size_t offset, size_t limit) {
+    ItemView result;
+    result.generation = items.generation;
+    result.anchor = items.anchor;
+    ItemOrder order(sortBy);
+    if (limit > 0 && !order.empty()) {
+        // 直接从输入里选前 offset + limit 件，不复制整个指针数组
+        TopKCollector top(order, offset + limit);
+        for (const Item* item : items.refs) top.offer(item);
+        top.drain(result.refs, offset);
     } else {
-        std::sort(result.begin(), result.end(), 
-                 [](const Item& a, const Item& b) { return a.getPrice() > b.getPrice(); });
+        result.refs = items.refs;
+        orderRefs(result.refs, order, offset, limit);
     }
     return result;
-}
\ No newline at end of file
+}
+
+std::vector<Item> SearchEngine::textSearch(const std::vector<Item>& items, 
+                                          const std::string& keyword) {
+    return textSearch(ItemView::of(items), keyword).toItems();
+}
+
+std::vector<Item> SearchEngine::categorySearch(const std::vector<Item>& items, 
+                                              const std::string& category) {
+    return categorySearch(ItemView::of(items), category).toItems();
+}
+
+std::vector<Item> SearchEngine::sortByPrice(const std::vector<Item>& items, 
+                                           bool ascending) {
+    return sortByPrice(ItemView::of(items), ascending).toItems();
+}
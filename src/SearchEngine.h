@@ -4,6 +4,10 @@
 #include <vector>
 #include <string>
 #include "Item.h"
+#include "ItemStore.h"
+#include "ItemView.h"
+#include "Pagination.h"
+#include "QueryPlan.h"
 
 enum SearchType {
     TEXT_SEARCH,
@@ -12,23 +16,72 @@ enum SearchType {
 };
 
 struct SearchCriteria {
+    // 商品表少于该行数时全表扫描不值得分给多个线程
+    static const int kParallelScanMinRows = 1 << 17;
+
     std::string keyword;
+    int maxDistance;        // 关键词允许的编辑距离（按码点计，见 FuzzyPattern），0 为精确匹配
     std::string category;
     double minPrice;
     double maxPrice;
-    std::string sortBy;
+    std::string sortBy;     // "price_asc" / "price_desc" / "newest" / "relevance" 等，可用逗号组合多个键，见 ItemOrder；为空时按ID升序
+    int pageSize;           // 分页大小，selectPage 使用
+    std::string cursor;     // 上一页返回的游标
+    size_t limit;           // select/apply 最多返回的件数，0 表示不限
+    size_t offset;          // select/apply 跳过排在前面的件数
+    int threads;            // select(商品表) 全表扫描时使用的线程数，1 为单线程
+    int parallelMinRows;    // 商品表达到该行数才并行
 
     SearchCriteria();
     
     void setKeyword(const std::string& kw);
+    // 近似搜索：名称或描述中有一段与关键词的编辑距离不超过 distance 即匹配，ASCII 字母不分大小写
+    void setMaxDistance(int distance);
     void setCategory(const std::string& cat);
     void setPriceRange(double min, double max);
     void setSortBy(const std::string& sort);
+    void setPage(int size, const std::string& pageCursor = "");
+    // 只取排序后第 [skip, skip + count) 件，排序时用有界堆选出，不对全部结果排序
+    void setLimit(size_t count, size_t skip = 0);
+    // 计划选中全表扫描且商品表不少于 minRows 行时，把商品表切块交给 count 个线程并行过滤，结果与单线程相同
+    void setThreads(int count, int minRows = kParallelScanMinRows);
     
+    bool matches(const Item& item) const;
+    // 返回视图，不复制商品
+    ItemView select(const ItemView& items) const;
+    // 只查商品表的可购买商品：按各索引的统计选出代价最低的访问路径驱动，其余条件作为过滤。
+    // 传入 plan 时填入所用的计划和实际行数
+    ItemView select(const ItemStore& store, QueryPlan* plan = nullptr) const;
+    // 只估计、不执行的查询计划
+    QueryPlan plan(const ItemStore& store) const;
+    // 执行一次查询，返回计划说明：选中的路径、各路径的估计代价、各条件的估计行数以及实际行数
+    std::string explain(const ItemStore& store) const;
+    // 兼容接口，复制结果
     std::vector<Item> apply(const std::vector<Item>& allItems) const;
+    std::vector<Item> apply(const ItemStore& store) const;
+    // 按 sortBy 的顺序取一页结果，和 select 一样按计划选出候选集，从游标处继续读取，不扫描之前的页。
+    // 只支持 pageOrderFromSortBy 认得的排序（不支持按相关度分页），排序不支持或游标非法时返回 false
+    bool selectPage(const ItemStore& store, ItemPage& page) const;
 };
 
 struct SearchEngine {
+    static ItemView textSearch(const ItemView& items, const std::string& keyword);
+    // 在商品表的可购买商品中搜索名称或描述，走文本索引
+    static ItemView textSearch(const ItemStore& store, const std::string& keyword);
+    // 近似搜索，允许 maxDistance 次编辑；商品表上先用文本索引按关键词的分段剪枝
+    static ItemView fuzzySearch(const ItemView& items, const std::string& keyword, int maxDistance);
+    static ItemView fuzzySearch(const ItemStore& store, const std::string& keyword, int maxDistance);
+    static ItemView categorySearch(const ItemView& items, const std::string& category);
+    // 按图搜索：图片差异哈希与 imageHash 的汉明距离不超过 maxDistance 的可购买商品，每件商品按最近的一张图片计，
+    // 从近到远（距离相同按ID升序）取前 limit 件，limit 为 0 表示不限；商品表上走图片哈希索引
+    static ItemView imageSearch(const ItemView& items, uint64_t imageHash, size_t limit, int maxDistance);
+    static ItemView imageSearch(const ItemStore& store, uint64_t imageHash, size_t limit, int maxDistance);
+    // 只重排指针，价格相同的商品保持原有顺序
+    static ItemView sortByPrice(const ItemView& items, bool ascending = true);
+    // 按 sortBy（见 ItemOrder）排序后取第 [offset, offset + limit) 件，limit 为 0 表示不限；
+    // 排序键相同的商品保持原有顺序
+    static ItemView orderBy(const ItemView& items, const std::string& sortBy, size_t offset = 0, size_t limit = 0);
+
     static std::vector<Item> textSearch(const std::vector<Item>& items, 
                                        const std::string& keyword);
     static std::vector<Item> categorySearch(const std::vector<Item>& items, 
@@ -37,4 +90,4 @@ struct SearchEngine {
                                         bool ascending = true);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,184 @@
+#include "SessionStore.h"
+#include <chrono>
+#include <random>
+
+typedef std::lock_guard<std::mutex> ShardGuard;
+
+SessionStore::SessionStore(int seconds, Clock clock) : ttlSeconds(seconds > 0 ? seconds : 1), now(clock) {
+    // 槽数取大于 ttl 的 2 的幂，会话挂上去后转不满一圈就会被检查到
+    size_t slots = 1;
+    while (slots <= static_cast<size_t>(ttlSeconds)) slots <<= 1;
+    wheelMask = slots - 1;
+    Seconds start = now();
+    for (Shard& shard : shards) {
+        shard.wheel.resize(slots);
+        shard.clock = start;
+    }
+}
+
+SessionStore::Seconds SessionStore::steadySeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string SessionStore::create(int userId) {
+    thread_local std::random_device device;
+    Token token;
+    token.high = static_cast<uint64_t>(device()) << 32 | device();
+    token.low = static_cast<uint64_t>(device()) << 32 | device();
+    Shard& shard = shardOf(token);
+    Seconds current = now();
+    ShardGuard guard(shard.lock);
+    advance(shard, current);
+    Seconds expiresAt = current + ttlSeconds;
+    shard.sessions.insert(Session{token, userId, expiresAt});
+    shard.wheel[expiresAt & wheelMask].push_back(token);
+    return format(token);
+}
+
+int SessionStore::validate(const std::string& text) {
+    Token token;
+    if (!parse(text, token)) return 0;
+    Shard& shard = shardOf(token);
+    Seconds current = now();
+    ShardGuard guard(shard.lock);
+    Session* session = shard.sessions.find(token);
+    if (!session) return 0;
+    if (session->expiresAt <= current) {
+        shard.sessions.erase(session);
+        return 0;
+    }
+    session->expiresAt = current + ttlSeconds;
+    return session->userId;
+}
+
+// 时间轮里留下的令牌在走到时发现会话已不存在，直接跳过
+bool SessionStore::revoke(const std::string& text) {
+    Token token;
+    if (!parse(text, token)) return false;
+    Shard& shard = shardOf(token);
+    ShardGuard guard(shard.lock);
+    Session* session = shard.sessions.find(token);
+    if (!session) return false;
+    shard.sessions.erase(session);
+    return true;
+}
+
+size_t SessionStore::expire() {
+    Seconds current = now();
+    size_t removed = 0;
+    for (Shard& shard : shards) {
+        ShardGuard guard(shard.lock);
+        removed += advance(shard, current);
+    }
+    return removed;
+}
+
+size_t SessionStore::size() const {
+    size_t total = 0;
+    for (const Shard& shard : shards) {
+        ShardGuard guard(shard.lock);
+        total += shard.sessions.count;
+    }
+    return total;
+}
+
+// 依次走过 (shard.clock, current] 的每一秒；停了超过一圈时只需把每个槽走一遍
+size_t SessionStore::advance(Shard& shard, Seconds current) {
+    if (current <= shard.clock) return 0;
+    Seconds from = shard.clock + 1;
+    if (current - shard.clock > static_cast<Seconds>(wheelMask)) from = current - static_cast<Seconds>(wheelMask);
+    size_t removed = 0;
+    std::vector<Token> due;
+    for (Seconds tick = from; tick <= current; ++tick) {
+        due.clear();
+        due.swap(shard.wheel[tick & wheelMask]);
+        for (const Token& token : due) {
+            Session* session = shard.sessions.find(token);
+            if (!session) continue;
+            if (session->expiresAt <= current) {
+                shard.sessions.erase(session);
+                ++removed;
+            } else {
+                shard.wheel[session->expiresAt & wheelMask].push_back(token);
+            }
+        }
+    }
+    shard.clock = current;
+    return removed;
+}
+
+SessionStore::Session* SessionStore::Table::find(const Token& token) {
+    for (size_t i = token.high & mask(); slots[i].userId != 0; i = (i + 1) & mask()) {
+        if (slots[i].token == token) return &slots[i];
+    }
+    return nullptr;
+}
+
+// 装载率超过 3/4 时容量翻倍
+void SessionStore::Table::insert(const Session& session) {
+    if ((count + 1) * 4 > slots.size() * 3) {
+        std::vector<Session> old(slots.size() * 2);
+        old.swap(slots);
+        count = 0;
+        for (const Session& s : old) {
+            if (s.userId != 0) insert(s);
+        }
+    }
+    size_t i = session.token.high & mask();
+    while (slots[i].userId != 0) i = (i + 1) & mask();
+    slots[i] = session;
+    ++count;
+}
+
+// 向后扫描同一探测段，能前移到空位的会话前移，保证剩下的会话从各自的起点都还能探测到
+void SessionStore::Table::erase(Session* session) {
+    size_t hole = session - slots.data();
+    for (size_t i = (hole + 1) & mask(); slots[i].userId != 0; i = (i + 1) & mask()) {
+        size_t home = slots[i].token.high & mask();
+        // home 不在 (hole, i] 中时，把 i 处的会话移到 hole
+        bool movable = hole <= i ? (home <= hole || home > i) : (home <= hole && home > i);
+        if (movable) {
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole].userId = 0;
+    --count;
+}
+
+// 字符 -> 十六进制数值，非法字符为 0xff。令牌的数字是随机的，查表避免逐字符的分支预测失败
+struct HexTable {
+    uint8_t value[256];
+    HexTable() {
+        for (int c = 0; c < 256; ++c) value[c] = 0xff;
+        for (int c = '0'; c <= '9'; ++c) value[c] = static_cast<uint8_t>(c - '0');
+        for (int c = 'a'; c <= 'f'; ++c) value[c] = static_cast<uint8_t>(c - 'a' + 10);
+    }
+};
+static const HexTable hexTable;
+
+// 先把所有数字拼起来，最后统一检查有没有非法字符
+bool SessionStore::parse(const std::string& text, Token& token) {
+    if (text.size() != 32) return false;
+    uint64_t halves[2] = {0, 0};
+    unsigned invalid = 0;
+    for (size_t i = 0; i < 32; ++i) {
+        uint8_t digit = hexTable.value[static_cast<unsigned char>(text[i])];
+        invalid |= digit;
+        halves[i / 16] = halves[i / 16] << 4 | (digit & 0xf);
+    }
+    if (invalid & 0xf0) return false;
+    token.high = halves[0];
+    token.low = halves[1];
+    return true;
+}
+
+std::string SessionStore::format(const Token& token) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        text[15 - i] = digits[(token.high >> (4 * i)) & 0xf];
+        text[31 - i] = digits[(token.low >> (4 * i)) & 0xf];
+    }
+    return text;
+}
@@ -0,0 +1,84 @@
+#ifndef SESSIONSTORE_H
+#define SESSIONSTORE_H
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 登录会话：随机的不透明令牌 -> 用户ID。登录时校验一次密码并发放令牌，之后的请求只凭令牌查到用户，
+// 不再做密码比对，也不需要拿到 User 对象本身。
+// 令牌是 128 位随机数（取自 std::random_device），以 32 个十六进制字符交给客户端，猜中有效令牌的概率可以忽略。
+// 会话在 ttl 秒内没有使用即过期（每次 validate 成功都顺延），过期的令牌 validate 直接失败。
+//
+// 按令牌的低位分成 kShards 个分片，每片一把锁、一张开放寻址的哈希表，校验是对所在分片的一次加锁和一次哈希查找，O(1)，
+// 不同分片上的校验互不等待。
+// 过期回收用时间轮：每片的槽数取大于 ttl 的 2 的幂，会话按到期秒数挂在对应的槽里。
+// 时钟走过一个槽时只检查挂在里面的会话：确实到期的删除，期间被顺延的按新的到期时间挂到后面的槽，
+// 所以顺延只改会话里的到期时间，不用在槽之间搬动，回收的代价只与到期（或顺延过）的会话数成正比。
+// 时间轮在 create 时顺带推进；网络前端的事件循环每秒调用一次 expire，没有新登录时过期会话也会被回收。
+struct SessionStore {
+    static const size_t kShards = 64;
+    static const int kDefaultTtl = 30 * 60;
+    typedef long long Seconds;
+    typedef Seconds (*Clock)();
+
+    // clock 返回单调递增的秒数，默认取 steady_clock；测试可以换成可控的时钟
+    explicit SessionStore(int ttlSeconds = kDefaultTtl, Clock clock = steadySeconds);
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // 为 userId（大于 0）发放一个新令牌
+    std::string create(int userId);
+    // 令牌有效时顺延并返回用户ID，无效或已过期时返回 0
+    int validate(const std::string& token);
+    // 注销令牌，令牌无效时返回 false
+    bool revoke(const std::string& token);
+    // 把时间轮推进到当前时刻，回收已过期的会话，返回回收的个数
+    size_t expire();
+    size_t size() const;   // 尚未回收的会话数（可能包含已过期、还没走到的）
+    int ttl() const { return ttlSeconds; }
+
+    static Seconds steadySeconds();
+
+private:
+    struct Token {
+        uint64_t high;
+        uint64_t low;
+        bool operator==(const Token& other) const { return high == other.high && low == other.low; }
+    };
+    struct Session {
+        Token token;
+        int userId;         // 0 表示空位
+        Seconds expiresAt;
+    };
+    // 线性探测的开放寻址哈希表：令牌本身是随机数，直接取高位作哈希；会话就存在槽里，
+    // 一次查找通常只碰一条缓存行。删除时把后面的会话前移填补空位，不留墓碑
+    struct Table {
+        std::vector<Session> slots;
+        size_t count;
+
+        Table() : slots(16), count(0) {}
+        Session* find(const Token& token);
+        void insert(const Session& session);
+        void erase(Session* session);
+        size_t mask() const { return slots.size() - 1; }
+    };
+    struct alignas(64) Shard {
+        mutable std::mutex lock;
+        Table sessions;
+        std::vector<std::vector<Token>> wheel;
+        Seconds clock;      // 时间轮已经走到的秒
+    };
+
+    static bool parse(const std::string& text, Token& token);
+    static std::string format(const Token& token);
+    Shard& shardOf(const Token& token) { return shards[token.low & (kShards - 1)]; }
+    size_t advance(Shard& shard, Seconds now);
+
+    int ttlSeconds;
+    Clock now;
+    size_t wheelMask;
+    Shard shards[kShards];
+};
+#endif
@@ -0,0 +1,338 @@
+#include "SuggestIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <queue>
+#include <tuple>
+
+static const size_t kDefaultCapacity = 1 << 20;
+static const size_t kMinDeltaEntries = 1024;
+// 件数为 0 的短语超过该下限且占到 runs 一半时归并
+static const size_t kMinZeroesToCompact = 1024;
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// 规范化后的短语与展示写法，两者等长（只有 ASCII 字母大小写不同）。
+// keepTrailingSpace 用于前缀：“iphone ” 只匹配后面还有词的短语
+static void normalize(TextRef text, std::string& key, std::string& display, bool keepTrailingSpace) {
+    key.clear();
+    display.clear();
+    bool space = false;
+    for (char c : text) {
+        if (isSpace(c)) {
+            space = !key.empty();
+            continue;
+        }
+        if (space) {
+            key += ' ';
+            display += ' ';
+            space = false;
+        }
+        key += c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        display += c;
+    }
+    if (space && keepTrailingSpace) {
+        key += ' ';
+        display += ' ';
+    }
+    if (key.size() > SuggestIndex::kMaxPhraseBytes) {
+        // 不截断在多字节字符中间
+        size_t cut = SuggestIndex::kMaxPhraseBytes;
+        while (cut > 0 && (static_cast<unsigned char>(key[cut]) & 0xc0) == 0x80) --cut;
+        key.resize(cut);
+        display.resize(cut);
+    }
+}
+
+SuggestIndex::SuggestIndex() : leaves(1), live(0), zeroes(0), capacity(kDefaultCapacity) {
+    rebuildTree();
+}
+
+int SuggestIndex::compareKey(const Entry& e, const std::string& key, uint8_t kind) const {
+    size_t n = std::min<size_t>(e.length, key.size());
+    int c = std::memcmp(pool.data() + e.offset, key.data(), n);
+    if (c != 0) return c;
+    if (e.length != key.size()) return e.length < key.size() ? -1 : 1;
+    return e.kind == kind ? 0 : (e.kind < kind ? -1 : 1);
+}
+
+void SuggestIndex::add(TextRef name, TextRef category) {
+    adjust(name, KIND_NAME, 1);
+    adjust(category, KIND_CATEGORY, 1);
+}
+
+void SuggestIndex::remove(TextRef name, TextRef category) {
+    adjust(name, KIND_NAME, -1);
+    adjust(category, KIND_CATEGORY, -1);
+}
+
+void SuggestIndex::clear() {
+    runs.clear();
+    pool.clear();
+    delta.clear();
+    live = zeroes = 0;
+    rebuildTree();
+}
+
+void SuggestIndex::setCapacity(size_t maxPhrases) {
+    capacity = std::max<size_t>(maxPhrases, 1);
+    compact();
+}
+
+size_t SuggestIndex::deltaLimit() const {
+    size_t limit = 2 * static_cast<size_t>(std::sqrt(static_cast<double>(runs.size())));
+    return std::min(std::max(limit, kMinDeltaEntries), capacity);
+}
+
+void SuggestIndex::addBatch(const std::vector<std::pair<TextRef, TextRef>>& phrases) {
+    // 已有的短语就地加一，新短语收集起来排序去重后一次并入 delta，整批至多归并一次
+    std::vector<Pending> fresh;
+    std::string key, display;
+    auto collect = [&](TextRef text, Kind kind) {
+        normalize(text, key, display, false);
+        if (!key.empty() && !bump(key, kind, 1)) fresh.push_back(Pending{key, display, static_cast<uint8_t>(kind), 1});
+    };
+    for (const auto& p : phrases) {
+        collect(p.first, KIND_NAME);
+        collect(p.second, KIND_CATEGORY);
+    }
+    if (fresh.empty()) return;
+    auto pendingLess = [](const Pending& a, const Pending& b) { return a.key != b.key ? a.key < b.key : a.kind < b.kind; };
+    // 稳定排序，重复短语保留第一次出现时的写法
+    std::stable_sort(fresh.begin(), fresh.end(), pendingLess);
+    size_t out = 0;
+    for (size_t k = 0; k < fresh.size(); ++k) {
+        if (out > 0 && fresh[out - 1].key == fresh[k].key && fresh[out - 1].kind == fresh[k].kind) {
+            ++fresh[out - 1].count;
+        } else if (out != k) {
+            fresh[out++] = std::move(fresh[k]);
+        } else {
+            ++out;
+        }
+    }
+    fresh.resize(out);
+    live += fresh.size();
+    std::vector<Pending> merged;
+    merged.reserve(delta.size() + fresh.size());
+    std::merge(std::make_move_iterator(delta.begin()), std::make_move_iterator(delta.end()),
+               std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()),
+               std::back_inserter(merged), pendingLess);
+    delta.swap(merged);
+    if (delta.size() >= deltaLimit()) compact();
+}
+
+void SuggestIndex::adjust(TextRef text, Kind kind, int change) {
+    std::string key, display;
+    normalize(text, key, display, false);
+    if (key.empty() || bump(key, kind, change)) return;
+    // 被淘汰或从未出现的短语，减少时忽略
+    if (change < 0) return;
+    auto j = std::lower_bound(delta.begin(), delta.end(), key, [kind](const Pending& p, const std::string& k) {
+        return p.key != k ? p.key < k : p.kind < kind;
+    });
+    delta.insert(j, Pending{key, display, static_cast<uint8_t>(kind), 1});
+    ++live;
+    if (delta.size() >= deltaLimit()) compact();
+}
+
+// 修改 runs 或 delta 中已有短语的件数；短语不在其中时返回 false
+bool SuggestIndex::bump(const std::string& key, Kind kind, int change) {
+    auto i = std::lower_bound(runs.begin(), runs.end(), key,
+                              [this, kind](const Entry& e, const std::string& k) { return compareKey(e, k, kind) < 0; });
+    if (i != runs.end() && compareKey(*i, key, kind) == 0) {
+        size_t index = i - runs.begin();
+        uint32_t count = i->count;
+        if (change > 0) {
+            if (count == 0) {
+                --zeroes;
+                ++live;
+            }
+            setCount(index, count + 1);
+        } else if (count > 0) {
+            setCount(index, count - 1);
+            if (count == 1) {
+                ++zeroes;
+                --live;
+                if (zeroes >= kMinZeroesToCompact && zeroes * 2 >= runs.size()) compact();
+            }
+        }
+        return true;
+    }
+    auto j = std::lower_bound(delta.begin(), delta.end(), key, [kind](const Pending& p, const std::string& k) {
+        return p.key != k ? p.key < k : p.kind < kind;
+    });
+    if (j != delta.end() && j->key == key && j->kind == kind) {
+        if (change > 0) {
+            ++j->count;
+        } else if (--j->count == 0) {
+            delta.erase(j);
+            --live;
+        }
+        return true;
+    }
+    return false;
+}
+
+// 归并 runs 与 delta，清除件数为 0 的短语；超出容量时只保留件数最多的（同件数时短语靠前的优先）
+void SuggestIndex::compact() {
+    struct Source {
+        const char* key;
+        const char* display;
+        uint16_t length;
+        uint8_t kind;
+        uint32_t count;
+    };
+    std::vector<Source> merged;
+    merged.reserve(live);
+    auto fromRun = [this](const Entry& e) {
+        const char* key = pool.data() + e.offset;
+        return Source{key, key + e.length, e.length, e.kind, e.count};
+    };
+    auto fromDelta = [](const Pending& p) {
+        return Source{p.key.data(), p.display.data(), static_cast<uint16_t>(p.key.size()), p.kind, p.count};
+    };
+    size_t i = 0, j = 0;
+    while (i < runs.size() || j < delta.size()) {
+        if (i < runs.size() && runs[i].count == 0) {
+            ++i;
+        } else if (j == delta.size() || (i < runs.size() && compareKey(runs[i], delta[j].key, delta[j].kind) < 0)) {
+            merged.push_back(fromRun(runs[i++]));
+        } else {
+            merged.push_back(fromDelta(delta[j++]));
+        }
+    }
+    if (merged.size() > capacity) {
+        std::vector<size_t> order(merged.size());
+        for (size_t k = 0; k < order.size(); ++k) order[k] = k;
+        std::nth_element(order.begin(), order.begin() + capacity, order.end(), [&merged](size_t a, size_t b) {
+            return merged[a].count != merged[b].count ? merged[a].count > merged[b].count : a < b;
+        });
+        std::vector<char> keep(merged.size(), 0);
+        for (size_t k = 0; k < capacity; ++k) keep[order[k]] = 1;
+        size_t out = 0;
+        for (size_t k = 0; k < merged.size(); ++k) {
+            if (keep[k]) merged[out++] = merged[k];
+        }
+        merged.resize(out);
+    }
+
+    std::vector<Entry> fresh;
+    std::string freshPool;
+    fresh.reserve(merged.size());
+    for (const Source& s : merged) {
+        fresh.push_back(Entry{static_cast<uint32_t>(freshPool.size()), s.length, s.kind, s.count});
+        freshPool.append(s.key, s.length);
+        freshPool.append(s.display, s.length);
+    }
+    runs.swap(fresh);
+    pool.swap(freshPool);
+    delta.clear();
+    live = runs.size();
+    zeroes = 0;
+    rebuildTree();
+}
+
+void SuggestIndex::rebuildTree() {
+    leaves = 1;
+    while (leaves < runs.size()) leaves <<= 1;
+    tree.assign(2 * leaves, 0);
+    for (size_t k = 0; k < runs.size(); ++k) tree[leaves + k] = runs[k].count;
+    for (size_t k = leaves - 1; k > 0; --k) tree[k] = std::max(tree[2 * k], tree[2 * k + 1]);
+}
+
+void SuggestIndex::setCount(size_t index, uint32_t count) {
+    runs[index].count = count;
+    size_t node = leaves + index;
+    tree[node] = count;
+    for (node >>= 1; node > 0; node >>= 1) tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+}
+
+std::vector<Suggestion> SuggestIndex::complete(const std::string& prefix, size_t limit) const {
+    std::vector<Suggestion> out;
+    std::string key, display;
+    normalize(prefix, key, display, true);
+    if (limit == 0) return out;
+
+    auto startsWith = [this, &key](const Entry& e) {
+        return e.length >= key.size() && std::memcmp(pool.data() + e.offset, key.data(), key.size()) == 0;
+    };
+    auto lo = std::lower_bound(runs.begin(), runs.end(), key,
+                               [this](const Entry& e, const std::string& k) { return compareKey(e, k, 0) < 0; });
+    auto hi = std::partition_point(lo, runs.end(), startsWith);
+
+    // (件数, 节点覆盖的第一条, 节点, 节点覆盖的条数)：件数多的先展开，同件数时靠前的先展开，
+    // 弹出的叶子因此按 (件数降序, 短语升序) 排列
+    typedef std::tuple<uint32_t, size_t, size_t, size_t> Node;
+    auto worse = [](const Node& a, const Node& b) {
+        if (std::get<0>(a) != std::get<0>(b)) return std::get<0>(a) < std::get<0>(b);
+        return std::get<1>(a) > std::get<1>(b);
+    };
+    std::priority_queue<Node, std::vector<Node>, decltype(worse)> frontier(worse);
+    size_t l = (lo - runs.begin()) + leaves, r = (hi - runs.begin()) + leaves;
+    for (size_t span = 1; l < r; l >>= 1, r >>= 1, span <<= 1) {
+        if (l & 1) { frontier.emplace(tree[l], l * span - leaves, l, span); ++l; }
+        if (r & 1) { --r; frontier.emplace(tree[r], r * span - leaves, r, span); }
+    }
+    struct Candidate {
+        uint32_t count;
+        const char* key;
+        const char* display;
+        uint16_t length;
+        uint8_t kind;
+    };
+    std::vector<Candidate> found;
+    while (!frontier.empty() && found.size() < limit) {
+        Node top = frontier.top();
+        frontier.pop();
+        uint32_t count = std::get<0>(top);
+        size_t first = std::get<1>(top), node = std::get<2>(top), span = std::get<3>(top);
+        if (count == 0) break;
+        // 沿最大值下到叶子（相等时走左边），另一侧的子树放回待展开的节点
+        for (; span > 1; span /= 2) {
+            size_t left = 2 * node, right = left + 1;
+            if (tree[left] >= tree[right]) {
+                if (tree[right] > 0) frontier.emplace(tree[right], first + span / 2, right, span / 2);
+                node = left;
+            } else {
+                if (tree[left] > 0) frontier.emplace(tree[left], first, left, span / 2);
+                node = right;
+                first += span / 2;
+            }
+        }
+        const Entry& e = runs[first];
+        found.push_back(Candidate{count, pool.data() + e.offset, pool.data() + e.offset + e.length, e.length, e.kind});
+    }
+    // 缓冲里多是刚出现、件数很少的短语，先二分出前缀的区间，排不过已找到的第 limit 名的只看件数就跳过
+    auto first = std::lower_bound(delta.begin(), delta.end(), key,
+                                  [](const Pending& p, const std::string& k) { return p.key < k; });
+    auto last = std::partition_point(first, delta.end(),
+                                     [&key](const Pending& p) { return p.key.compare(0, key.size(), key) == 0; });
+    for (auto j = first; j != last; ++j) {
+        if (found.size() >= limit && j->count < found[limit - 1].count) continue;
+        found.push_back(Candidate{j->count, j->key.data(), j->display.data(), static_cast<uint16_t>(j->key.size()), j->kind});
+    }
+
+    auto better = [](const Candidate& a, const Candidate& b) {
+        if (a.count != b.count) return a.count > b.count;
+        int c = std::memcmp(a.key, b.key, std::min(a.length, b.length));
+        if (c != 0) return c < 0;
+        if (a.length != b.length) return a.length < b.length;
+        return a.kind < b.kind;
+    };
+    size_t keep = std::min(limit, found.size());
+    std::partial_sort(found.begin(), found.begin() + keep, found.end(), better);
+    for (size_t k = 0; k < keep; ++k) {
+        out.push_back(Suggestion{std::string(found[k].display, found[k].length), static_cast<int>(found[k].count),
+                                 found[k].kind == KIND_CATEGORY});
+    }
+    return out;
+}
+
+size_t SuggestIndex::memoryBytes() const {
+    size_t bytes = runs.capacity() * sizeof(Entry) + pool.capacity() + tree.capacity() * sizeof(uint32_t);
+    for (const Pending& p : delta) bytes += sizeof(Pending) + p.key.capacity() + p.display.capacity();
+    return bytes;
+}
@@ -0,0 +1,78 @@
+#ifndef SUGGESTINDEX_H
+#define SUGGESTINDEX_H
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "TextArena.h"
+
+// 一条输入补全建议
+struct Suggestion {
+    std::string text;    // 展示用的写法（第一件带来该短语的商品的原文，去掉多余空白）
+    int items;           // 带有该名称/分类的可购买商品数
+    bool category;       // 分类名，而不是商品名
+};
+
+// 可购买商品的名称和分类名的前缀补全索引，按带有该短语的商品数从多到少给出前 N 条。
+// 短语规范化为：去掉首尾空白、连续空白合并为一个空格、ASCII 字母转小写，超过 kMaxPhraseBytes 的部分按字符截断。
+// 前缀按同样的方式规范化后按字节比较，停在词中间甚至多字节字符中间的前缀也能命中。
+//
+// 与 PriceIndex 相同，主体是按短语排序的数组 runs（短语文本集中存放在 pool 里），
+// 新短语先进有序小缓冲 delta，缓冲满了再归并。runs 上另有一棵按件数取最大值的线段树：
+// 前缀对应 runs 的一段连续区间，从覆盖该区间的 O(log n) 个节点出发按最大值优先展开，
+// 取前 N 条只需访问 O(N log n) 个节点，与前缀命中多少短语无关。
+// 件数减到 0 的短语留在 runs 中，归并时清除。
+// 内存有上限：缓冲不超过容量，归并时短语数超过容量则只保留件数最多的 capacity 条，
+// 所以短语数至多为容量的两倍；被淘汰的短语再次出现时从 1 重新计数。
+struct SuggestIndex {
+    static const size_t kMaxPhraseBytes = 64;
+
+    SuggestIndex();
+
+    void add(TextRef name, TextRef category);
+    void remove(TextRef name, TextRef category);
+    // 一批商品的 (名称, 分类)，效果与逐个 add 相同，但新短语整批并入缓冲
+    void addBatch(const std::vector<std::pair<TextRef, TextRef>>& phrases);
+    void clear();
+    // 最多保留的短语数，立即生效
+    void setCapacity(size_t maxPhrases);
+
+    // 以 prefix 开头的前 limit 条建议，件数相同时按规范化后的短语升序
+    std::vector<Suggestion> complete(const std::string& prefix, size_t limit) const;
+    size_t size() const { return live; }
+    size_t memoryBytes() const;
+
+private:
+    enum Kind : uint8_t { KIND_NAME, KIND_CATEGORY };
+    struct Entry {
+        uint32_t offset;        // pool 中规范化短语的起点，等长的展示写法紧随其后
+        uint16_t length;
+        uint8_t kind;
+        uint32_t count;
+    };
+    struct Pending {
+        std::string key;
+        std::string display;
+        uint8_t kind;
+        uint32_t count;
+    };
+
+    void adjust(TextRef text, Kind kind, int delta);
+    bool bump(const std::string& key, Kind kind, int change);
+    int compareKey(const Entry& e, const std::string& key, uint8_t kind) const;
+    size_t deltaLimit() const;
+    void compact();
+    void rebuildTree();
+    void setCount(size_t index, uint32_t count);
+
+    std::vector<Entry> runs;       // 按 (短语, 种类) 排序
+    std::string pool;
+    std::vector<uint32_t> tree;    // 线段树，叶子从 leaves 开始
+    size_t leaves;
+    std::vector<Pending> delta;    // 按 (短语, 种类) 排序的新短语
+    size_t live;                   // 件数大于 0 的短语数
+    size_t zeroes;                 // runs 中件数为 0、等待清除的短语数
+    size_t capacity;
+};
+#endif
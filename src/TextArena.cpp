@@ -0,0 +1,62 @@
+#include "TextArena.h"
+#include <utility>
+
+const size_t TextRef::npos;
+const size_t TextArena::kChunkBytes;
+
+size_t TextRef::find(TextRef needle, size_t pos) const {
+    if (needle.len == 0) return pos <= len ? pos : npos;
+    if (pos >= len || needle.len > len - pos) return npos;
+    const char* last = ptr + len - needle.len;
+    const char* p = ptr + pos;
+    // 先用 memchr 找首字符，再比较剩余部分
+    while (p <= last) {
+        p = static_cast<const char*>(std::memchr(p, needle.ptr[0], static_cast<size_t>(last - p) + 1));
+        if (!p) return npos;
+        if (std::memcmp(p + 1, needle.ptr + 1, needle.len - 1) == 0) {
+            return static_cast<size_t>(p - ptr);
+        }
+        ++p;
+    }
+    return npos;
+}
+
+// 超过块大小 1/4 的文本单独占一块，避免浪费当前块的剩余空间
+static const size_t kLargeText = TextArena::kChunkBytes / 4;
+
+TextArena::TextArena() : cursor(nullptr), remaining(0), used(0), reserved(0) {}
+
+char* TextArena::allocate(size_t size) {
+    used += size;
+    if (size > kLargeText) {
+        chunks.emplace_back(new char[size]);
+        reserved += size;
+        return chunks.back().get();   // 当前块的 cursor 不受影响，之后继续往里追加
+    }
+    if (size > remaining) {
+        chunks.emplace_back(new char[kChunkBytes]);
+        reserved += kChunkBytes;
+        cursor = chunks.back().get();
+        remaining = kChunkBytes;
+    }
+    char* p = cursor;
+    cursor += size;
+    remaining -= size;
+    return p;
+}
+
+void TextArena::clear() {
+    chunks.clear();
+    cursor = nullptr;
+    remaining = 0;
+    used = 0;
+    reserved = 0;
+}
+
+void TextArena::swap(TextArena& other) {
+    chunks.swap(other.chunks);
+    std::swap(cursor, other.cursor);
+    std::swap(remaining, other.remaining);
+    std::swap(used, other.used);
+    std::swap(reserved, other.reserved);
+}
@@ -0,0 +1,72 @@
+#ifndef TEXTARENA_H
+#define TEXTARENA_H
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// 只读字符串视图（C++14 没有 std::string_view），不持有内存。
+// 指向记录中的文本时，在记录被修改或商品表重建文本区之前有效。
+struct TextRef {
+    static const size_t npos = std::string::npos;
+
+    const char* ptr;
+    size_t len;
+
+    TextRef() : ptr(""), len(0) {}
+    TextRef(const char* p, size_t n) : ptr(p), len(n) {}
+    TextRef(const char* s) : ptr(s), len(std::strlen(s)) {}
+    TextRef(const std::string& s) : ptr(s.data()), len(s.size()) {}
+
+    const char* data() const { return ptr; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const char* begin() const { return ptr; }
+    const char* end() const { return ptr + len; }
+    char operator[](size_t i) const { return ptr[i]; }
+
+    std::string str() const { return std::string(ptr, len); }
+    operator std::string() const { return str(); }
+
+    // 与 std::string::find 相同的语义，找不到时返回 npos
+    size_t find(TextRef needle, size_t pos = 0) const;
+};
+
+inline bool operator==(TextRef a, TextRef b) {
+    return a.len == b.len && (a.len == 0 || std::memcmp(a.ptr, b.ptr, a.len) == 0);
+}
+inline bool operator!=(TextRef a, TextRef b) { return !(a == b); }
+inline std::ostream& operator<<(std::ostream& os, TextRef text) {
+    return os.write(text.ptr, static_cast<std::streamsize>(text.len));
+}
+
+// 只追加的文本区：按 64KB 的块分配，字符串依次拷贝进块里，单个字符串不再单独 malloc。
+// 块地址不变，已写入的文本在文本区清空或销毁前一直有效；不支持单独释放，
+// 被替换的文本由使用方记为垃圾，累积到一定比例时整体重建（见 ItemStore::compact）。
+struct TextArena {
+    static const size_t kChunkBytes = 64 * 1024;
+
+    TextArena();
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+
+    // 分配 size 字节，返回的内存不需要也不能单独释放
+    char* allocate(size_t size);
+    void clear();
+    void swap(TextArena& other);
+
+    size_t usedBytes() const { return used; }          // 已写入的文本字节
+    size_t reservedBytes() const { return reserved; }  // 向系统申请的字节
+    size_t chunkCount() const { return chunks.size(); }
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* cursor;
+    size_t remaining;
+    size_t used;
+    size_t reserved;
+};
+#endif
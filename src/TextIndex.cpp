@@ -0,0 +1,332 @@
+#include "TextIndex.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+// 单字词项为码点本身，二字组为 (1 << 42) | (a << 21) | b，码点不超过 21 位，两者不会冲突
+static uint64_t unigramKey(int32_t c) { return static_cast<uint64_t>(c); }
+static uint64_t bigramKey(int32_t a, int32_t b) {
+    return (uint64_t(1) << 42) | (static_cast<uint64_t>(a) << 21) | static_cast<uint64_t>(b);
+}
+
+// 词表上的二/三字组，拉丁词只含 7 位 ASCII
+static uint32_t wordGramKey(const char* p, int n) {
+    uint32_t key = static_cast<uint32_t>(n) << 24;
+    for (int i = 0; i < n; ++i) key |= static_cast<uint32_t>(static_cast<unsigned char>(p[i])) << (8 * (n - 1 - i));
+    return key;
+}
+
+static bool isWordChar(int32_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// 把文本切成拉丁词和非 ASCII 片段，分别回调；遇到非法 UTF-8 时当作分隔符并返回 false
+template <typename OnWord, typename OnWide>
+static bool splitRuns(TextRef text, OnWord onWord, OnWide onWide) {
+    std::string word;
+    std::vector<int32_t> wide;
+    bool valid = true;
+    auto flushWord = [&]() { if (!word.empty()) { onWord(word); word.clear(); } };
+    auto flushWide = [&]() { if (!wide.empty()) { onWide(wide); wide.clear(); } };
+    size_t pos = 0;
+    while (pos < text.size()) {
+        int32_t c = decodeUtf8(text, pos);
+        if (c < 0) {
+            valid = false;
+            flushWord();
+            flushWide();
+        } else if (c < 0x80) {
+            flushWide();
+            if (isWordChar(c)) {
+                word.push_back(static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c));
+            } else {
+                flushWord();
+            }
+        } else {
+            flushWord();
+            wide.push_back(c);
+        }
+    }
+    flushWord();
+    flushWide();
+    return valid;
+}
+
+void TextIndex::collect(TextRef text, Terms& terms) const {
+    splitRuns(text,
+              [&terms](const std::string& word) { terms.words.push_back(word); },
+              [&terms](const std::vector<int32_t>& chars) {
+                  for (size_t i = 0; i < chars.size(); ++i) {
+                      terms.grams.push_back(unigramKey(chars[i]));
+                      if (i + 1 < chars.size()) terms.grams.push_back(bigramKey(chars[i], chars[i + 1]));
+                  }
+              });
+}
+
+static size_t countChars(TextRef text) {
+    size_t chars = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        decodeUtf8(text, pos);
+        ++chars;
+    }
+    return chars;
+}
+
+static void appendUtf8(std::string& out, int32_t c) {
+    if (c < 0x80) {
+        out += static_cast<char>(c);
+    } else if (c < 0x800) {
+        out += static_cast<char>(0xc0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+        out += static_cast<char>(0xe0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+    }
+}
+
+template <typename T>
+static void sortUnique(std::vector<T>& v) {
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+int TextIndex::internWord(const std::string& word) {
+    auto it = wordIds.find(word);
+    if (it != wordIds.end()) return it->second;
+    int id = static_cast<int>(words.size());
+    wordIds.emplace(word, id);
+    words.push_back(word);
+    wordItems.emplace_back();
+    wordFields.emplace_back();
+    for (int n = 2; n <= 3; ++n) {
+        for (size_t i = 0; i + n <= word.size(); ++i) {
+            wordGrams[wordGramKey(word.data() + i, n)].add(static_cast<uint32_t>(id));
+        }
+    }
+    return id;
+}
+
+// 名称和描述分别切分去重，再合并成两个字段共同的词项
+void TextIndex::collectFields(TextRef name, TextRef description, Terms& nameTerms, Terms& descTerms,
+                              Terms& all) const {
+    collect(name, nameTerms);
+    collect(description, descTerms);
+    for (Terms* t : {&nameTerms, &descTerms}) {
+        sortUnique(t->grams);
+        sortUnique(t->words);
+    }
+    std::set_union(nameTerms.grams.begin(), nameTerms.grams.end(), descTerms.grams.begin(), descTerms.grams.end(),
+                   std::back_inserter(all.grams));
+    std::set_union(nameTerms.words.begin(), nameTerms.words.end(), descTerms.words.begin(), descTerms.words.end(),
+                   std::back_inserter(all.words));
+}
+
+void TextIndex::add(int itemId, TextRef name, TextRef description) {
+    Terms nameTerms, descTerms, terms;
+    collectFields(name, description, nameTerms, descTerms, terms);
+    uint32_t id = static_cast<uint32_t>(itemId);
+    for (uint64_t key : terms.grams) grams[key].add(id);
+    for (const std::string& word : terms.words) wordItems[internWord(word)].add(id);
+    for (uint64_t key : nameTerms.grams) ++gramFields[key].name;
+    for (uint64_t key : descTerms.grams) ++gramFields[key].desc;
+    for (const std::string& word : nameTerms.words) ++wordFields[wordIds.at(word)].name;
+    for (const std::string& word : descTerms.words) ++wordFields[wordIds.at(word)].desc;
+    ++documents;
+    nameChars += countChars(name);
+    descChars += countChars(description);
+}
+
+void TextIndex::remove(int itemId, TextRef name, TextRef description) {
+    Terms nameTerms, descTerms, terms;
+    collectFields(name, description, nameTerms, descTerms, terms);
+    uint32_t id = static_cast<uint32_t>(itemId);
+    for (uint64_t key : terms.grams) {
+        auto it = grams.find(key);
+        if (it == grams.end()) continue;
+        it->second.remove(id);
+        if (it->second.empty()) {
+            grams.erase(it);
+            gramFields.erase(key);
+        }
+    }
+    for (uint64_t key : nameTerms.grams) {
+        auto it = gramFields.find(key);
+        if (it != gramFields.end() && it->second.name > 0) --it->second.name;
+    }
+    for (uint64_t key : descTerms.grams) {
+        auto it = gramFields.find(key);
+        if (it != gramFields.end() && it->second.desc > 0) --it->second.desc;
+    }
+    // 词表只增不减，词的倒排表可以为空
+    for (const std::string& word : terms.words) {
+        auto it = wordIds.find(word);
+        if (it != wordIds.end()) wordItems[it->second].remove(id);
+    }
+    for (const std::string& word : nameTerms.words) {
+        auto it = wordIds.find(word);
+        if (it != wordIds.end() && wordFields[it->second].name > 0) --wordFields[it->second].name;
+    }
+    for (const std::string& word : descTerms.words) {
+        auto it = wordIds.find(word);
+        if (it != wordIds.end() && wordFields[it->second].desc > 0) --wordFields[it->second].desc;
+    }
+    --documents;
+    nameChars -= countChars(name);
+    descChars -= countChars(description);
+}
+
+void TextIndex::clear() {
+    grams.clear();
+    wordIds.clear();
+    words.clear();
+    wordItems.clear();
+    wordGrams.clear();
+    gramFields.clear();
+    wordFields.clear();
+    documents = 0;
+    nameChars = 0;
+    descChars = 0;
+}
+
+TextStats TextIndex::stats() const {
+    TextStats s;
+    s.documents = documents;
+    s.averageNameChars = documents ? static_cast<double>(nameChars) / documents : 0;
+    s.averageDescChars = documents ? static_cast<double>(descChars) / documents : 0;
+    return s;
+}
+
+// 按基数从小到大求交，任一为空即停止
+static RoaringBitmap intersectAll(std::vector<const RoaringBitmap*>& lists) {
+    std::sort(lists.begin(), lists.end(),
+              [](const RoaringBitmap* a, const RoaringBitmap* b) { return a->cardinality() < b->cardinality(); });
+    RoaringBitmap result = *lists[0];
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        result = result.intersect(*lists[i]);
+    }
+    return result;
+}
+
+void TextIndex::wordsContaining(const std::string& fragment, std::vector<int>& out) const {
+    if (fragment.size() == 1) {
+        for (size_t w = 0; w < words.size(); ++w) {
+            if (words[w].find(fragment[0]) != std::string::npos) out.push_back(static_cast<int>(w));
+        }
+        return;
+    }
+    int n = fragment.size() == 2 ? 2 : 3;
+    std::vector<uint32_t> keys;
+    for (size_t i = 0; i + n <= fragment.size(); ++i) keys.push_back(wordGramKey(fragment.data() + i, n));
+    sortUnique(keys);
+    std::vector<const RoaringBitmap*> lists;
+    for (uint32_t key : keys) {
+        auto it = wordGrams.find(key);
+        if (it == wordGrams.end()) return;
+        lists.push_back(&it->second);
+    }
+    intersectAll(lists).forEach([this, &fragment, &out](uint32_t w) {
+        if (words[w].find(fragment) != std::string::npos) out.push_back(static_cast<int>(w));
+    });
+}
+
+bool TextIndex::candidates(const std::string& keyword, RoaringBitmap& out, bool* exact,
+                           std::vector<QueryTerm>* terms) const {
+    std::vector<std::string> latin;
+    std::vector<std::vector<int32_t>> wide;
+    bool valid = splitRuns(keyword,
+                           [&latin](const std::string& word) { latin.push_back(word); },
+                           [&wide](const std::vector<int32_t>& chars) { wide.push_back(chars); });
+    if (!valid || (latin.empty() && wide.empty())) return false;
+    if (exact) {
+        // 关键词里不能有任何 ASCII 字符（分隔符不进索引）
+        *exact = latin.empty() && wide.size() == 1 && wide[0].size() <= 2 &&
+                 std::all_of(keyword.begin(), keyword.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+    }
+
+    if (terms) terms->clear();
+    std::vector<RoaringBitmap> parts;
+    for (const auto& chars : wide) {
+        std::vector<uint64_t> keys;
+        if (chars.size() == 1) keys.push_back(unigramKey(chars[0]));
+        for (size_t i = 0; i + 1 < chars.size(); ++i) keys.push_back(bigramKey(chars[i], chars[i + 1]));
+        sortUnique(keys);
+        std::vector<const RoaringBitmap*> lists;
+        // 片段出现在某个字段时，它的每个词项都出现在该字段，取各词项计数的最小值
+        QueryTerm term;
+        term.nameDocuments = term.descDocuments = SIZE_MAX;
+        for (uint64_t key : keys) {
+            auto it = grams.find(key);
+            if (it == grams.end()) {
+                out.clear();
+                return true;
+            }
+            lists.push_back(&it->second);
+            const FieldCounts& counts = gramFields.at(key);
+            term.nameDocuments = std::min<size_t>(term.nameDocuments, counts.name);
+            term.descDocuments = std::min<size_t>(term.descDocuments, counts.desc);
+        }
+        parts.push_back(intersectAll(lists));
+        if (terms) {
+            for (int32_t c : chars) appendUtf8(term.text, c);
+            term.documents = parts.back().cardinality();
+            terms->push_back(term);
+        }
+    }
+    for (const std::string& fragment : latin) {
+        std::vector<int> matched;
+        wordsContaining(fragment, matched);
+        RoaringBitmap part;
+        if (matched.size() <= 16) {
+            for (int w : matched) part = part.empty() ? wordItems[w] : part.unite(wordItems[w]);
+        } else {
+            // 命中的词很多（如编号片段）时先摊平排序再建位图，避免反复合并
+            std::vector<uint32_t> ids;
+            for (int w : matched) wordItems[w].forEach([&ids](uint32_t id) { ids.push_back(id); });
+            sortUnique(ids);
+            for (uint32_t id : ids) part.add(id);
+        }
+        parts.push_back(std::move(part));
+        if (terms) {
+            QueryTerm term{fragment, parts.back().cardinality(), 0, 0};
+            for (int w : matched) {
+                term.nameDocuments += wordFields[w].name;
+                term.descDocuments += wordFields[w].desc;
+            }
+            terms->push_back(term);
+        }
+    }
+
+    std::vector<const RoaringBitmap*> lists;
+    for (const RoaringBitmap& part : parts) lists.push_back(&part);
+    out = intersectAll(lists);
+    return true;
+}
+
+bool TextIndex::candidatesAny(const std::vector<std::string>& fragments, RoaringBitmap& out) const {
+    out.clear();
+    for (const std::string& fragment : fragments) {
+        RoaringBitmap part;
+        if (!candidates(fragment, part)) return false;
+        out = out.empty() ? std::move(part) : out.unite(part);
+    }
+    return !fragments.empty();
+}
+
+size_t TextIndex::memoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : grams) bytes += sizeof(entry) + entry.second.memoryBytes();
+    for (const auto& entry : wordGrams) bytes += sizeof(entry) + entry.second.memoryBytes();
+    bytes += gramFields.size() * sizeof(std::pair<const uint64_t, FieldCounts>) * 2;
+    bytes += wordFields.capacity() * sizeof(FieldCounts);
+    for (const RoaringBitmap& postings : wordItems) bytes += sizeof(postings) + postings.memoryBytes();
+    for (const std::string& word : words) bytes += sizeof(word) * 2 + sizeof(int) + word.capacity();
+    return bytes;
+}
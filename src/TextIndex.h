@@ -0,0 +1,77 @@
+#ifndef TEXTINDEX_H
+#define TEXTINDEX_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "TextArena.h"
+#include "RoaringBitmap.h"
+
+// 查询中的一个片段（中文片段或转成小写的拉丁片段），相关度排序按片段计分
+struct QueryTerm {
+    std::string text;        // UTF-8
+    size_t documents;        // 可能含有该片段的商品数，用于计算逆文档频率
+    size_t nameDocuments;    // 名称/描述可能含有该片段的商品数上限，为 0 时该字段一定不含
+    size_t descDocuments;
+};
+
+// 名称和描述的语料统计，长度按字符（码点）计
+struct TextStats {
+    size_t documents;
+    double averageNameChars;
+    double averageDescChars;
+};
+
+// 商品名称和描述的倒排索引，只收录可购买的商品。
+// 文本按 UTF-8 字符切分：连续的 ASCII 字母数字组成一个拉丁词（转小写后作为词项），
+// 非 ASCII 字符（中文等）组成的片段按单字和相邻二字组作为词项，其余 ASCII 字符视为分隔符。
+// 查询同样切分，对每个片段取“可能包含它”的商品集合后求交，得到候选集，
+// 候选集是真实结果的超集，调用方还需逐个核对原文（大小写、跨片段的相邻关系等）。
+// 拉丁片段可能只是某个词的一部分（如 "Phone" 之于 "iPhone"），先用词表上的二/三字组索引
+// 找出包含该片段的词，再合并这些词的倒排表。
+struct TextIndex {
+    void add(int itemId, TextRef name, TextRef description);
+    void remove(int itemId, TextRef name, TextRef description);
+    void clear();
+
+    // 计算可能包含 keyword 的商品ID集合。keyword 中没有可索引的片段（空串、只有标点空格）
+    // 或不是合法 UTF-8 时返回 false，调用方应退回扫描。
+    // keyword 恰好是一至两个非 ASCII 字符时，候选集就是名称或描述中含有它的商品，*exact 置为 true
+    // 传入 terms 时同时给出每个片段及其文档数、在各字段中的文档数上限
+    bool candidates(const std::string& keyword, RoaringBitmap& out, bool* exact = nullptr,
+                    std::vector<QueryTerm>* terms = nullptr) const;
+    // 可能包含 fragments 中任一片段的商品ID集合（各片段候选集之并），近似搜索据此剪枝。
+    // 没有片段或任一片段不能走索引时返回 false
+    bool candidatesAny(const std::vector<std::string>& fragments, RoaringBitmap& out) const;
+    TextStats stats() const;
+
+    size_t termCount() const { return grams.size() + words.size(); }
+    size_t memoryBytes() const;
+
+private:
+    struct Terms {
+        std::vector<uint64_t> grams;
+        std::vector<std::string> words;
+    };
+    // 各词项出现在名称、描述中的商品数，相关度排序据此判断片段是否只可能出现在一个字段
+    struct FieldCounts {
+        uint32_t name = 0;
+        uint32_t desc = 0;
+    };
+    void collect(TextRef text, Terms& terms) const;
+    void collectFields(TextRef name, TextRef description, Terms& nameTerms, Terms& descTerms, Terms& all) const;
+    int internWord(const std::string& word);
+    void wordsContaining(const std::string& fragment, std::vector<int>& out) const;
+
+    std::unordered_map<uint64_t, RoaringBitmap> grams;      // 单字/二字组 -> 商品ID
+    std::unordered_map<std::string, int> wordIds;            // 拉丁词 -> 词ID
+    std::vector<std::string> words;                          // 词ID -> 拉丁词
+    std::vector<RoaringBitmap> wordItems;                    // 词ID -> 商品ID
+    std::unordered_map<uint32_t, RoaringBitmap> wordGrams;   // 词中的二/三字组 -> 词ID
+    std::unordered_map<uint64_t, FieldCounts> gramFields;    // 单字/二字组 -> 字段计数
+    std::vector<FieldCounts> wordFields;                     // 词ID -> 字段计数
+    size_t documents = 0;                                    // 已收录的商品数
+    uint64_t nameChars = 0;                                  // 已收录商品的名称/描述总字符数
+    uint64_t descChars = 0;
+};
+#endif
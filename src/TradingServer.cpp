@@ -0,0 +1,354 @@
+#include "TradingServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const size_t kReadChunk = 64 * 1024;
+static const int kMaxEvents = 256;
+
+TradingServer::TradingServer(TradingPlatform& platform, int workers)
+    : platform(platform), handler(platform), tcpPort(0), workerCount(std::max(workers, 1)), stopping(false),
+      stopRequested(false), acceptedCount(0), requestCount(0), droppedCount(0), throttledCount(0),
+      expiredCount(0) {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = eventFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, eventFd, &event);
+}
+
+TradingServer::~TradingServer() {
+    for (int fd : listeners) ::close(fd);
+    if (!unixPath.empty()) unlink(unixPath.c_str());
+    ::close(eventFd);
+    ::close(epollFd);
+}
+
+bool TradingServer::listenTcp(const std::string& host, int port) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof address);
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) return false;
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+    socklen_t length = sizeof address;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0 || listen(fd, SOMAXCONN) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(fd);
+        return false;
+    }
+    tcpPort = ntohs(address.sin_port);
+    return addListener(fd);
+}
+
+bool TradingServer::listenUnix(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof address.sun_path) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0 || listen(fd, SOMAXCONN) != 0) {
+        ::close(fd);
+        return false;
+    }
+    unixPath = path;
+    return addListener(fd);
+}
+
+bool TradingServer::addListener(int fd) {
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        ::close(fd);
+        return false;
+    }
+    listeners.push_back(fd);
+    return true;
+}
+
+void TradingServer::run() {
+    for (int i = 0; i < workerCount; ++i) workers.emplace_back(&TradingServer::workerLoop, this);
+    epoll_event events[kMaxEvents];
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point nextTick = Clock::now() + std::chrono::milliseconds(kTickMillis);
+    while (!stopRequested.load()) {
+        // 等待不超过下一次回收会话的时刻
+        Clock::time_point now = Clock::now();
+        if (now >= nextTick) {
+            expiredCount += platform.expireSessions();
+            nextTick = now + std::chrono::milliseconds(kTickMillis);
+        }
+        long long timeout = std::chrono::duration_cast<std::chrono::milliseconds>(nextTick - now).count() + 1;
+        int n = epoll_wait(epollFd, events, kMaxEvents, static_cast<int>(timeout));
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == eventFd) {
+                uint64_t count;
+                while (read(eventFd, &count, sizeof count) > 0) {}
+                drainReady();
+            } else if (std::find(listeners.begin(), listeners.end(), fd) != listeners.end()) {
+                accept(fd);
+            } else {
+                auto it = connections.find(fd);
+                if (it == connections.end()) continue;
+                ConnectionPtr conn = it->second;
+                if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) receive(conn);
+                if (conn->fd >= 0 && (events[i].events & EPOLLOUT)) flush(conn);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        stopping = true;
+        queue.clear();
+    }
+    queueReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+    while (!connections.empty()) close(connections.begin()->second);
+    ready.clear();
+}
+
+void TradingServer::stop() {
+    stopRequested.store(true);
+    wake();
+}
+
+ServerStats TradingServer::stats() const {
+    return ServerStats{acceptedCount.load(), requestCount.load(), droppedCount.load(), throttledCount.load(),
+                       expiredCount.load()};
+}
+
+void TradingServer::wake() {
+    uint64_t one = 1;
+    ssize_t written = write(eventFd, &one, sizeof one);
+    (void)written;
+}
+
+void TradingServer::accept(int listener) {
+    for (;;) {
+        int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+        // Unix 域套接字上会失败，忽略即可
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd] = std::make_shared<Connection>(fd);
+        ++acceptedCount;
+    }
+}
+
+// 边沿触发：读到 EAGAIN 为止，每读一块就切出完整的帧交给工作线程；帧不合法时不再处理该连接上的后续数据。
+// 积压超过上限时停在这里并停止关注可读事件，剩下的数据留在内核里，flush 把积压发出去后再恢复
+void TradingServer::receive(const ConnectionPtr& conn) {
+    if (conn->paused) return;
+    char buffer[kReadChunk];
+    for (;;) {
+        ssize_t n = read(conn->fd, buffer, sizeof buffer);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) return;
+        bool eof = n <= 0;
+        if (n > 0) conn->input.append(buffer, static_cast<size_t>(n));
+
+        std::deque<WireFrame> frames;
+        size_t consumed = 0;
+        for (;;) {
+            WireFrame frame;
+            long used = parseFrame(conn->input.data() + consumed, conn->input.size() - consumed, frame);
+            if (used == 0) break;
+            if (used < 0) {
+                ++droppedCount;
+                eof = true;
+                consumed = conn->input.size();
+                break;
+            }
+            consumed += static_cast<size_t>(used);
+            frames.push_back(std::move(frame));
+        }
+        conn->input.erase(0, consumed);
+
+        bool schedule = false;
+        bool idle;
+        bool throttle;
+        {
+            std::lock_guard<std::mutex> guard(conn->lock);
+            for (WireFrame& frame : frames) conn->pending.push_back(std::move(frame));
+            if (eof) conn->closing = true;
+            if (!conn->busy && !conn->pending.empty()) {
+                conn->busy = true;
+                schedule = true;
+            }
+            idle = !conn->busy;
+            throttle = conn->backlogged(1);
+        }
+        if (schedule) {
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                queue.push_back(conn);
+            }
+            queueReady.notify_one();
+        }
+        if (eof) {
+            if (idle) flush(conn);
+            return;
+        }
+        if (throttle) {
+            conn->paused = true;
+            watch(conn, false);
+            ++throttledCount;
+            return;
+        }
+    }
+}
+
+// 把工作线程写好的响应交给内核；连接正在关闭且没有剩下要处理、要发送的内容时关闭
+void TradingServer::flush(const ConnectionPtr& conn) {
+    bool closing;
+    bool busy;
+    {
+        std::lock_guard<std::mutex> guard(conn->lock);
+        if (conn->sending.empty()) {
+            conn->sending.swap(conn->outbox);
+        } else {
+            conn->sending += conn->outbox;
+            conn->outbox.clear();
+        }
+        closing = conn->closing;
+        busy = conn->busy;
+    }
+    size_t sent = 0;
+    while (sent < conn->sending.size()) {
+        ssize_t n = send(conn->fd, conn->sending.data() + sent, conn->sending.size() - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && errno == EAGAIN) {
+            break;
+        } else {
+            // 对端已经不收了，剩下的响应直接丢掉
+            sent = conn->sending.size();
+            std::lock_guard<std::mutex> guard(conn->lock);
+            conn->closing = closing = true;
+        }
+    }
+    conn->sending.erase(0, sent);
+    if (closing && !busy && conn->sending.empty()) {
+        close(conn);
+        return;
+    }
+    if (conn->paused) {
+        bool resume;
+        {
+            std::lock_guard<std::mutex> guard(conn->lock);
+            resume = !conn->backlogged(2);
+        }
+        if (resume) {
+            conn->paused = false;
+            watch(conn, true);
+        }
+    }
+}
+
+// 修改关注的事件后，已经就绪的事件会重新报告一次，暂停期间到达的数据不会漏读
+void TradingServer::watch(const ConnectionPtr& conn, bool reading) {
+    epoll_event event;
+    event.events = EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    if (reading) event.events |= EPOLLIN;
+    event.data.fd = conn->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, conn->fd, &event);
+}
+
+// conn 可能就是 connections 中的那一份，先留一份引用再从表中删除
+void TradingServer::close(const ConnectionPtr& conn) {
+    ConnectionPtr keep = conn;
+    if (keep->fd < 0) return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, keep->fd, nullptr);
+    ::close(keep->fd);
+    connections.erase(keep->fd);
+    keep->fd = -1;
+}
+
+void TradingServer::drainReady() {
+    std::vector<ConnectionPtr> batch;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        batch.swap(ready);
+    }
+    for (const ConnectionPtr& conn : batch) {
+        if (conn->fd >= 0) flush(conn);
+    }
+}
+
+void TradingServer::workerLoop() {
+    for (;;) {
+        ConnectionPtr conn;
+        {
+            std::unique_lock<std::mutex> lock(queueLock);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            conn = queue.front();
+            queue.pop_front();
+        }
+        serve(conn);
+    }
+}
+
+// 一次取走连接上全部已到达的请求依次处理，写好的响应整批交给事件循环；没有新请求时释放连接
+void TradingServer::serve(const ConnectionPtr& conn) {
+    std::deque<WireFrame> batch;
+    std::string out;
+    for (;;) {
+        bool notify;
+        {
+            std::lock_guard<std::mutex> guard(conn->lock);
+            if (!out.empty()) conn->outbox += out;
+            if (conn->pending.empty()) {
+                conn->busy = false;
+                notify = !out.empty() || conn->closing;
+            } else {
+                batch.swap(conn->pending);
+                notify = !out.empty();
+            }
+        }
+        if (notify) {
+            bool first;
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                first = ready.empty();
+                ready.push_back(conn);
+            }
+            if (first) wake();
+        }
+        if (batch.empty()) return;
+        out.clear();
+        for (const WireFrame& frame : batch) handler.handle(conn->session, frame, out);
+        requestCount += batch.size();
+        batch.clear();
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef TRADINGSERVER_H
+#define TRADINGSERVER_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "Platform.h"
+#include "RequestHandler.h"
+#include "WireProtocol.h"
+
+struct ServerStats {
+    unsigned long long accepted;    // 接受的连接数
+    unsigned long long requests;    // 处理的请求数
+    unsigned long long dropped;     // 因帧不合法断开的连接数
+    unsigned long long throttled;   // 因积压暂停读取的次数
+    unsigned long long expired;     // 定时回收的过期会话数
+};
+
+// TradingPlatform 的网络前端（仅 Linux）：一个事件循环线程用 epoll（边沿触发）接受连接、收发数据，
+// 收到的完整请求帧交给工作线程池执行，平台调用不会阻塞事件循环。
+// 同一连接的请求由同一时刻至多一个工作线程按到达顺序处理：工作线程一次取走该连接全部已到达的请求，
+// 响应依次写入连接的发送缓冲后通过 eventfd 通知事件循环发出，流水线上的多个请求只需一次唤醒、一次 write。
+// 不同连接的请求在不同工作线程上并行。事件循环每隔 kTickMillis 毫秒回收一次过期的登录会话。
+// 一个连接积压的请求数或待发响应的字节数超过上限时暂停读取它，积压降到上限的一半以下再恢复；
+// 对端只发不收时由 TCP 流量控制挡在内核缓冲里，服务器为每个连接占用的内存有界。
+struct TradingServer {
+    static const size_t kPendingHighWater = 1024;      // 等待处理的请求数
+    static const size_t kOutboxHighWater = 4 << 20;    // 等待发出的响应字节数
+    static const int kTickMillis = 1000;
+
+
+    TradingServer(TradingPlatform& platform, int workers);
+    ~TradingServer();
+    TradingServer(const TradingServer&) = delete;
+    TradingServer& operator=(const TradingServer&) = delete;
+
+    // 监听 TCP 端口，port 为 0 时由系统分配（之后用 port() 查询）；失败时返回 false
+    bool listenTcp(const std::string& host, int port);
+    // 监听 Unix 域套接字，已存在的同名文件会先删除
+    bool listenUnix(const std::string& path);
+    int port() const { return tcpPort; }
+
+    // 运行事件循环直到 stop()，在调用线程上执行
+    void run();
+    // 可以从任何线程或信号处理函数中调用；run() 随后关闭全部连接并返回
+    void stop();
+    ServerStats stats() const;
+
+private:
+    struct Connection {
+        int fd;
+        WireSession session;           // 只由正在处理本连接的工作线程访问
+        std::string input;             // 未凑成完整帧的字节，只由事件循环访问
+        std::string sending;           // 已交给内核前的待发字节，只由事件循环访问
+        std::mutex lock;               // 保护以下成员
+        std::deque<WireFrame> pending; // 已到达、等待处理的请求
+        std::string outbox;            // 工作线程写好、等待事件循环发出的响应
+        bool busy;                     // 已交给工作线程
+        bool closing;                  // 对端已关闭或出错，处理完手头的请求后关闭
+        bool paused;                   // 积压过多、已停止关注可读事件，只由事件循环访问
+
+        explicit Connection(int socket) : fd(socket), busy(false), closing(false), paused(false) {}
+        // 积压超过上限的 1/divisor；在事件循环上持有 lock 时调用
+        bool backlogged(size_t divisor) const {
+            return pending.size() > kPendingHighWater / divisor ||
+                   outbox.size() + sending.size() > kOutboxHighWater / divisor;
+        }
+    };
+    typedef std::shared_ptr<Connection> ConnectionPtr;
+
+    bool addListener(int fd);
+    void accept(int listener);
+    void receive(const ConnectionPtr& conn);
+    void flush(const ConnectionPtr& conn);
+    void close(const ConnectionPtr& conn);
+    // 边沿触发地关注可写和对端关闭，reading 为 true 时同时关注可读
+    void watch(const ConnectionPtr& conn, bool reading);
+    void drainReady();
+    void workerLoop();
+    void serve(const ConnectionPtr& conn);
+    void wake();
+
+    TradingPlatform& platform;
+    RequestHandler handler;
+    int epollFd;
+    int eventFd;
+    int tcpPort;
+    std::vector<int> listeners;
+    std::string unixPath;
+    std::unordered_map<int, ConnectionPtr> connections;   // 只由事件循环访问
+
+    int workerCount;
+    std::vector<std::thread> workers;
+    std::mutex queueLock;
+    std::condition_variable queueReady;
+    std::deque<ConnectionPtr> queue;     // 等待工作线程处理的连接
+    std::vector<ConnectionPtr> ready;    // 有响应待发或需要关闭的连接，由 queueLock 保护
+    bool stopping;                       // 由 queueLock 保护
+    std::atomic<bool> stopRequested;
+
+    std::atomic<unsigned long long> acceptedCount;
+    std::atomic<unsigned long long> requestCount;
+    std::atomic<unsigned long long> droppedCount;
+    std::atomic<unsigned long long> throttledCount;
+    std::atomic<unsigned long long> expiredCount;
+};
+#endif
@@ -3,29 +3,38 @@
 #include <algorithm> 
 
 User::User(int id, const std::string& uname, const std::string& pwd, const std::string& em, const std::string& ph, const std::string& sId, const std::string& rName, const std::string& col, UserRole r) : 
-    userId(id), username(uname), password(pwd), email(em), phone(ph), studentId(sId), realName(rName), college(col), role(r) {}
+    userId(id), text({uname, pwd, em, ph, sId, rName, col}), role(r) {}
+
+std::shared_ptr<User> User::clone() const { return std::make_shared<User>(*this); }
 
 int User::getUserId() const { return userId; }
-std::string User::getUsername() const { return username; }
-std::string User::getEmail() const { return email; }
+TextRef User::getUsername() const { return text.field(USERNAME); }
+TextRef User::getEmail() const { return text.field(EMAIL); }
+TextRef User::getPhone() const { return text.field(PHONE); }
 UserRole User::getRole() const { return role; }
 
 bool User::login(const std::string& inputPassword) const { 
-    return password == inputPassword;
+    return text.field(PASSWORD) == inputPassword;
 }
 
 void User::resetPassword(const std::string& newPassword) { 
-    password = newPassword; 
+    text.assign({text.field(USERNAME), newPassword, text.field(EMAIL), text.field(PHONE),
+                 text.field(STUDENT_ID), text.field(REAL_NAME), text.field(COLLEGE)});
+}
+
+void User::updateProfile(const std::string& phone, const std::string& email, const std::string& password) {
+    text.assign({text.field(USERNAME), password, email, phone,
+                 text.field(STUDENT_ID), text.field(REAL_NAME), text.field(COLLEGE)});
 }
 
 void User::displayProfile() const { 
     std::cout << "用户ID: " << userId << "\n";
-    std::cout << "用户名: " << username << "\n";
-    std::cout << "邮箱: " << email << "\n";
-    std::cout << "手机: " << phone << "\n";
-    std::cout << "学号: " << studentId << "\n";
-    std::cout << "真实姓名: " << realName << "\n";
-    std::cout << "学院: " << college << "\n";
+    std::cout << "用户名: " << text.field(USERNAME) << "\n";
+    std::cout << "邮箱: " << text.field(EMAIL) << "\n";
+    std::cout << "手机: " << text.field(PHONE) << "\n";
+    std::cout << "学号: " << text.field(STUDENT_ID) << "\n";
+    std::cout << "真实姓名: " << text.field(REAL_NAME) << "\n";
+    std::cout << "学院: " << text.field(COLLEGE) << "\n";
     std::string roleStr = (role == ADMIN) ? "管理员" : "普通用户";
     std::cout << "角色: " << roleStr << "\n";
 }
@@ -33,6 +42,8 @@ void User::displayProfile() const {
 RegularUser::RegularUser(int id, const std::string& uname, const std::string& pwd, const std::string& email, const std::string& phone, const std::string& studentId, const std::string& realName, const std::string& college) : 
     User(id, uname, pwd, email, phone, studentId, realName, college, REGULAR_USER) {}
 
+std::shared_ptr<User> RegularUser::clone() const { return std::make_shared<RegularUser>(*this); }
+
 void RegularUser::publishItem(const Item& item) { 
     publishedItems.push_back(item.getItemId()); 
 }
@@ -98,4 +109,6 @@ void RegularUser::displayProfile() const {
 }
 
 Admin::Admin(int id, const std::string& uname, const std::string& pwd, const std::string& email) : 
-    User(id, uname, pwd, email, "", "", "", "", ADMIN) {}
\ No newline at end of file
+    User(id, uname, pwd, email, "", "", "", "", ADMIN) {}
+
+std::shared_ptr<User> Admin::clone() const { return std::make_shared<Admin>(*this); }
@@ -2,29 +2,34 @@
 #define USER_H
 #include <string>
 #include <vector>
+#include <memory>
 #include "Item.h"
+#include "RecordText.h"
 
 enum UserRole { REGULAR_USER, ADMIN };
 
 struct User {
+    // text 中各字段的下标
+    enum TextField { USERNAME, PASSWORD, EMAIL, PHONE, STUDENT_ID, REAL_NAME, COLLEGE, kTextFields };
+
     int userId;
-    std::string username;
-    std::string password;
-    std::string email;
-    std::string phone;
-    std::string studentId;
-    std::string realName;
-    std::string college;
+    RecordText<kTextFields> text;   // 七个文本字段连续存放，只分配一次
     UserRole role;
 
     User(int id, const std::string& uname, const std::string& pwd, const std::string& email, const std::string& phone, const std::string& studentId, const std::string& realName, const std::string& college, UserRole role);
     virtual ~User() = default;
+    // 复制一份用户（包括各商品列表），副本的文本自己持有
+    virtual std::shared_ptr<User> clone() const;
     int getUserId() const;
-    std::string getUsername() const;
-    std::string getEmail() const;
+    // 文本字段指向 text，updateProfile / resetPassword 会重建 text，之前取得的 TextRef 随之失效。
+    // 平台中的用户由 TradingPlatform 持锁修改，对外只给出 findUserById 的副本
+    TextRef getUsername() const;
+    TextRef getEmail() const;
+    TextRef getPhone() const;
     UserRole getRole() const;
     bool login(const std::string& inputPassword) const;
     void resetPassword(const std::string& newPassword);
+    void updateProfile(const std::string& phone, const std::string& email, const std::string& password);
     virtual void displayProfile() const;
 };
 
@@ -35,6 +40,7 @@ struct RegularUser : User {
     std::vector<int> favorites;     // 收藏商品ID
 
     RegularUser(int id, const std::string& uname, const std::string& pwd, const std::string& email, const std::string& phone, const std::string& studentId, const std::string& realName, const std::string& college);
+    std::shared_ptr<User> clone() const override;
     void publishItem(const Item& item);
     std::vector<int> getPublishedItems() const;
     void addPurchasedItem(int itemId);
@@ -47,6 +53,7 @@ struct RegularUser : User {
 
 struct Admin : User {
     Admin(int id, const std::string& uname, const std::string& pwd, const std::string& email);
+    std::shared_ptr<User> clone() const override;
     // 简化：删除了未实现的接口，管理员操作通过 TradingPlatform 接口完成。
     // void deleteItem(int itemId);
     // void viewUserInfo(int userId);
@@ -0,0 +1,44 @@
+#ifndef UTF8_H
+#define UTF8_H
+#include <cstdint>
+#include <cstddef>
+#include "TextArena.h"
+
+// 解码 text 中从 pos 开始的一个 UTF-8 字符，返回码点并把 pos 移到下一个字符。
+// 非法或不完整的序列（包括超长编码和代理区码点）返回 -1，pos 只前进一个字节。
+inline int32_t decodeUtf8(TextRef text, size_t& pos) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text.data());
+    size_t n = text.size();
+    unsigned char c = s[pos];
+    if (c < 0x80) {
+        ++pos;
+        return c;
+    }
+    int extra;
+    int32_t cp;
+    int32_t minimum;
+    if ((c & 0xe0) == 0xc0) { extra = 1; cp = c & 0x1f; minimum = 0x80; }
+    else if ((c & 0xf0) == 0xe0) { extra = 2; cp = c & 0x0f; minimum = 0x800; }
+    else if ((c & 0xf8) == 0xf0) { extra = 3; cp = c & 0x07; minimum = 0x10000; }
+    else { ++pos; return -1; }
+
+    if (pos + extra >= n) { ++pos; return -1; }
+    for (int i = 1; i <= extra; ++i) {
+        unsigned char next = s[pos + i];
+        if ((next & 0xc0) != 0x80) { ++pos; return -1; }
+        cp = (cp << 6) | (next & 0x3f);
+    }
+    if (cp < minimum || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) { ++pos; return -1; }
+    pos += extra + 1;
+    return cp;
+}
+
+// 整段文本都是合法的 UTF-8
+inline bool isValidUtf8(TextRef text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        if (decodeUtf8(text, pos) < 0) return false;
+    }
+    return true;
+}
+#endif
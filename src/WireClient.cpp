@@ -0,0 +1,113 @@
+#include "WireClient.h"
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+bool readItem(WireReader& in, WireItem& item) {
+    int32_t itemId = 0, sellerId = 0;
+    in.i32(itemId), in.str(item.name), in.str(item.description), in.str(item.category);
+    in.f64(item.price), in.u8(item.status), in.i32(sellerId), in.str(item.publishDate);
+    item.itemId = itemId;
+    item.sellerId = sellerId;
+    return in.ok;
+}
+
+bool readPage(WireReader& in, std::vector<WireItem>& items, std::string& nextCursor) {
+    uint32_t count = 0;
+    if (!in.u32(count)) return false;
+    items.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        WireItem item;
+        if (!readItem(in, item)) return false;
+        items.push_back(item);
+    }
+    return in.str(nextCursor);
+}
+
+WireClient::WireClient() : fd(-1), nextId(1) {}
+
+WireClient::~WireClient() { close(); }
+
+bool WireClient::connectTcp(const std::string& host, int port) {
+    close();
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof address);
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) return false;
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0) {
+        close();
+        return false;
+    }
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    return true;
+}
+
+bool WireClient::connectUnix(const std::string& path) {
+    close();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof address.sun_path) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void WireClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    input.clear();
+    output.clear();
+}
+
+void WireClient::send(uint32_t requestId, uint8_t op, const std::string& body) {
+    appendFrame(output, requestId, op, body);
+}
+
+bool WireClient::flush() {
+    size_t sent = 0;
+    while (sent < output.size()) {
+        ssize_t n = ::send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    output.clear();
+    return true;
+}
+
+bool WireClient::receive(WireFrame& response) {
+    if (fd < 0 || !flush()) return false;
+    char buffer[64 * 1024];
+    for (;;) {
+        long used = parseFrame(input.data(), input.size(), response);
+        if (used < 0) return false;
+        if (used > 0) {
+            input.erase(0, static_cast<size_t>(used));
+            return true;
+        }
+        ssize_t n = read(fd, buffer, sizeof buffer);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        input.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+bool WireClient::call(uint8_t op, const std::string& body, WireFrame& response) {
+    send(nextId++, op, body);
+    return receive(response);
+}
@@ -0,0 +1,49 @@
+#ifndef WIRECLIENT_H
+#define WIRECLIENT_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "WireProtocol.h"
+
+// 响应中解码出的一件商品
+struct WireItem {
+    int itemId;
+    std::string name;
+    std::string description;
+    std::string category;
+    double price;
+    uint8_t status;
+    int sellerId;
+    std::string publishDate;
+};
+
+bool readItem(WireReader& in, WireItem& item);
+bool readPage(WireReader& in, std::vector<WireItem>& items, std::string& nextCursor);
+
+// TradingServer 协议的阻塞式客户端（仅 Linux），供测试、压测和脚本使用；一个对象只能由一个线程使用。
+// send 只把请求写入本地缓冲，receive 前一次发出，连续 send 多个请求即为流水线
+struct WireClient {
+    WireClient();
+    ~WireClient();
+    WireClient(const WireClient&) = delete;
+    WireClient& operator=(const WireClient&) = delete;
+
+    bool connectTcp(const std::string& host, int port);
+    bool connectUnix(const std::string& path);
+    void close();
+
+    void send(uint32_t requestId, uint8_t op, const std::string& body);
+    // 发出缓冲中的请求；连接断开时返回 false
+    bool flush();
+    // 等待下一个响应；连接断开或收到非法帧时返回 false
+    bool receive(WireFrame& response);
+    // 发出一个请求并等待响应，请求号自动分配
+    bool call(uint8_t op, const std::string& body, WireFrame& response);
+
+private:
+    int fd;
+    uint32_t nextId;
+    std::string input;
+    std::string output;
+};
+#endif
@@ -0,0 +1,136 @@
+#include "WireProtocol.h"
+#include <cstring>
+
+void WireWriter::u32(uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    buffer.append(bytes, 4);
+}
+
+void WireWriter::u64(uint64_t value) {
+    u32(static_cast<uint32_t>(value));
+    u32(static_cast<uint32_t>(value >> 32));
+}
+
+void WireWriter::f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    u64(bits);
+}
+
+void WireWriter::str(TextRef text) {
+    u32(static_cast<uint32_t>(text.size()));
+    buffer.append(text.data(), text.size());
+}
+
+void WireWriter::ids(const std::vector<int>& values) {
+    u32(static_cast<uint32_t>(values.size()));
+    for (int value : values) i32(value);
+}
+
+const char* WireReader::take(size_t n) {
+    if (!ok || size - pos < n) {
+        ok = false;
+        return nullptr;
+    }
+    const char* p = data + pos;
+    pos += n;
+    return p;
+}
+
+bool WireReader::u8(uint8_t& value) {
+    const char* p = take(1);
+    if (!p) return false;
+    value = static_cast<uint8_t>(*p);
+    return true;
+}
+
+bool WireReader::u32(uint32_t& value) {
+    const char* p = take(4);
+    if (!p) return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+    return true;
+}
+
+bool WireReader::u64(uint64_t& value) {
+    uint32_t low, high;
+    if (!u32(low) || !u32(high)) return false;
+    value = static_cast<uint64_t>(high) << 32 | low;
+    return true;
+}
+
+bool WireReader::i32(int32_t& value) {
+    uint32_t bits;
+    if (!u32(bits)) return false;
+    value = static_cast<int32_t>(bits);
+    return true;
+}
+
+bool WireReader::f64(double& value) {
+    uint64_t bits;
+    if (!u64(bits)) return false;
+    std::memcpy(&value, &bits, sizeof value);
+    return true;
+}
+
+bool WireReader::str(std::string& value) {
+    uint32_t length;
+    if (!u32(length)) return false;
+    const char* p = take(length);
+    if (!p) return false;
+    value.assign(p, length);
+    return true;
+}
+
+bool WireReader::ids(std::vector<int>& values) {
+    uint32_t n;
+    if (!u32(n) || n > (size - pos) / 4) {
+        ok = false;
+        return false;
+    }
+    values.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        int32_t value;
+        if (!i32(value)) return false;
+        values[i] = value;
+    }
+    return ok;
+}
+
+void appendFrame(std::string& out, uint32_t requestId, uint8_t code, const std::string& body) {
+    size_t start = beginFrame(out, requestId, code);
+    out += body;
+    endFrame(out, start);
+}
+
+// 长度字段先占位，内容写完后回填
+size_t beginFrame(std::string& out, uint32_t requestId, uint8_t code) {
+    size_t start = out.size();
+    WireWriter writer(out);
+    writer.u32(0);
+    writer.u32(requestId);
+    writer.u8(code);
+    return start;
+}
+
+void endFrame(std::string& out, size_t start) {
+    uint32_t length = static_cast<uint32_t>(out.size() - start - 4);
+    for (int i = 0; i < 4; ++i) out[start + i] = static_cast<char>((length >> (8 * i)) & 0xff);
+}
+
+long parseFrame(const char* data, size_t size, WireFrame& frame) {
+    WireReader reader(data, size);
+    uint32_t length;
+    if (!reader.u32(length)) return 0;
+    if (length < kWireHeader - 4 || length > kWireMaxFrame) return -1;
+    if (size - 4 < length) return 0;
+    uint32_t requestId;
+    uint8_t code;
+    reader.u32(requestId);
+    reader.u8(code);
+    frame.requestId = requestId;
+    frame.code = code;
+    frame.body.assign(data + kWireHeader, length - (kWireHeader - 4));
+    return static_cast<long>(4 + length);
+}
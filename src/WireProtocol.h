@@ -0,0 +1,111 @@
+#ifndef WIREPROTOCOL_H
+#define WIREPROTOCOL_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "TextArena.h"
+
+// 网络前端的二进制协议。整数一律小端，一帧为：
+//   u32 长度（其后的字节数） | u32 请求号 | u8 操作码（请求）或状态码（响应） | 内容
+// 请求号由客户端选定，响应原样带回。同一连接上可以连续发出多个请求而不等待响应（流水线），
+// 服务器按请求到达的顺序处理并按同样的顺序返回响应。
+// 内容由以下字段依次拼接：u8、i32、u32、f64（IEEE 754 位模式）、字符串（u32 字节数 + 字节）。
+// 各操作的内容格式见 WireOp 的注释，响应的状态码不是 WIRE_OK 时没有内容（结账失败除外）。
+// 商品编码为：i32 ID、字符串 名称、描述、分类、f64 价格、u8 状态、i32 卖家ID、字符串 发布日期；
+// 一页商品编码为：u32 件数、各件商品、字符串 下一页游标（为空表示最后一页）。
+enum WireOp : uint8_t {
+    WIRE_PING = 0,             // 空 -> 空
+    WIRE_REGISTER = 1,         // 用户名、密码、邮箱、手机、学号、姓名、学院 -> 空
+    WIRE_LOGIN = 2,            // 邮箱、密码 -> i32 用户ID、u8 角色、令牌；之后本连接上的请求以该用户身份执行
+    WIRE_LOGOUT = 3,           // 空 -> 空，令牌随之失效
+    WIRE_BROWSE = 4,           // u8 PageOrder、i32 页大小（不超过 kWirePageLimit）、游标 -> 一页商品
+    WIRE_SEARCH = 5,           // 关键词、分类、f64 最低价、f64 最高价、排序、i32 页大小、游标 -> 一页商品
+    WIRE_ITEM_DETAIL = 6,      // i32 商品ID -> 商品
+    WIRE_SUGGEST = 7,          // 前缀、u32 条数（不超过 kWirePageLimit） -> u32 条数，每条：字符串、i32 件数、u8 是否分类
+    WIRE_PUBLISH = 8,          // 名称、描述、分类、f64 价格 -> i32 商品ID
+    WIRE_UPDATE_ITEM = 9,      // i32 商品ID、名称、描述、分类、f64 价格 -> 空
+    WIRE_DELETE_ITEM = 10,     // i32 商品ID -> 空（卖家本人或管理员）
+    WIRE_PURCHASE = 11,        // i32 商品ID -> 空
+    WIRE_ADD_TO_CART = 12,     // i32 商品ID -> 空
+    WIRE_REMOVE_FROM_CART = 13,
+    WIRE_ADD_FAVORITE = 14,
+    WIRE_REMOVE_FAVORITE = 15,
+    WIRE_LIST = 16,            // u8 UserItemList -> u32 件数、各件商品ID
+    WIRE_CHECKOUT = 17,        // 空 -> u32 件数、买不到的商品ID（失败时状态为 WIRE_FAILED，仍带这份列表）
+    WIRE_ADMIN_BROWSE_ALL = 18,// u8 PageOrder、i32 页大小、游标 -> 一页商品（含已下架）
+    WIRE_ADMIN_STATS = 19,     // 空 -> i32 用户数、商品数、可购买、已售出、已删除、墓碑数，u64 缓存命中、未命中
+    WIRE_ADMIN_COMPACT = 20,   // 空 -> i32 清除的墓碑数
+    WIRE_RESUME = 21,          // 令牌 -> i32 用户ID、u8 角色；在新连接上沿用已登录的会话，不再发送密码
+    kWireOps
+};
+
+enum WireStatus : uint8_t {
+    WIRE_OK = 0,
+    WIRE_FAILED = 1,           // 操作本身失败（密码错误、商品已售出、游标非法等）
+    WIRE_MALFORMED = 2,        // 内容无法按该操作的格式解析
+    WIRE_UNKNOWN_OP = 3,
+    WIRE_NOT_LOGGED_IN = 4,    // 未登录，或会话已过期、已在别处注销
+    WIRE_FORBIDDEN = 5,        // 需要管理员身份
+    WIRE_TOO_LARGE = 6         // 响应超出 kWireMaxFrame，内容被丢弃，应缩小页大小后重试
+};
+
+// 一帧（不含长度字段）的最大字节数，超过时服务器断开连接
+const size_t kWireMaxFrame = 1 << 20;
+// 页大小和补全条数的上限，超出时返回 WIRE_MALFORMED
+const int kWirePageLimit = 100;
+// 长度 + 请求号 + 操作码/状态码
+const size_t kWireHeader = 9;
+
+// 按协议格式向 buffer 末尾追加字段
+struct WireWriter {
+    std::string& buffer;
+
+    explicit WireWriter(std::string& out) : buffer(out) {}
+    void u8(uint8_t value) { buffer.push_back(static_cast<char>(value)); }
+    void u32(uint32_t value);
+    void u64(uint64_t value);
+    void i32(int32_t value) { u32(static_cast<uint32_t>(value)); }
+    void f64(double value);
+    void str(TextRef text);
+    void ids(const std::vector<int>& values);
+};
+
+// 按协议格式从 [data, data + size) 依次读出字段；读到末尾之外时返回 false，之后的读取也都失败
+struct WireReader {
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool ok;
+
+    WireReader(const char* bytes, size_t length) : data(bytes), size(length), pos(0), ok(true) {}
+    bool u8(uint8_t& value);
+    bool u32(uint32_t& value);
+    bool u64(uint64_t& value);
+    bool i32(int32_t& value);
+    bool f64(double& value);
+    bool str(std::string& value);
+    bool ids(std::vector<int>& values);
+    // 所有字段都已读出且恰好读完
+    bool done() const { return ok && pos == size; }
+
+private:
+    const char* take(size_t n);
+};
+
+// 一帧的开头：code 是请求的操作码或响应的状态码，body 是内容
+struct WireFrame {
+    uint32_t requestId;
+    uint8_t code;
+    std::string body;
+};
+
+// 在 out 末尾追加一帧；先写帧头再由调用方写内容时用 beginFrame / endFrame
+void appendFrame(std::string& out, uint32_t requestId, uint8_t code, const std::string& body);
+size_t beginFrame(std::string& out, uint32_t requestId, uint8_t code);
+void endFrame(std::string& out, size_t start);
+
+// 从 [data, data + size) 的开头解析一帧：完整时填入 frame 并返回消耗的字节数，
+// 不完整时返回 0，长度字段超出 kWireMaxFrame 或短于帧头时返回 -1
+long parseFrame(const char* data, size_t size, WireFrame& frame);
+#endif
@@ -0,0 +1,112 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool()
+    : job(nullptr), participants(0), busy(0), batch(0), stopping(false) {}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+int WorkStealingPool::workerCount() const {
+    return static_cast<int>(workers.size());
+}
+
+void WorkStealingPool::run(size_t tasks, int count, const std::function<void(size_t)>& task) {
+    if (tasks == 0) return;
+    count = static_cast<int>(std::min<size_t>(std::max(count, 1), tasks));
+    if (count == 1) {
+        for (size_t i = 0; i < tasks; ++i) task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(runLock);
+    // 后台线程只在批次开始后读取 ranges，两批之间都在等待，这里可以放心扩充
+    while (static_cast<int>(ranges.size()) < count) ranges.emplace_back(new Range());
+    while (static_cast<int>(workers.size()) < count - 1) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, static_cast<int>(workers.size()), batch);
+    }
+    for (int p = 0; p < count; ++p) {
+        std::lock_guard<std::mutex> guard(ranges[p]->lock);
+        ranges[p]->begin = tasks * p / count;
+        ranges[p]->end = tasks * (p + 1) / count;
+    }
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        job = &task;
+        participants = count;
+        busy = count - 1;
+        ++batch;
+    }
+    wake.notify_all();
+    participate(0);
+
+    std::unique_lock<std::mutex> lock(stateLock);
+    finished.wait(lock, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void WorkStealingPool::workerLoop(int index, uint64_t seen) {
+    std::unique_lock<std::mutex> lock(stateLock);
+    while (true) {
+        wake.wait(lock, [this, seen] { return stopping || batch != seen; });
+        if (stopping) return;
+        seen = batch;
+        if (index + 1 >= participants) continue;
+        lock.unlock();
+        participate(index + 1);
+        lock.lock();
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+void WorkStealingPool::participate(int self) {
+    size_t task;
+    while (take(self, task)) (*job)(task);
+}
+
+bool WorkStealingPool::take(int self, size_t& task) {
+    while (true) {
+        {
+            Range& own = *ranges[self];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (own.begin < own.end) {
+                task = own.begin++;
+                return true;
+            }
+        }
+        if (!steal(self)) return false;
+    }
+}
+
+// 从下一个还有剩余的参与者那里偷走后一半（至少一个）任务
+bool WorkStealingPool::steal(int self) {
+    for (int k = 1; k < participants; ++k) {
+        Range& victim = *ranges[(self + k) % participants];
+        size_t begin, end;
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            size_t left = victim.end - victim.begin;
+            if (left == 0) continue;
+            end = victim.end;
+            begin = end - (left + 1) / 2;
+            victim.end = begin;
+        }
+        Range& own = *ranges[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
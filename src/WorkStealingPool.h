@@ -0,0 +1,55 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// 执行一批编号为 [0, tasks) 的独立任务的线程池，调用线程也作为一个参与者。
+// 任务按编号连续地均分给各参与者（相邻的块由同一线程处理，访问商品表时更连续），
+// 参与者先从自己区间的前端取任务；自己的做完后从其他参与者剩余区间的后端偷走一半，
+// 任务耗时不均（如部分块匹配多、要核对原文）时也能负载均衡。
+// 同一时刻只执行一批任务，并发调用 run 的线程会依次执行。
+struct WorkStealingPool {
+    WorkStealingPool();
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 用 participants 个参与者（含调用线程）执行 task(0) ... task(tasks - 1)，全部完成后返回。
+    // 后台线程不够时按需创建，之后一直复用
+    void run(size_t tasks, int participants, const std::function<void(size_t)>& task);
+    int workerCount() const;
+
+    // 进程共用的线程池
+    static WorkStealingPool& shared();
+
+private:
+    // 参与者剩余的任务区间 [begin, end)
+    struct Range {
+        std::mutex lock;
+        size_t begin;
+        size_t end;
+    };
+    void workerLoop(int index, uint64_t seen);
+    void participate(int self);
+    bool take(int self, size_t& task);
+    bool steal(int self);
+
+    std::vector<std::thread> workers;     // 第 i 个后台线程是第 i + 1 号参与者
+    std::vector<std::unique_ptr<Range>> ranges;
+    std::mutex runLock;                   // 一次只执行一批
+    std::mutex stateLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* job;
+    int participants;
+    int busy;                             // 本批尚未做完的后台线程数
+    uint64_t batch;                       // 批次号，后台线程据此发现新的一批
+    bool stopping;
+};
+#endif
@@ -3,6 +3,7 @@
 #include <limits> 
 #include <chrono>
 #include <thread>
+#include <functional>
 #include "Platform.h"
 #include "SearchEngine.h"
 #include "User.h"
@@ -33,11 +34,12 @@ void displayPersonalCenterMenu() {
     std::cout << "4. 查看收藏\n";
     std::cout << "5. 查看购物车\n";
     std::cout << "6. 进入管理员模式\n";
+    std::cout << "7. 编辑我发布的商品\n";
     std::cout << "0. 返回首页\n";
     std::cout << "请选择操作: ";
 }
 
-void displayItemDetailsMenu(int itemId, const std::shared_ptr<User>& currentUser) {
+void displayItemDetailsMenu() {
     std::cout << "\n"; // 商品详情已在主函数中动态打印
     std::cout << "1. 加入购物车\n";
     std::cout << "2. 联系卖家\n";
@@ -68,8 +70,14 @@ int getChoice() {
 }
 
 
-// 处理登录逻辑
-std::shared_ptr<User> handleLogin(TradingPlatform& platform) {
+// 当前用户是否为该角色：每次向平台查询，本地只保存令牌和用户ID，不持有用户对象
+bool hasRole(const TradingPlatform& platform, int userId, UserRole role) {
+    UserRole actual;
+    return platform.userRole(userId, actual) && actual == role;
+}
+
+// 处理登录逻辑：成功时返回会话令牌，之后凭令牌确认登录状态，不再保存密码校验的结果
+std::string handleLogin(TradingPlatform& platform) {
     std::string email, password;
     std::cout << "\n--- 用户登录 ---\n";
     std::cout << "邮箱: "; 
@@ -77,32 +85,65 @@ std::shared_ptr<User> handleLogin(TradingPlatform& platform) {
     std::cout << "密码: "; 
     std::cin >> password;
 
-    auto user = platform.login(email, password);
+    std::string session = platform.openSession(email, password);
+    auto user = platform.findUserById(platform.sessionUser(session));
     if (user) {
         std::cout << "登录成功！欢迎，" << user->getUsername() << "。\n";
-        return user;
     } else {
         std::cout << "登录失败，请检查邮箱和密码。\n";
-        return nullptr;
+    }
+    return session;
+}
+
+const int kPageSize = 10;
+
+// 逐页显示商品：fetch 按请求取一页，每页显示完询问是否翻到下一页
+void showPages(const std::function<bool(const PageRequest&, ItemPage&)>& fetch, PageRequest request,
+               const char* emptyHint, const char* separator) {
+    for (int pageNo = 1; ; ++pageNo) {
+        ItemPage page;
+        if (!fetch(request, page)) {
+            std::cout << "分页参数无效。\n";
+            return;
+        }
+        if (page.items.empty()) {
+            std::cout << (pageNo == 1 ? emptyHint : "已经是最后一页。\n");
+            return;
+        }
+        std::cout << "--- 第 " << pageNo << " 页 ---\n";
+        for (const auto& item : page.items) {
+            item.displayInfo();
+            std::cout << separator;
+        }
+        if (!page.hasMore()) {
+            std::cout << "已经是最后一页。\n";
+            return;
+        }
+        std::cout << "1. 下一页  0. 返回\n请选择: ";
+        if (getChoice() != 1) return;
+        request.cursor = page.nextCursor;
     }
 }
 
 // 处理浏览商品
 void handleBrowseItems(TradingPlatform& platform) {
     std::cout << "\n--- 浏览商品 ---\n";
-    std::vector<Item> availableItems = platform.getAvailableItems();
-    if (availableItems.empty()) {
-        std::cout << "目前没有可供浏览的商品。\n";
-        return;
-    }
-    for (const auto& item : availableItems) {
-        item.displayInfo();
-        std::cout << "------------\n";
+    std::cout << "排序方式: 1. 最新发布  2. 价格从低到高  3. 价格从高到低  其他. 按发布顺序\n请选择: ";
+    PageOrder order = ORDER_BY_ID;
+    switch (getChoice()) {
+        case 1: order = ORDER_BY_NEWEST; break;
+        case 2: order = ORDER_BY_PRICE_ASC; break;
+        case 3: order = ORDER_BY_PRICE_DESC; break;
+        default: break;
     }
+    showPages([&platform](const PageRequest& request, ItemPage& page) {
+                  return platform.browseItems(request, page);
+              },
+              PageRequest(kPageSize, order), "目前没有可供浏览的商品。\n", "------------\n");
 }
 
 //   处理商品详情
-void handleItemDetails(TradingPlatform& platform, const std::shared_ptr<User>& currentUser) {
+void handleItemDetails(TradingPlatform& platform, int userId) {
     int itemId;
     std::cout << "\n--- 查看商品详情 ---\n";
     std::cout << "请输入商品ID: ";
@@ -113,7 +154,7 @@ void handleItemDetails(TradingPlatform& platform, const std::shared_ptr<User>& c
         itemPtr->displayInfo();
 
         // 提供操作选项
-        if (currentUser && itemPtr->isAvailable()) {
+        if (userId && itemPtr->isAvailable()) {
             std::cout << "\n操作:\n";
             std::cout << "1. 购买商品\n";
             std::cout << "2. 加入购物车\n";
@@ -124,21 +165,21 @@ void handleItemDetails(TradingPlatform& platform, const std::shared_ptr<User>& c
 
             switch (action) {
                 case 1:
-                    if (platform.purchaseItem(itemId, currentUser->getUserId())) {
+                    if (platform.purchaseItem(itemId, userId)) {
                         std::cout << "购买成功！\n";
                     } else {
                         std::cout << "购买失败，商品状态或用户余额不足。\n";
                     }
                     break;
                 case 2:
-                    if (platform.addToCart(itemId, currentUser->getUserId())) {
+                    if (platform.addToCart(itemId, userId)) {
                         std::cout << "已加入购物车。\n";
                     } else {
                         std::cout << "操作失败。\n";
                     }
                     break;
                 case 3:
-                    if (platform.addToFavorites(itemId, currentUser->getUserId())) {
+                    if (platform.addToFavorites(itemId, userId)) {
                         std::cout << "已加入收藏。\n";
                     } else {
                         std::cout << "操作失败。\n";
@@ -157,7 +198,6 @@ void handleItemDetails(TradingPlatform& platform, const std::shared_ptr<User>& c
 
 int main() {
     TradingPlatform platform;
-    std::shared_ptr<User> currentUser = nullptr;
 
     // 外部循环: 注册/登录/退出程序
     int loginChoice;
@@ -191,10 +231,15 @@ int main() {
                 break;
             }
             case 2: { // 用户登录
-                currentUser = handleLogin(platform);
-                if (currentUser) {
+                std::string session = handleLogin(platform);
+                int userId = platform.sessionUser(session);
+                if (userId) {
                     int mainChoice;
                     do {
+                        if (!platform.sessionUser(session)) {
+                            std::cout << "登录已过期，请重新登录。\n";
+                            break;
+                        }
                         displayMainMenu();
                         mainChoice = getChoice();
 
@@ -207,10 +252,18 @@ int main() {
                                 std::cout << "输入搜索关键词: ";
                                 std::cin.ignore();
                                 std::getline(std::cin, keyword);
-                                auto results = platform.searchItemsByName(keyword);
+                                ItemView results = platform.viewItemsByName(keyword);
                                 std::cout << "\n=== 搜索结果 ===\n";
                                 if (results.empty()) {
                                 std::cout << "没有搜索到符合的商品。\n";
+                                    std::vector<Suggestion> hints = platform.suggest(keyword, 5);
+                                    if (!hints.empty()) {
+                                        std::cout << "你是不是要找：\n";
+                                        for (const Suggestion& hint : hints) {
+                                            std::cout << "  " << hint.text << (hint.category ? "（分类）" : "")
+                                                      << "  " << hint.items << " 件在售\n";
+                                        }
+                                    }
                                 } else {
                                     for (const auto& item : results) {
                                         item.displayInfo();
@@ -225,7 +278,7 @@ int main() {
                                 std::cout << "输入商品ID: ";
                                 std::cin >> itemId;
                                 
-                                Item* item = platform.findItemById(itemId);
+                                auto item = platform.findItemById(itemId);
                                 if (item && item->isAvailable()) {
                                     
                                     int detailChoice;
@@ -233,14 +286,14 @@ int main() {
                                         std::cout << "\n=== 商品详情 ===\n";
                                         item->displayInfo();
                                         
-                                        displayItemDetailsMenu(itemId, currentUser);
+                                        displayItemDetailsMenu();
                                         std::cin >> detailChoice;
                                         
                                         switch(detailChoice) {
                                             case 1: {
                                                 // 加入购物车
-                                                if (currentUser && currentUser->getRole() == REGULAR_USER) {
-                                                    platform.addToCart(itemId, currentUser->getUserId());
+                                                if (hasRole(platform, userId, REGULAR_USER)) {
+                                                    platform.addToCart(itemId, userId);
                                                 } else {
                                                     std::cout << "请先登录普通用户账号！\n";
                                                 }
@@ -257,8 +310,8 @@ int main() {
                                             }
                                             case 3: {
                                                 // 立即购买
-                                                if (currentUser && currentUser->getRole() == REGULAR_USER) {
-                                                    if (platform.purchaseItem(itemId, currentUser->getUserId())) {
+                                                if (hasRole(platform, userId, REGULAR_USER)) {
+                                                    if (platform.purchaseItem(itemId, userId)) {
                                                         std::cout << "购买成功！\n";
                                                         detailChoice = 0; // 购买成功后返回
                                                     } else {
@@ -270,8 +323,8 @@ int main() {
                                                 break;
                                             }
                                             case 4: {
-                                                if (currentUser && currentUser->getRole() == REGULAR_USER) {
-                                                    platform.addToFavorites(itemId, currentUser->getUserId());
+                                                if (hasRole(platform, userId, REGULAR_USER)) {
+                                                    platform.addToFavorites(itemId, userId);
                                                 } else {
                                                     std::cout << "请先登录普通用户账号！\n";
                                                 }
@@ -296,7 +349,7 @@ int main() {
                                     
                                     switch(personalChoice) {
                                         case 1: {
-                                            if (!currentUser || currentUser->getRole() != REGULAR_USER) {
+                                            if (!hasRole(platform, userId, REGULAR_USER)) {
                                                 std::cout << "请先以普通用户身份登录。\n";
                                                 break;
                                             }
@@ -312,7 +365,7 @@ int main() {
                                             std::cout << "价格: ";
                                             std::cin >> price;
                                             
-                                            int itemId = platform.publishItem(name, description, category, price, currentUser->getUserId());
+                                            int itemId = platform.publishItem(name, description, category, price, userId);
                                             std::cout << "商品发布成功！商品ID: " << itemId << "\n";
                                             break;
                                         }
@@ -326,64 +379,71 @@ int main() {
                                             std::cout << "请输入新密码: ";
                                             std::getline(std::cin, newPassword);
                                             
-                                            currentUser->phone = newPhone;
-                                            currentUser->email = newEmail;
-                                            currentUser->password = newPassword;
-                                            
-                                            std::cout << "个人信息更新成功！\n";
+                                            if (platform.updateUserProfile(userId, newPhone, newEmail, newPassword)) {
+                                                std::cout << "个人信息更新成功！\n";
+                                            } else {
+                                                std::cout << "更新失败，该邮箱已被其他用户使用。\n";
+                                            }
                                             break;
                                         }
                                         case 3: {
-                                            if (!currentUser || currentUser->getRole() != REGULAR_USER) {
+                                            if (!hasRole(platform, userId, REGULAR_USER)) {
                                                 std::cout << "请先以普通用户身份登录。\n";
                                                 break;
                                             }
-                                            auto regularUser = std::dynamic_pointer_cast<RegularUser>(currentUser);
-                                            if (regularUser) {
-                                                std::cout << "\n=== 已购买商品 ===\n";
-                                                std::cout << "已购买商品数量: " << regularUser->purchasedItems.size() << "\n";
-                                                for (int itemId : regularUser->purchasedItems) {
-                                                    Item* item = platform.findItemById(itemId);
-                                                    if (item) {
-                                                        std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
-                                                    }
+                                            std::vector<int> itemIds = platform.listUserItems(userId, LIST_PURCHASED);
+                                            std::cout << "\n=== 已购买商品 ===\n";
+                                            std::cout << "已购买商品数量: " << itemIds.size() << "\n";
+                                            for (int itemId : itemIds) {
+                                                auto item = platform.findItemById(itemId);
+                                                if (item) {
+                                                    std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
                                                 }
                                             }
                                             break;
                                         }
                                         case 4: {
                                             // 查看收藏
-                                            if (!currentUser || currentUser->getRole() != REGULAR_USER) {
+                                            if (!hasRole(platform, userId, REGULAR_USER)) {
                                                 std::cout << "请先以普通用户身份登录。\n";
                                                 break;
                                             }
-                                            auto regularUser = std::dynamic_pointer_cast<RegularUser>(currentUser);
-                                            if (regularUser) {
-                                                std::cout << "\n=== 我的收藏 ===\n";
-                                                std::cout << "收藏商品数量: " << regularUser->favorites.size() << "\n";
-                                                for (int itemId : regularUser->favorites) {
-                                                    Item* item = platform.findItemById(itemId);
-                                                    if (item) {
-                                                        std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
-                                                    }
+                                            std::vector<int> itemIds = platform.listUserItems(userId, LIST_FAVORITES);
+                                            std::cout << "\n=== 我的收藏 ===\n";
+                                            std::cout << "收藏商品数量: " << itemIds.size() << "\n";
+                                            for (int itemId : itemIds) {
+                                                auto item = platform.findItemById(itemId);
+                                                if (item) {
+                                                    std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
                                                 }
                                             }
                                             break;
                                         }
                                         case 5: {
                                             // 查看购物车
-                                            if (!currentUser || currentUser->getRole() != REGULAR_USER) {
+                                            if (!hasRole(platform, userId, REGULAR_USER)) {
                                                 std::cout << "请先以普通用户身份登录。\n";
                                                 break;
                                             }
-                                            auto regularUser = std::dynamic_pointer_cast<RegularUser>(currentUser);
-                                            if (regularUser) {
-                                                std::cout << "\n=== 购物车 ===\n";
-                                                std::cout << "购物车商品数量: " << regularUser->cartItems.size() << "\n";
-                                                for (int itemId : regularUser->cartItems) {
-                                                    Item* item = platform.findItemById(itemId);
-                                                    if (item) {
-                                                        std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
+                                            std::vector<int> cart = platform.listUserItems(userId, LIST_CART);
+                                            std::cout << "\n=== 购物车 ===\n";
+                                            std::cout << "购物车商品数量: " << cart.size() << "\n";
+                                            for (int itemId : cart) {
+                                                auto item = platform.findItemById(itemId);
+                                                if (item) {
+                                                    std::cout << "商品ID: " << item->getItemId() << " - " << item->getItemName() << "\n";
+                                                }
+                                            }
+                                            if (!cart.empty()) {
+                                                std::cout << "1. 结账\n0. 返回\n请选择: ";
+                                                if (getChoice() == 1) {
+                                                    std::vector<int> unavailable;
+                                                    if (platform.checkout(userId, unavailable)) {
+                                                        std::cout << "结账成功！\n";
+                                                    } else {
+                                                        std::cout << "结账失败，以下商品已无法购买，购物车未变化:";
+                                                        for (int itemId : unavailable) std::cout << " " << itemId;
+                                                        std::cout << "\n";
                                                     }
                                                 }
                                             }
@@ -391,7 +451,7 @@ int main() {
                                         }
                                         case 6: {
                                             // 管理员功能
-                                            if (!currentUser || currentUser->getRole() != ADMIN) {
+                                            if (!hasRole(platform, userId, ADMIN)) {
                                                 std::cout << "需要管理员权限。\n";
                                                 break;
                                             }
@@ -401,25 +461,25 @@ int main() {
                                                 std::cout << "1. 查看所有商品\n";
                                                 std::cout << "2. 删除商品\n";
                                                 std::cout << "3. 系统统计\n"; 
+                                                std::cout << "4. 压实商品表\n";
                                                 std::cout << "0. 返回\n";
                                                 std::cout << "请选择操作: ";
                                                 std::cin >> adminChoice;
                                                 
                                                 switch(adminChoice) {
                                                     case 1: {
-                                                        auto allItems = platform.getAllItems();
                                                         std::cout << "\n=== 所有商品 ===\n";
-                                                        for (const auto& item : allItems) {
-                                                            item.displayInfo();
-                                                            std::cout << "------------------------\n";
-                                                        }
+                                                        showPages([&platform](const PageRequest& request, ItemPage& page) {
+                                                                      return platform.browseAllItems(request, page);
+                                                                  },
+                                                                  PageRequest(kPageSize), "暂无商品。\n", "------------------------\n");
                                                         break;
                                                     }
                                                     case 2: {
                                                         int itemId;
                                                         std::cout << "输入要删除的商品ID: ";
                                                         std::cin >> itemId;
-                                                        if (platform.deleteItem(itemId, currentUser->getUserId())) {
+                                                        if (platform.deleteItem(itemId, userId)) {
                                                             std::cout << "商品删除成功！\n";
                                                         } else {
                                                             std::cout << "商品删除失败。\n";
@@ -430,12 +490,51 @@ int main() {
                                                         std::cout << "-----系统统计-----:\n";
                                                         std::cout << "用户总数: " << platform.getUserCount() << "\n";
                                                         std::cout << "商品总数: " << platform.getItemCount() << "\n";
+                                                        CatalogStats stats = platform.getCatalogStats();
+                                                        std::cout << "在售商品: " << stats.liveRows << "\n";
+                                                        std::cout << "已售出: " << stats.soldRows << "，已删除: " << stats.deletedRows << "\n";
+                                                        std::cout << "待压实墓碑: " << stats.tombstones << "\n";
+                                                        std::cout << "商品文本: " << stats.textBytes << " 字节，其中待回收 " << stats.textGarbage << " 字节\n";
+                                                        SearchCacheStats cache = platform.getSearchCacheStats();
+                                                        std::cout << "搜索缓存: 命中 " << cache.hits << "，未命中 " << cache.misses
+                                                                  << "，失效 " << cache.invalidations << "，淘汰 " << cache.evictions << "\n";
+                                                        break;
+                                                    }
+                                                    case 4: {
+                                                        int removed = platform.compactCatalog();
+                                                        std::cout << "已清除 " << removed << " 条墓碑。\n";
                                                         break;
                                                     }
                                                 }
                                             } while (adminChoice != 0);
                                             break;
                                         }
+                                        case 7: {
+                                            if (!hasRole(platform, userId, REGULAR_USER)) {
+                                                std::cout << "请先以普通用户身份登录。\n";
+                                                break;
+                                            }
+                                            int itemId;
+                                            std::string name, description, category;
+                                            double price;
+                                            std::cout << "输入要编辑的商品ID: ";
+                                            std::cin >> itemId;
+                                            std::cout << "新商品名称: ";
+                                            std::cin.ignore();
+                                            std::getline(std::cin, name);
+                                            std::cout << "新商品描述: ";
+                                            std::getline(std::cin, description);
+                                            std::cout << "新商品分类: ";
+                                            std::cin >> category;
+                                            std::cout << "新价格: ";
+                                            std::cin >> price;
+                                            if (platform.updateItem(itemId, userId, name, description, category, price)) {
+                                                std::cout << "商品信息已更新！\n";
+                                            } else {
+                                                std::cout << "编辑失败，只能编辑自己发布且仍在售的商品。\n";
+                                            }
+                                            break;
+                                        }
                                         case 0: // 返回首页
                                             break; 
                                         default:
@@ -446,7 +545,7 @@ int main() {
                             }
                             case 0: // 退出登录
                                 std::cout << "已退出当前账号。\n";
-                                currentUser = nullptr; // 重置当前用户
+                                platform.closeSession(session);
                                 break; 
                             default:
                                 std::cout << "无效选择，请重新输入。\n";
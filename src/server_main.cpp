@@ -0,0 +1,59 @@
+// 交易平台的网络服务：TradingServer [--port 端口] [--host 地址] [--unix 路径] [--workers 线程数]
+// 默认监听 127.0.0.1:7070，--port -1 时只监听 Unix 域套接字；工作线程数默认取 CPU 核数。Ctrl+C 或 SIGTERM 结束服务。
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Platform.h"
+#include "TradingServer.h"
+
+static TradingServer* runningServer = nullptr;
+
+static void handleSignal(int) {
+    if (runningServer) runningServer->stop();
+}
+
+int main(int argc, char** argv) {
+    std::string host = "127.0.0.1";
+    int port = 7070;
+    std::string unixPath;
+    int workers = static_cast<int>(std::thread::hardware_concurrency());
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--port") == 0) {
+            port = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--host") == 0) {
+            host = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--unix") == 0) {
+            unixPath = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--workers") == 0) {
+            workers = std::atoi(argv[i + 1]);
+        } else {
+            std::cerr << "未知参数: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    TradingPlatform platform;
+    TradingServer server(platform, workers > 0 ? workers : 1);
+    if (port >= 0 && !server.listenTcp(host, port)) {
+        std::cerr << "无法监听 " << host << ":" << port << "\n";
+        return 1;
+    }
+    if (!unixPath.empty() && !server.listenUnix(unixPath)) {
+        std::cerr << "无法监听 " << unixPath << "\n";
+        return 1;
+    }
+    runningServer = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    if (port >= 0) std::cout << "监听 " << host << ":" << server.port() << "\n";
+    if (!unixPath.empty()) std::cout << "监听 " << unixPath << "\n";
+    server.run();
+    runningServer = nullptr;
+    ServerStats stats = server.stats();
+    std::cout << "共接受 " << stats.accepted << " 个连接，处理 " << stats.requests << " 个请求，回收 " << stats.expired
+              << " 个过期会话\n";
+    return 0;
+}
@@ -1,8 +1,30 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <map>
+#include <random>
 #include "Platform.h"
 #include "User.h"
 #include "Item.h"
 #include "SearchEngine.h"
+#include "FilterKernel.h"
+#include "Utf8.h"
+#include "WorkStealingPool.h"
+#include "ImageHash.h"
+#include "ImageIndex.h"
+#include "EpochReplicas.h"
+#include "ItemClaims.h"
+#include "RequestHandler.h"
+#ifdef __linux__
+#include <unistd.h>
+#include "TradingServer.h"
+#include "WireClient.h"
+#endif
 
 // 使用 Test Fixture 来为每个测试自动创建和销毁 Platform 对象，保持测试环境的独立性
 class TradingPlatformTest : public ::testing::Test {
@@ -21,10 +43,10 @@ protected:
         platform.registerUser("admin1", "admin1234", "admin1@nju.edu.cn", "000", "000", "Admin1", "Admin1", ADMIN);
 
         // 获取 ID 用于后续操作
-        adminId = platform.login("admin1@nju.edu.cn", "admin1234")->getUserId();
-        sellerId = platform.login("seller@nju.edu.cn", "123456")->getUserId();
-        buyerId = platform.login("buyer@nju.edu.cn", "123456")->getUserId();
-        strangerId = platform.login("stranger@nju.edu.cn", "123456")->getUserId();
+        adminId = platform.login("admin1@nju.edu.cn", "admin1234");
+        sellerId = platform.login("seller@nju.edu.cn", "123456");
+        buyerId = platform.login("buyer@nju.edu.cn", "123456");
+        strangerId = platform.login("stranger@nju.edu.cn", "123456");
     }
 
     void TearDown() override {
@@ -46,10 +68,20 @@ TEST_F(TradingPlatformTest, RegisterAndLoginSuccess) {
     EXPECT_TRUE(regResult) << "注册应当成功";
 
     // 2. 成功登录
-    auto user = platform.login(email, pass);
-    ASSERT_NE(user, nullptr) << "登录后返回的指针不应为空"; 
+    int userId = platform.login(email, pass);
+    ASSERT_NE(userId, 0) << "登录后应返回用户ID";
+    auto user = platform.findUserById(userId);
+    ASSERT_NE(user, nullptr);
     EXPECT_EQ(user->getEmail(), email);
     EXPECT_EQ(user->getUsername(), "testuser");
+
+    // 角色单独查询，不必取整个用户
+    UserRole role;
+    ASSERT_TRUE(platform.userRole(userId, role));
+    EXPECT_EQ(role, REGULAR_USER);
+    ASSERT_TRUE(platform.userRole(adminId, role));
+    EXPECT_EQ(role, ADMIN);
+    EXPECT_FALSE(platform.userRole(9999, role));
 }
 
 // 测试边界条件：重复注册
@@ -72,8 +104,7 @@ TEST_F(TradingPlatformTest, LoginWrongPassword) {
     std::string email = "wrong@nju.edu.cn";
     platform.registerUser("u1", "correct_pass", email, "111", "001", "N1", "C1", REGULAR_USER);
 
-    auto user = platform.login(email, "wrong_pass");
-    EXPECT_EQ(user, nullptr) << "密码错误应当返回空指针";
+    EXPECT_EQ(platform.login(email, "wrong_pass"), 0) << "密码错误应当返回 0";
 }
 
 // 测试登录失败条件：邮箱不存在
@@ -81,8 +112,41 @@ TEST_F(TradingPlatformTest, LoginWrongEmail) {
     std::string email = "exist@nju.edu.cn";
     platform.registerUser("u1", "correct_pass", email, "111", "001", "N1", "C1", REGULAR_USER);
 
-    auto user = platform.login("notexist@nju.edu.cn", "correct_pass");
-    EXPECT_EQ(user, nullptr) << "邮箱不存在应当返回空指针";
+    EXPECT_EQ(platform.login("notexist@nju.edu.cn", "correct_pass"), 0) << "邮箱不存在应当返回 0";
+}
+
+// 邮箱按规范化形式（去首尾空白、忽略大小写）登录与查重
+TEST_F(TradingPlatformTest, Login_NormalizedEmail) {
+    platform.registerUser("mixed", "pwd", "Mixed.Case@NJU.edu.cn", "111", "001", "N1", "C1", REGULAR_USER);
+
+    int userId = platform.login("  mixed.case@nju.edu.cn ", "pwd");
+    ASSERT_NE(userId, 0) << "大小写和首尾空白不同的邮箱应能登录";
+    EXPECT_EQ(platform.findUserById(userId)->getUsername(), "mixed");
+
+    bool dup = platform.registerUser("other", "pwd", "MIXED.CASE@nju.edu.cn", "222", "002", "N2", "C2", REGULAR_USER);
+    EXPECT_FALSE(dup) << "仅大小写不同的邮箱应视为重复";
+}
+
+// 修改邮箱后旧邮箱失效、新邮箱可登录，且不能改成他人已占用的邮箱
+// 覆盖：updateUserProfile 成功/冲突分支
+TEST_F(TradingPlatformTest, UpdateProfile_EmailIndex) {
+    auto before = platform.findUserById(buyerId);
+    EXPECT_TRUE(platform.updateUserProfile(buyerId, "999", "new.buyer@nju.edu.cn", "newpass"));
+    EXPECT_EQ(before->getEmail(), "buyer@nju.edu.cn") << "findUserById 返回副本，之后的修改不影响它";
+    EXPECT_EQ(platform.findUserById(buyerId)->getEmail(), "new.buyer@nju.edu.cn");
+    EXPECT_EQ(platform.login("buyer@nju.edu.cn", "123456"), 0) << "旧邮箱不应再能登录";
+    EXPECT_EQ(platform.login("new.buyer@nju.edu.cn", "newpass"), buyerId);
+    auto user = platform.findUserById(buyerId);
+    EXPECT_EQ(user->getPhone(), "999");
+    EXPECT_EQ(user->getUsername(), "buyer") << "未修改的字段应保持不变";
+
+    // 旧邮箱已释放，可以被新用户注册
+    EXPECT_TRUE(platform.registerUser("late", "pwd", "buyer@nju.edu.cn", "1", "1", "N", "C", REGULAR_USER));
+
+    // 改成卖家的邮箱应失败，且原信息保持不变
+    EXPECT_FALSE(platform.updateUserProfile(buyerId, "000", "Seller@nju.edu.cn", "x"));
+    EXPECT_EQ(platform.login("new.buyer@nju.edu.cn", "newpass"), buyerId);
+    EXPECT_EQ(platform.login("seller@nju.edu.cn", "123456"), sellerId);
 }
 
 // =================================================================
@@ -96,7 +160,7 @@ TEST_F(TradingPlatformTest, Item_Publish_Success) {
     
     ASSERT_GT(itemId, 0); // ID 必须有效
     
-    Item* item = platform.findItemById(itemId);
+    auto item = platform.findItemById(itemId);
     ASSERT_NE(item, nullptr);
     EXPECT_EQ(item->getItemName(), "MacBook Pro");
     EXPECT_EQ(item->getPrice(), 8000.0);
@@ -104,11 +168,77 @@ TEST_F(TradingPlatformTest, Item_Publish_Success) {
     EXPECT_EQ(item->getSellerId(), sellerId);
 
     // 验证商品是否进入了卖家的 publishedItems 列表
-    auto seller = std::dynamic_pointer_cast<RegularUser>(platform.findUserById(sellerId));
+    auto seller = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(sellerId));
     auto pubItems = seller->getPublishedItems();
     EXPECT_NE(std::find(pubItems.begin(), pubItems.end(), itemId), pubItems.end());
 }
 
+// 发布大量商品后，商品表中之前取得的商品指针仍然有效
+// 覆盖：ItemStore::find / findItemById 的 O(1) 寻址与越界ID
+TEST_F(TradingPlatformTest, Item_PointerStableAfterGrowth) {
+    int firstId = platform.publishItem("First", "Desc", "Test", 1.0, sellerId);
+    Item* first = platform.items.find(firstId);
+    ASSERT_NE(first, nullptr);
+
+    int lastId = firstId;
+    for (int i = 0; i < 5000; ++i) {
+        lastId = platform.publishItem("Filler", "Desc", "Test", 2.0, sellerId);
+    }
+
+    EXPECT_EQ(platform.items.find(firstId), first) << "扩容后同一商品的地址不应改变";
+    EXPECT_EQ(first->getItemName(), "First");
+    ASSERT_NE(platform.findItemById(lastId), nullptr);
+    EXPECT_EQ(platform.findItemById(lastId)->getItemId(), lastId);
+
+    EXPECT_EQ(platform.findItemById(0), nullptr);
+    EXPECT_EQ(platform.findItemById(-3), nullptr);
+    EXPECT_EQ(platform.findItemById(lastId + 1), nullptr);
+    EXPECT_EQ(platform.findUserById(0), nullptr);
+    EXPECT_EQ(platform.findUserById(platform.getUserCount() + 1), nullptr);
+    EXPECT_EQ(platform.findUserById(buyerId)->getUserId(), buyerId);
+}
+
+// 商品表内的文本存放在文本区，复制出的商品自己持有文本；修改后的旧文本在压实时回收
+TEST_F(TradingPlatformTest, Item_TextArenaAndCompaction) {
+    std::string longDesc(300, 'x');
+    int itemId = platform.publishItem("自行车", longDesc, "交通", 120, sellerId);
+    for (int i = 0; i < 100; ++i) platform.publishItem("Filler", "Desc", "Test", 2.0, sellerId);
+    Item* item = platform.items.find(itemId);
+    EXPECT_TRUE(item->text.arenaBacked());
+    EXPECT_FALSE(platform.findItemById(itemId)->text.arenaBacked()) << "平台返回的是自己持有文本的副本";
+
+    Item copy = *item;
+    EXPECT_FALSE(copy.text.arenaBacked());
+    EXPECT_EQ(copy.getDescription(), longDesc);
+    EXPECT_NE(copy.getDescription().data(), item->getDescription().data());
+
+    ASSERT_TRUE(platform.updateItem(itemId, sellerId, "公路车", "轻量", "交通", 150));
+    CatalogStats before = platform.getCatalogStats();
+    EXPECT_GE(before.textGarbage, longDesc.size());
+    TextRef date = item->getPublishDate();
+    EXPECT_EQ(date.size(), 10u);
+    std::string dateCopy = date;
+
+    platform.compactCatalog();
+    CatalogStats after = platform.getCatalogStats();
+    EXPECT_EQ(after.textGarbage, 0u);
+    EXPECT_LT(after.textBytes, before.textBytes);
+    EXPECT_EQ(platform.items.find(itemId), item);
+    EXPECT_EQ(item->getItemName(), "公路车");
+    EXPECT_EQ(item->getDescription(), "轻量");
+    EXPECT_EQ(item->getPublishDate(), dateCopy);
+    EXPECT_EQ(copy.getItemName(), "自行车");
+
+    // 视图的查找语义与 std::string::find 一致
+    auto filler = platform.findItemById(itemId + 1);
+    TextRef name = filler->getItemName();
+    EXPECT_EQ(name.find("ill"), 1u);
+    EXPECT_EQ(name.find("er"), 4u);
+    EXPECT_EQ(name.find("x"), TextRef::npos);
+    EXPECT_EQ(name.find(""), 0u);
+    EXPECT_EQ(name.find("Filler!"), TextRef::npos);
+}
+
 // 添加到与移出购物车
 // 覆盖：addToCart, removeFromCart 正常路径
 TEST_F(TradingPlatformTest, Cart_AddAndRemove) {
@@ -119,13 +249,15 @@ TEST_F(TradingPlatformTest, Cart_AddAndRemove) {
     EXPECT_TRUE(addRes);
 
     // 验证内部状态 
-    auto buyer = std::dynamic_pointer_cast<RegularUser>(platform.findUserById(buyerId));
+    auto buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
     EXPECT_EQ(buyer->cartItems.size(), 1);
     EXPECT_EQ(buyer->cartItems[0], itemId);
 
     // 从购物车移除
     bool remRes = platform.removeFromCart(itemId, buyerId);
     EXPECT_TRUE(remRes);
+    EXPECT_EQ(buyer->cartItems.size(), 1) << "取得的是副本，之后的修改不影响它";
+    buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
     EXPECT_TRUE(buyer->cartItems.empty());
 }
 
@@ -138,7 +270,7 @@ TEST_F(TradingPlatformTest, Cart_EdgeCases) {
     platform.addToCart(itemId, buyerId);
     platform.addToCart(itemId, buyerId); 
     
-    auto buyer = std::dynamic_pointer_cast<RegularUser>(platform.findUserById(buyerId));
+    auto buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
     EXPECT_EQ(buyer->cartItems.size(), 1) << "重复添加同一商品，购物车数量不应增加";
 
     // 2. 添加不可用商品
@@ -155,11 +287,11 @@ TEST_F(TradingPlatformTest, Purchase_Success) {
     bool buyRes = platform.purchaseItem(itemId, buyerId);
     EXPECT_TRUE(buyRes);
     //验证商品状态是否改变
-    Item* item = platform.findItemById(itemId);
+    auto item = platform.findItemById(itemId);
     EXPECT_EQ(item->getStatus(), SOLD);
 
     // 验证买家能查到购买记录
-    auto buyer = std::dynamic_pointer_cast<RegularUser>(platform.findUserById(buyerId));
+    auto buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
     EXPECT_EQ(buyer->purchasedItems.size(), 1);
     EXPECT_EQ(buyer->purchasedItems[0], itemId);
 }
@@ -178,6 +310,103 @@ TEST_F(TradingPlatformTest, Purchase_Fail_AlreadySold) {
 }
 
 
+// 批量发布与批量改状态：结果与逐件调用一致，ID连续，只处理有权限且在售的商品
+TEST_F(TradingPlatformTest, Batch_PublishAndSetStatus) {
+    TradingPlatform single;
+    single.registerUser("seller", "123456", "seller@nju.edu.cn", "111", "101", "Seller Name", "CS", REGULAR_USER);
+    int singleSeller = single.login("seller@nju.edu.cn", "123456");
+    ASSERT_EQ(singleSeller, sellerId);
+
+    const char* names[] = {"台灯", "自行车", "Desk lamp", "线性代数教材", "显示器"};
+    const char* cats[] = {"生活用品", "自行车", "书籍"};
+    std::vector<ItemDraft> drafts;
+    for (int i = 0; i < 600; ++i) {
+        drafts.push_back(ItemDraft{std::string(names[i % 5]) + std::to_string(i % 37), "九成新", cats[i % 3], 5.0 + i % 90, {}});
+    }
+    int before = platform.publishItem("先发布的一件", "d", "书籍", 1, sellerId);
+    single.publishItem("先发布的一件", "d", "书籍", 1, sellerId);
+    std::vector<int> ids = platform.publishItems(drafts, sellerId);
+    ASSERT_EQ(ids.size(), drafts.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(ids[i], before + 1 + static_cast<int>(i));
+        single.publishItem(drafts[i].name, drafts[i].description, drafts[i].category, drafts[i].price, sellerId);
+    }
+    EXPECT_EQ(platform.findItemById(ids[7])->getItemName(), drafts[7].name);
+    auto seller = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(sellerId));
+    EXPECT_EQ(seller->publishedItems.size(), drafts.size() + 1);
+    EXPECT_TRUE(platform.publishItems(std::vector<ItemDraft>(), sellerId).empty());
+    std::vector<ItemDraft> broken(1, ItemDraft{"坏图", "d", "书籍", 1, {"/nonexistent/photo.pgm"}});
+    EXPECT_TRUE(platform.publishItems(broken, sellerId).empty());
+    EXPECT_EQ(platform.getItemCount(), static_cast<int>(drafts.size()) + 1);
+
+    // 一半卖掉、买家先买走其中几件、路人无权修改
+    EXPECT_TRUE(platform.purchaseItem(ids[0], buyerId));
+    std::vector<int> half;
+    for (size_t i = 0; i < ids.size(); i += 2) half.push_back(ids[i]);
+    EXPECT_EQ(platform.setStatusBatch(half, SOLD, strangerId), 0);
+    EXPECT_EQ(platform.setStatusBatch(half, AVAILABLE, sellerId), 0);
+    EXPECT_EQ(platform.setStatusBatch(half, SOLD, sellerId), static_cast<int>(half.size()) - 1);
+    EXPECT_EQ(platform.setStatusBatch(half, DELETED, adminId), 0) << "已售出的商品不能再改状态";
+    single.purchaseItem(ids[0], buyerId);
+    for (size_t i = 2; i < ids.size(); i += 2) single.purchaseItem(ids[i], buyerId);
+
+    for (const char* keyword : {"台灯", "Desk", "自行车1", ""}) {
+        for (const char* sortBy : {"price_asc", "newest", ""}) {
+            SearchCriteria criteria;
+            criteria.setKeyword(keyword);
+            criteria.setSortBy(sortBy);
+            EXPECT_EQ(platform.viewSearchResults(criteria).ids(), single.viewSearchResults(criteria).ids()) << keyword << " " << sortBy;
+        }
+    }
+    for (const char* prefix : {"台", "desk", "自行车", "书"}) {
+        std::vector<Suggestion> got = platform.suggest(prefix, 50), want = single.suggest(prefix, 50);
+        ASSERT_EQ(got.size(), want.size()) << prefix;
+        for (size_t i = 0; i < got.size(); ++i) {
+            EXPECT_EQ(got[i].text, want[i].text) << prefix;
+            EXPECT_EQ(got[i].items, want[i].items) << prefix;
+            EXPECT_EQ(got[i].category, want[i].category) << prefix;
+        }
+    }
+    CatalogStats stats = platform.getCatalogStats();
+    EXPECT_EQ(stats.liveRows, single.getCatalogStats().liveRows);
+    EXPECT_EQ(stats.soldRows, static_cast<int>(half.size()));
+    EXPECT_EQ(platform.items.priceIndex().size(), static_cast<size_t>(stats.liveRows));
+}
+
+// 结账：购物车中的商品全部买下并清空购物车；有一件买不到时一件都不买，购物车不变
+TEST_F(TradingPlatformTest, Checkout_AllOrNothing) {
+    EXPECT_FALSE(platform.checkout(buyerId)) << "空购物车不能结账";
+    int a = platform.publishItem("Lamp", "d", "Home", 10, sellerId);
+    int b = platform.publishItem("Desk", "d", "Home", 20, sellerId);
+    int c = platform.publishItem("Chair", "d", "Home", 30, sellerId);
+    platform.addToCart(c, buyerId);
+    platform.addToCart(a, buyerId);
+    platform.addToCart(b, buyerId);
+    EXPECT_TRUE(platform.purchaseItem(b, strangerId));
+
+    auto buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
+    std::vector<int> unavailable;
+    EXPECT_FALSE(platform.checkout(buyerId, unavailable));
+    EXPECT_EQ(unavailable, std::vector<int>({b}));
+    EXPECT_EQ(buyer->cartItems.size(), 3u);
+    EXPECT_TRUE(buyer->purchasedItems.empty());
+    EXPECT_EQ(platform.findItemById(a)->getStatus(), AVAILABLE) << "失败的结账不能留下预留";
+
+    int d = platform.publishItem("Shelf", "d", "Home", 40, sellerId);
+    platform.removeFromCart(a, buyerId);
+    platform.removeFromCart(b, buyerId);
+    platform.addToCart(d, buyerId);
+    EXPECT_TRUE(platform.checkout(buyerId, unavailable));
+    EXPECT_TRUE(unavailable.empty());
+    buyer = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyerId));
+    EXPECT_TRUE(buyer->cartItems.empty());
+    EXPECT_EQ(buyer->purchasedItems, std::vector<int>({c, d}));
+    EXPECT_EQ(platform.findItemById(c)->getStatus(), SOLD);
+    EXPECT_EQ(platform.findItemById(d)->getStatus(), SOLD);
+    EXPECT_TRUE(platform.viewItemsByName("Shelf").empty());
+    EXPECT_FALSE(platform.purchaseItem(d, strangerId));
+}
+
 // 管理员删除商品
 // 覆盖：deleteItem 管理员分支
 TEST_F(TradingPlatformTest, Delete_ByAdmin) {
@@ -186,7 +415,7 @@ TEST_F(TradingPlatformTest, Delete_ByAdmin) {
     bool res = platform.deleteItem(itemId, adminId);
     EXPECT_TRUE(res) << "管理员应该有权限删除任何商品";
     //检查商品状态是否已经被改为已删除
-    Item* item = platform.findItemById(itemId);
+    auto item = platform.findItemById(itemId);
     EXPECT_EQ(item->getStatus(), DELETED);
 }
 
@@ -199,7 +428,7 @@ TEST_F(TradingPlatformTest, Delete_Fail_Unauthorized) {
     bool res = platform.deleteItem(itemId, strangerId);
     EXPECT_FALSE(res) << "普通用户不能删除别人的商品";
     
-    Item* item = platform.findItemById(itemId);
+    auto item = platform.findItemById(itemId);
     EXPECT_EQ(item->getStatus(), AVAILABLE) << "删除失败后状态应保持不变";
 }
 
@@ -282,4 +511,1786 @@ TEST_F(TradingPlatformTest, Search_SortPrice) {
     EXPECT_EQ(sortedDesc[0].getPrice(), 1000.0);
     EXPECT_EQ(sortedDesc[1].getPrice(), 99.9);
     EXPECT_EQ(sortedDesc[2].getPrice(), 1.5);
-}
\ No newline at end of file
+}
+
+// 文本索引的结果与逐条 find 一致：中英文混排、词内片段、大小写、购买/删除/修改之后
+TEST_F(TradingPlatformTest, Search_TextIndexMatchesScan) {
+    const char* names[] = {"iPhone 15 手机", "OPPO Phone", "二手手机壳", "山地自行车 Giant", "Charger 充电器",
+                           "高等数学教材", "phone stand", "自行车锁", "数学分析 第2版", "USB-C 数据线"};
+    const char* descs[] = {"九成新", "Used for one year", "全新未拆", "校内自提", "Cable for iPhone"};
+    for (int i = 0; i < 200; ++i) {
+        int id = platform.publishItem(names[i % 10], descs[i % 5], "Misc", i, sellerId);
+        if (i % 7 == 0) platform.purchaseItem(id, buyerId);
+        if (i % 11 == 0) platform.deleteItem(id, sellerId);
+        if (i % 13 == 0) platform.updateItem(id, sellerId, "二手 iPad 平板", "屏幕完好", "Misc", i);
+    }
+
+    const char* queries[] = {"手机", "手", "Phone", "phone", "hone", "iPhone 15", "Phone 手机", "自行车", "行车",
+                             "数学", "教材", "2", "15", "USB-C", "-", "iPad", "平板", "屏幕完好", "不存在", "九成新", ""};
+    for (const char* q : queries) {
+        std::string keyword = q;
+        std::vector<int> expected;
+        for (const auto& item : platform.items.available()) {
+            if (item.getItemName().find(keyword) != std::string::npos) expected.push_back(item.getItemId());
+        }
+        EXPECT_EQ(platform.viewItemsByName(keyword).ids(), expected) << keyword;
+
+        SearchCriteria criteria;
+        criteria.setKeyword(keyword);
+        std::vector<int> expectedCriteria;
+        for (const auto& item : platform.items) {
+            if (criteria.matches(item)) expectedCriteria.push_back(item.getItemId());
+        }
+        EXPECT_EQ(criteria.select(platform.items).ids(), expectedCriteria) << keyword;
+        EXPECT_EQ(SearchEngine::textSearch(platform.items, keyword).ids(), expectedCriteria) << keyword;
+    }
+}
+
+// 不完整的 UTF-8 序列不会按字节命中其他汉字的一部分
+TEST_F(TradingPlatformTest, Search_PartialUtf8NoFalseHit) {
+    int phone = platform.publishItem("手机", "", "Phone", 100, sellerId);
+    std::string full = "机";
+    EXPECT_EQ(platform.viewItemsByName(full).ids(), std::vector<int>({phone}));
+    EXPECT_TRUE(platform.viewItemsByName(full.substr(1)).empty());
+    EXPECT_TRUE(platform.viewItemsByName(full.substr(0, 2)).empty());
+
+    SearchCriteria criteria;
+    criteria.setKeyword(full.substr(1));
+    EXPECT_TRUE(criteria.select(platform.items).empty());
+    EXPECT_FALSE(criteria.matches(*platform.findItemById(phone)));
+}
+
+// 带 limit/offset 的有序查询与全量稳定排序后截取的结果一致（大量同价商品、组合排序键）
+TEST_F(TradingPlatformTest, Search_TopKMatchesFullSort) {
+    for (int i = 0; i < 120; ++i) {
+        int id = platform.publishItem(i % 2 ? "Desk" : "Chair", "d", "Furniture", (i * 7) % 13, sellerId);
+        if (i % 10 == 0) platform.purchaseItem(id, buyerId);
+    }
+    const char* orders[] = {"price_asc", "price_desc", "newest", "oldest", "price_asc,newest", "date_desc,price_desc", ""};
+    const size_t windows[][2] = {{0, 5}, {3, 7}, {0, 0}, {100, 10}, {105, 5}, {500, 5}};
+    for (const char* sortBy : orders) {
+        SearchCriteria criteria;
+        criteria.setSortBy(sortBy);
+        std::vector<int> full = criteria.select(platform.items).ids();
+        ASSERT_EQ(full.size(), 108u);
+        for (const auto& w : windows) {
+            criteria.setLimit(w[1], w[0]);
+            size_t begin = std::min(full.size(), w[0]);
+            size_t end = w[1] == 0 ? full.size() : std::min(full.size(), w[0] + w[1]);
+            std::vector<int> expected(full.begin() + begin, full.begin() + end);
+            EXPECT_EQ(criteria.select(platform.items).ids(), expected) << sortBy << " " << w[0] << "+" << w[1];
+            EXPECT_EQ(criteria.select(platform.viewAvailableItems()).ids(), expected) << sortBy;
+            EXPECT_EQ(SearchEngine::orderBy(platform.viewAvailableItems(), sortBy, w[0], w[1]).ids(), expected) << sortBy;
+        }
+    }
+
+    // 同价商品按ID升序（稳定），组合键按新发布在前
+    SearchCriteria cheapest;
+    cheapest.setSortBy("price_asc");
+    cheapest.setLimit(3);
+    ItemView top = cheapest.select(platform.items);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].getPrice(), 0);
+    EXPECT_LT(top[0].getItemId(), top[1].getItemId());
+    cheapest.setSortBy("price_asc,newest");
+    ItemView newestFirst = cheapest.select(platform.items);
+    EXPECT_GT(newestFirst[0].getItemId(), newestFirst[1].getItemId());
+}
+
+// 价格索引的升序/降序区间扫描与参照结果一致，覆盖缓冲归并和墓碑
+TEST(PriceIndexTest, ScansMatchReference) {
+    PriceIndex index;
+    std::vector<std::pair<double, int>> expected;
+    for (int id = 1; id <= 5000; ++id) {
+        double price = (id * 37) % 101;
+        index.insert(price, id);
+        expected.push_back(std::make_pair(price, id));
+    }
+    for (int id = 3; id <= 5000; id += 3) {
+        double price = (id * 37) % 101;
+        EXPECT_TRUE(index.erase(price, id));
+        expected.erase(std::find(expected.begin(), expected.end(), std::make_pair(price, id)));
+    }
+    EXPECT_FALSE(index.erase(0, 3));
+    EXPECT_FALSE(index.erase(1, 1));
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(index.size(), expected.size());
+
+    const double ranges[][2] = {{0, 100}, {10, 20}, {20, 20}, {50.5, 51}, {200, 300}, {30, 10}};
+    for (const auto& r : ranges) {
+        std::vector<int> asc, desc, wantAsc, wantDesc;
+        for (const auto& e : expected) {
+            if (e.first >= r[0] && e.first <= r[1]) wantAsc.push_back(e.second);
+        }
+        // 降序时同价仍按ID升序
+        for (auto it = expected.rbegin(); it != expected.rend();) {
+            auto group = it;
+            while (it != expected.rend() && it->first == group->first) ++it;
+            for (auto g = it; g != group;) {
+                --g;
+                if (g->first >= r[0] && g->first <= r[1]) wantDesc.push_back(g->second);
+            }
+        }
+        index.scanAscending(r[0], r[1], [&asc](int id, double) { asc.push_back(id); return true; });
+        index.scanDescending(r[0], r[1], [&desc](int id, double) { desc.push_back(id); return true; });
+        EXPECT_EQ(asc, wantAsc) << r[0] << "-" << r[1];
+        EXPECT_EQ(desc, wantDesc) << r[0] << "-" << r[1];
+        EXPECT_GE(index.countInRange(r[0], r[1]), wantAsc.size());
+    }
+
+    // 提前停止
+    std::vector<int> firstThree;
+    index.scanDescending(0, 100, [&firstThree](int id, double) { firstThree.push_back(id); return firstThree.size() < 3; });
+    EXPECT_EQ(firstThree.size(), 3u);
+    index.compact();
+    EXPECT_EQ(index.size(), expected.size());
+    EXPECT_EQ(index.countInRange(0, 100), expected.size());
+}
+
+// 走价格索引的区间查询与逐条判断的结果一致：购买、删除、改价后索引同步，按价格排序时不再另行排序
+TEST_F(TradingPlatformTest, Search_PriceIndexMatchesScan) {
+    const char* categories[] = {"教材", "数码", "生活用品"};
+    std::vector<int> ids;
+    for (int i = 0; i < 600; ++i) {
+        std::string name = i % 4 ? "高等数学" : "Desk lamp";
+        ids.push_back(platform.publishItem(name, "d", categories[i % 3], (i * 13) % 97, sellerId));
+    }
+    for (size_t i = 0; i < ids.size(); i += 7) platform.purchaseItem(ids[i], buyerId);
+    for (size_t i = 2; i < ids.size(); i += 11) platform.deleteItem(ids[i], sellerId);
+    for (size_t i = 4; i < ids.size(); i += 5) {
+        const auto item = platform.findItemById(ids[i]);
+        platform.updateItem(ids[i], sellerId, item->getItemName(), "d", item->getCategory(), item->getPrice() + 0.5);
+    }
+    EXPECT_EQ(platform.items.priceIndex().size(), static_cast<size_t>(platform.getCatalogStats().liveRows));
+
+    const double ranges[][2] = {{0, 1000000}, {0, 30}, {12.5, 12.5}, {40, 45}, {90, 10}};
+    const char* orders[] = {"", "price_asc", "price_desc", "newest", "price_desc,newest"};
+    const size_t windows[][2] = {{0, 0}, {0, 5}, {7, 3}};
+    for (const auto& r : ranges) {
+        for (const char* sortBy : orders) {
+            for (const auto& w : windows) {
+                for (int filter = 0; filter < 3; ++filter) {
+                    SearchCriteria criteria;
+                    criteria.setPriceRange(r[0], r[1]);
+                    criteria.setSortBy(sortBy);
+                    criteria.setLimit(w[1], w[0]);
+                    if (filter == 1) criteria.setCategory("教材");
+                    if (filter == 2) criteria.setKeyword("数学");
+                    EXPECT_EQ(criteria.select(platform.items).ids(), criteria.select(platform.viewAvailableItems()).ids())
+                        << r[0] << "-" << r[1] << " " << sortBy << " " << w[0] << "+" << w[1] << " filter " << filter;
+                }
+            }
+        }
+    }
+
+    // 按价格分页同样走价格索引
+    std::vector<int> paged;
+    PageRequest request(40, ORDER_BY_PRICE_DESC);
+    ItemPage page;
+    do {
+        ASSERT_TRUE(platform.browseItems(request, page));
+        for (int id : page.items.ids()) paged.push_back(id);
+        request.cursor = page.nextCursor;
+    } while (page.hasMore());
+    EXPECT_EQ(paged, SearchEngine::orderBy(platform.viewAvailableItems(), "price_desc").ids());
+}
+
+// 查询计划按各索引的统计选择访问路径，路径不同结果不变；explain 给出估计与实际行数
+TEST_F(TradingPlatformTest, Search_PlanChoosesAccessPath) {
+    for (int i = 0; i < 3000; ++i) {
+        platform.publishItem(i % 600 ? "Bike" : "Rare book", "d", i % 600 ? "Transport" : "Books", i % 100, sellerId);
+    }
+    struct Case {
+        const char* category;
+        double minPrice, maxPrice;
+        const char* sortBy;
+        size_t limit;
+        AccessPath expected;
+    } cases[] = {
+        {"", 0, 1000000, "", 0, PATH_FILTER_KERNEL},
+        {"", 10, 10, "", 0, PATH_PRICE_RANGE},
+        {"Books", 0, 1000000, "", 0, PATH_CANDIDATES},
+        {"", 0, 1000000, "price_asc", 5, PATH_PRICE_ORDER},
+        {"Transport", 0, 1000000, "price_desc", 5, PATH_PRICE_ORDER},
+    };
+    for (const Case& c : cases) {
+        SearchCriteria criteria;
+        criteria.setCategory(c.category);
+        criteria.setPriceRange(c.minPrice, c.maxPrice);
+        criteria.setSortBy(c.sortBy);
+        criteria.setLimit(c.limit);
+        QueryPlan plan = criteria.plan(platform.items);
+        EXPECT_EQ(plan.path, c.expected) << plan.explain();
+        EXPECT_FALSE(plan.executed);
+
+        QueryPlan executed;
+        ItemView result = criteria.select(platform.items, &executed);
+        EXPECT_EQ(executed.path, c.expected);
+        EXPECT_EQ(result.ids(), criteria.select(platform.viewAvailableItems()).ids()) << plan.explain();
+        EXPECT_EQ(executed.rowsReturned, result.size());
+        EXPECT_GE(executed.rowsMatched, executed.rowsReturned);
+    }
+
+    SearchCriteria rare;
+    rare.setCategory("Books");
+    rare.setKeyword("book");
+    QueryPlan plan = rare.plan(platform.items);
+    EXPECT_EQ(plan.categoryRows, 5);
+    EXPECT_EQ(plan.keywordRows, 5);
+    EXPECT_EQ(plan.priceRows, 3000);
+    EXPECT_EQ(plan.estimatedRows, 5);
+    std::string text = rare.explain(platform.items);
+    EXPECT_NE(text.find("access: candidates"), std::string::npos) << text;
+    EXPECT_NE(text.find("category = Books"), std::string::npos) << text;
+    EXPECT_NE(text.find("rows: estimated 5, examined 5, matched 5, returned 5"), std::string::npos) << text;
+
+    // 分类不存在时估计为 0 行
+    rare.setCategory("NoSuchCategory");
+    EXPECT_EQ(rare.plan(platform.items).estimatedRows, 0);
+    EXPECT_TRUE(rare.select(platform.items).empty());
+}
+
+// 搜索缓存：重复查询命中；只有相关分类或含有关键词字符的商品变化才使条目失效，命中时不会返回已售出的商品
+TEST_F(TradingPlatformTest, Search_CacheInvalidation) {
+    int book = platform.publishItem("线性代数", "教材", "书籍", 20, sellerId);
+    int monitor = platform.publishItem("显示器", "27寸", "数码", 800, sellerId);
+    platform.publishItem("山地自行车", "九成新", "自行车", 300, sellerId);
+
+    EXPECT_EQ(platform.viewItemsByCategory("书籍").ids(), std::vector<int>({book}));
+    EXPECT_EQ(platform.viewItemsByName("显示器").ids(), std::vector<int>({monitor}));
+    EXPECT_EQ(platform.viewItemsByCategory("书籍").ids(), std::vector<int>({book}));
+    SearchCacheStats stats = platform.getSearchCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+
+    // 不相关的发布和购买不影响已缓存的结果
+    int bike = platform.publishItem("公路自行车", "全新", "自行车", 900, sellerId);
+    platform.purchaseItem(bike, buyerId);
+    EXPECT_EQ(platform.viewItemsByCategory("书籍").ids(), std::vector<int>({book}));
+    EXPECT_EQ(platform.viewItemsByName("显示器").ids(), std::vector<int>({monitor}));
+    EXPECT_EQ(platform.getSearchCacheStats().hits, 3u);
+    EXPECT_EQ(platform.getSearchCacheStats().invalidations, 0u);
+
+    // 售出后条目失效，结果中不再有该商品
+    platform.purchaseItem(book, buyerId);
+    EXPECT_TRUE(platform.viewItemsByCategory("书籍").empty());
+    EXPECT_EQ(platform.getSearchCacheStats().invalidations, 1u);
+    int monitor2 = platform.publishItem("二手显示器", "24寸", "数码", 300, sellerId);
+    EXPECT_EQ(platform.viewItemsByName("显示器").ids(), std::vector<int>({monitor, monitor2}));
+
+    // 改价后按价格排序的分页结果随之变化
+    SearchCriteria criteria;
+    criteria.setCategory("数码");
+    criteria.setSortBy("price_asc");
+    criteria.setPage(10);
+    ItemPage page;
+    ASSERT_TRUE(platform.searchItems(criteria, page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({monitor2, monitor}));
+    page = ItemPage();   // 页登记着副本，本线程修改商品表前先释放
+    ASSERT_TRUE(platform.updateItem(monitor, sellerId, "显示器", "27寸", "数码", 100));
+    ASSERT_TRUE(platform.searchItems(criteria, page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({monitor, monitor2}));
+    page = ItemPage();
+
+    // 与不经缓存的查询逐次对照
+    const char* categories[] = {"书籍", "数码", "自行车"};
+    const char* names[] = {"线性代数", "显示器", "自行车", "台灯"};
+    std::vector<int> ids;
+    for (int round = 0; round < 200; ++round) {
+        int action = round % 4;
+        if (action == 0 || ids.empty()) {
+            ids.push_back(platform.publishItem(names[round % 4], "d", categories[round % 3], round % 17, sellerId));
+        } else if (action == 1) {
+            platform.purchaseItem(ids[round % ids.size()], buyerId);
+        } else if (action == 2) {
+            int id = ids[(round * 7) % ids.size()];
+            platform.updateItem(id, sellerId, names[(round / 4) % 4], "d", categories[(round / 3) % 3], round % 23);
+        } else {
+            platform.deleteItem(ids[(round * 3) % ids.size()], sellerId);
+        }
+        SearchCriteria query;
+        query.setCategory(round % 2 ? categories[round % 3] : "");
+        query.setKeyword(round % 3 ? names[round % 4] : "");
+        query.setSortBy(round % 5 ? "price_desc" : "");
+        query.setPriceRange(0, 10 + round % 10);
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            EXPECT_EQ(platform.viewSearchResults(query).ids(), query.select(platform.items).ids()) << round;
+            EXPECT_EQ(platform.viewItemsByCategory(categories[round % 3]).ids(),
+                      SearchEngine::categorySearch(platform.viewAvailableItems(), categories[round % 3]).ids());
+        }
+    }
+    for (const Item* item : platform.viewSearchResults(SearchCriteria()).refs) EXPECT_TRUE(item->isAvailable());
+
+    // 超出容量时按最近最少使用淘汰
+    platform.searchCache.setCapacity(2, 1 << 20);
+    EXPECT_EQ(platform.getSearchCacheStats().entries, 2u);
+    platform.viewItemsByName("台灯");
+    platform.viewItemsByName("线性");
+    platform.viewItemsByName("自行");
+    EXPECT_EQ(platform.getSearchCacheStats().entries, 2u);
+    EXPECT_GT(platform.getSearchCacheStats().evictions, 0u);
+}
+
+// 相关度排序：名称命中排在只有描述命中之前，名称越短越靠前；带数量限制时跳过部分候选，结果与全部计分一致
+TEST_F(TradingPlatformTest, Search_RelevanceRanking) {
+    int longName = platform.publishItem("Desk lamp with USB charging port and clamp", "九成新", "Home", 30, sellerId);
+    int descOnly = platform.publishItem("Study desk", "comes with a lamp", "Home", 20, sellerId);
+    int shortName = platform.publishItem("Lamp", "宿舍自提", "Home", 10, sellerId);
+    platform.publishItem("Chair", "no light", "Home", 15, sellerId);
+
+    SearchCriteria lamp;
+    lamp.setKeyword("amp");
+    lamp.setSortBy("relevance");
+    QueryPlan plan;
+    ItemView ranked = lamp.select(platform.items, &plan);
+    EXPECT_EQ(plan.path, PATH_RELEVANCE) << plan.explain();
+    EXPECT_EQ(ranked.ids(), (std::vector<int>{shortName, longName, descOnly}));
+
+    // 没有关键词时忽略相关度，按其余排序键
+    SearchCriteria noKeyword;
+    noKeyword.setSortBy("relevance,price_asc");
+    EXPECT_EQ(noKeyword.select(platform.items).ids().front(), shortName);
+
+    std::mt19937 rng(3);
+    const char* words[] = {"red", "bike", "lamp", "desk", "book", "pen", "bag", "cup"};
+    for (int i = 0; i < 3000; ++i) {
+        std::string name, desc;
+        for (int w = rng() % 4 + 1; w > 0; --w) name += std::string(words[rng() % 8]) + " ";
+        for (int w = rng() % 6; w > 0; --w) desc += std::string(words[rng() % 8]) + " ";
+        platform.publishItem(name, desc, i % 2 ? "Home" : "Books", rng() % 50, sellerId);
+    }
+    for (const char* sortBy : {"relevance", "relevance,price_desc", "relevance,newest"}) {
+        for (const char* keyword : {"lamp", "bike lamp", "desk"}) {
+            SearchCriteria all;
+            all.setKeyword(keyword);
+            all.setSortBy(sortBy);
+            all.setPriceRange(5, 40);
+            std::vector<int> full = all.select(platform.items).ids();
+            ASSERT_GT(full.size(), 40u);
+
+            SearchCriteria top = all;
+            top.setLimit(20, 10);
+            QueryPlan topPlan;
+            std::vector<int> page = top.select(platform.items, &topPlan).ids();
+            EXPECT_EQ(page, std::vector<int>(full.begin() + 10, full.begin() + 30)) << keyword << " " << sortBy;
+            EXPECT_LT(topPlan.rowsMatched, full.size()) << topPlan.explain();
+        }
+    }
+}
+
+// 相关度按全表的平均字段长度归一：其他分类发布名称很短、描述很长的商品后，只有描述命中的商品反超，缓存不能返回旧顺序
+TEST_F(TradingPlatformTest, Search_RelevanceCacheFollowsCorpus) {
+    for (int i = 0; i < 20; ++i) platform.publishItem(std::string(40, 'x'), "y", "Books", 5, sellerId);
+    int inName = platform.publishItem("lamp xxxxxxxxxx", "", "Home", 10, sellerId);
+    int inDesc = platform.publishItem("zzzz", "lamp", "Home", 10, sellerId);
+
+    SearchCriteria criteria;
+    criteria.setCategory("Home");
+    criteria.setKeyword("lamp");
+    criteria.setSortBy("relevance");
+    EXPECT_EQ(platform.viewSearchResults(criteria).ids(), (std::vector<int>{inName, inDesc}));
+    EXPECT_EQ(platform.viewSearchResults(criteria).ids(), (std::vector<int>{inName, inDesc}));
+
+    for (int i = 0; i < 1000; ++i) platform.publishItem("c", std::string(40, 'y'), "Books", 5, sellerId);
+    EXPECT_EQ(criteria.select(platform.items).ids(), (std::vector<int>{inDesc, inName}));
+    EXPECT_EQ(platform.viewSearchResults(criteria).ids(), (std::vector<int>{inDesc, inName}));
+}
+
+// 参照实现：按码点逐格动态规划，ASCII 不分大小写，子串可以从任意位置开始和结束
+static int substringDistance(const std::string& pattern, const std::string& text) {
+    auto decode = [](const std::string& s) {
+        std::vector<int32_t> out;
+        size_t pos = 0;
+        while (pos < s.size()) {
+            int32_t c = decodeUtf8(s, pos);
+            out.push_back(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        }
+        return out;
+    };
+    std::vector<int32_t> p = decode(pattern), t = decode(text);
+    std::vector<std::vector<int>> d(p.size() + 1, std::vector<int>(t.size() + 1, 0));
+    for (size_t i = 1; i <= p.size(); ++i) {
+        d[i][0] = static_cast<int>(i);
+        for (size_t j = 1; j <= t.size(); ++j) {
+            d[i][j] = std::min(std::min(d[i - 1][j] + 1, d[i][j - 1] + 1), d[i - 1][j - 1] + (p[i - 1] == t[j - 1] ? 0 : 1));
+        }
+    }
+    return *std::min_element(d[p.size()].begin(), d[p.size()].end());
+}
+
+// 近似搜索：换位、错字在编辑距离内可以搜到；走文本索引剪枝的结果与逐件计算编辑距离的参照一致
+TEST_F(TradingPlatformTest, Search_FuzzyMatching) {
+    int phone = platform.publishItem("iPhone 13 Pro", "电池健康 90%", "Digital", 4000, sellerId);
+    int keyboard = platform.publishItem("罗技机械键盘", "青轴", "Digital", 200, sellerId);
+    platform.publishItem("Desk lamp", "宿舍自提", "Home", 30, sellerId);
+
+    EXPECT_TRUE(SearchEngine::textSearch(platform.items, "iphnoe").empty());
+    EXPECT_EQ(SearchEngine::fuzzySearch(platform.items, "iphnoe", 2).ids(), std::vector<int>{phone});
+    EXPECT_TRUE(SearchEngine::fuzzySearch(platform.items, "iphnoe", 1).empty());
+    EXPECT_EQ(SearchEngine::fuzzySearch(platform.items, "机戒键盘", 1).ids(), std::vector<int>{keyboard});
+
+    SearchCriteria typo;
+    typo.setKeyword("iphnoe");
+    typo.setMaxDistance(2);
+    QueryPlan plan;
+    EXPECT_EQ(typo.select(platform.items, &plan).ids(), std::vector<int>{phone});
+    EXPECT_GE(plan.keywordRows, 0) << plan.explain();
+    EXPECT_NE(plan.explain().find("within 2 edits"), std::string::npos);
+    // 缓存区分编辑距离，不会把精确搜索的空结果当作近似搜索的结果
+    SearchCriteria exactTypo;
+    exactTypo.setKeyword("iphnoe");
+    EXPECT_TRUE(platform.viewSearchResults(exactTypo).empty());
+    EXPECT_EQ(platform.viewSearchResults(typo).ids(), std::vector<int>{phone});
+
+    std::mt19937 rng(5);
+    const char* letters[] = {"a", "b", "C", "d", " ", "手", "机", "键", "盘"};
+    auto randomText = [&](int minChars, int maxChars) {
+        std::string out;
+        for (int n = minChars + static_cast<int>(rng() % (maxChars - minChars + 1)); n > 0; --n) out += letters[rng() % 9];
+        return out;
+    };
+    for (int i = 0; i < 1500; ++i) {
+        platform.publishItem(randomText(3, 12), randomText(0, 20), "Misc", 1, sellerId);
+    }
+    std::string longPattern;
+    for (int i = 0; i < 70; ++i) longPattern += letters[rng() % 9];
+    platform.publishItem(longPattern.substr(0, 40), longPattern.substr(38), "Misc", 1, sellerId);
+    ItemView available = platform.viewAvailableItems();
+    for (int round = 0; round < 60; ++round) {
+        std::string pattern = round == 0 ? longPattern : randomText(2, 7);
+        int maxDistance = round == 0 ? 4 : 1 + round % 3;
+        std::vector<int> expected;
+        for (const Item* item : available.refs) {
+            if (substringDistance(pattern, item->getItemName()) <= maxDistance ||
+                substringDistance(pattern, item->getDescription()) <= maxDistance) {
+                expected.push_back(item->getItemId());
+            }
+        }
+        SearchCriteria fuzzy;
+        fuzzy.setKeyword(pattern);
+        fuzzy.setMaxDistance(maxDistance);
+        EXPECT_EQ(fuzzy.select(platform.items).ids(), expected) << "\"" << pattern << "\" within " << maxDistance;
+        EXPECT_EQ(SearchEngine::fuzzySearch(available, pattern, maxDistance).ids(), expected);
+    }
+}
+
+// 输入补全：按在售件数排序，随发布/购买/修改更新，前缀可以停在词中间或多字节字符中间；与逐件统计的参照一致
+TEST_F(TradingPlatformTest, Search_Suggestions) {
+    platform.publishItem("iPhone 13", "九成新", "电子产品", 3000, sellerId);
+    int second = platform.publishItem("iphone  13 ", "全新", "电子产品", 3500, sellerId);
+    platform.publishItem("iPhone 12 mini", "", "电子产品", 2000, sellerId);
+    platform.publishItem("机械键盘", "青轴", "电脑配件", 200, sellerId);
+
+    std::vector<Suggestion> iph = platform.suggest("IPH", 10);
+    ASSERT_EQ(iph.size(), 2u);
+    EXPECT_EQ(iph[0].text, "iPhone 13");
+    EXPECT_EQ(iph[0].items, 2);
+    EXPECT_FALSE(iph[0].category);
+    EXPECT_EQ(iph[1].text, "iPhone 12 mini");
+    EXPECT_EQ(platform.suggest("iphone 13", 10).size(), 1u);
+    EXPECT_TRUE(platform.suggest("iphone 13 ", 10).empty());
+
+    // 停在词中间、多字节字符中间
+    std::string keyboard = "机械键盘";
+    EXPECT_EQ(platform.suggest("机械键", 10).front().text, keyboard);
+    EXPECT_EQ(platform.suggest(keyboard.substr(0, 4), 10).front().text, keyboard);
+    std::vector<Suggestion> electronics = platform.suggest("电", 10);
+    ASSERT_EQ(electronics.size(), 2u);
+    EXPECT_EQ(electronics[0].text, "电子产品");
+    EXPECT_EQ(electronics[0].items, 3);
+    EXPECT_TRUE(electronics[0].category);
+
+    ASSERT_TRUE(platform.purchaseItem(second, buyerId));
+    EXPECT_EQ(platform.suggest("iphone", 10)[0].items, 1);
+    EXPECT_EQ(platform.suggest("电子", 10)[0].items, 2);
+
+    // 大量发布、购买、修改后与参照一致；容量很小时仍给出正确的前几名之一
+    std::mt19937 rng(9);
+    const char* heads[] = {"Apple", "apple", "台灯", "台式机", "Kindle"};
+    const char* tails[] = {"", " Pro", " 2", "架", " mini"};
+    const char* cats[] = {"书籍", "电子产品", "生活用品"};
+    std::vector<int> ids;
+    for (int i = 0; i < 3000; ++i) {
+        std::string name = std::string(heads[rng() % 5]) + tails[rng() % 5];
+        ids.push_back(platform.publishItem(name, "", cats[rng() % 3], 1, sellerId));
+    }
+    // 重设容量会把缓冲归并进有序数组，之后的增减走线段树
+    platform.setSuggestCapacity(1 << 20);
+    for (int i = 0; i < 800; ++i) {
+        int id = ids[rng() % ids.size()];
+        if (i % 2) {
+            platform.purchaseItem(id, buyerId);
+        } else {
+            platform.updateItem(id, sellerId, std::string(heads[rng() % 5]) + tails[rng() % 5], "", cats[rng() % 3], 2);
+        }
+    }
+    for (const char* prefix : {"a", "apple ", "台", "台灯", "k", "书", ""}) {
+        std::map<std::pair<std::string, bool>, int> counts;
+        for (const Item& item : platform.items.available()) {
+            std::string name = item.getItemName(), category = item.getCategory();
+            std::string lowered = name;
+            for (char& c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            std::string p = prefix;
+            for (char& c : p) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (lowered.compare(0, p.size(), p) == 0) ++counts[std::make_pair(lowered, false)];
+            if (category.compare(0, p.size(), p) == 0) ++counts[std::make_pair(category, true)];
+        }
+        std::vector<std::pair<int, std::pair<std::string, bool>>> expected;
+        for (const auto& entry : counts) expected.push_back(std::make_pair(-entry.second, entry.first));
+        std::sort(expected.begin(), expected.end());
+        std::vector<Suggestion> got = platform.suggest(prefix, 5);
+        ASSERT_EQ(got.size(), std::min<size_t>(5, expected.size())) << prefix;
+        for (size_t k = 0; k < got.size(); ++k) {
+            std::string lowered = got[k].text;
+            for (char& c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            EXPECT_EQ(got[k].items, -expected[k].first) << prefix << " #" << k;
+            EXPECT_EQ(lowered, expected[k].second.first) << prefix << " #" << k;
+            EXPECT_EQ(got[k].category, expected[k].second.second);
+        }
+    }
+    platform.setSuggestCapacity(4);
+    EXPECT_LE(platform.items.suggestions().size(), 4u);
+    EXPECT_EQ(platform.suggest("", 1).size(), 1u);
+}
+
+// 两份副本轮换：写者持续修改时，读者每次读到的都是一次完整修改之后的版本，两份副本最终一致
+TEST(EpochReplicasTest, ReadersSeeWholeWrites) {
+    EpochReplicas<std::vector<int>> replicas;
+    std::atomic<bool> done(false);
+    std::atomic<bool> torn(false);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&replicas, &done, &torn]() {
+            while (!done) {
+                bool whole = replicas.read([](const std::vector<int>& v) {
+                    return v.size() % 2 == 0 && (v.empty() || v[v.size() - 1] == v[v.size() - 2]);
+                });
+                if (!whole) torn = true;
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        // 一次修改追加两个相同的数
+        replicas.write([i](std::vector<int>& v) {
+            v.push_back(i);
+            v.push_back(i);
+        });
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(replicas.replica(0), replicas.replica(1));
+    EXPECT_EQ(replicas.replica(0).size(), 4000u);
+}
+
+// 工作窃取线程池：每个任务恰好执行一次，任务数少于参与者或耗时不均时也能完成
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+    WorkStealingPool pool;
+    for (size_t tasks : {1u, 3u, 1000u}) {
+        std::vector<std::atomic<int>> runs(tasks);
+        for (auto& r : runs) r = 0;
+        pool.run(tasks, 8, [&runs](size_t i) {
+            // 前面的任务更慢，迫使其他参与者来偷
+            if (i < 10) std::this_thread::sleep_for(std::chrono::microseconds(200));
+            ++runs[i];
+        });
+        for (size_t i = 0; i < tasks; ++i) EXPECT_EQ(runs[i], 1) << i;
+    }
+    EXPECT_GE(pool.workerCount(), 2);
+}
+
+// 并行全表扫描与单线程结果完全一致：排序、数量限制、需要核对原文的关键词，售出的商品不出现
+TEST_F(TradingPlatformTest, Search_ParallelScanMatchesSerial) {
+    std::mt19937 rng(11);
+    const char* names[] = {"Wi-Fi 路由器", "台灯", "T-shirt", "考研资料", "Apple pencil"};
+    std::vector<int> ids;
+    for (int i = 0; i < 6000; ++i) {
+        ids.push_back(platform.publishItem(names[rng() % 5], "", i % 3 ? "Home" : "Books", rng() % 100, sellerId));
+    }
+    for (int i = 0; i < 500; ++i) platform.purchaseItem(ids[rng() % ids.size()], buyerId);
+
+    int parallelRuns = 0;
+    for (const char* keyword : {"", "-"}) {
+        for (const char* sortBy : {"", "price_asc", "newest", "price_desc,newest"}) {
+            for (size_t limit : {0u, 15u}) {
+                SearchCriteria serial;
+                serial.setKeyword(keyword);
+                serial.setSortBy(sortBy);
+                serial.setLimit(limit, limit ? 5 : 0);
+                SearchCriteria parallel = serial;
+                parallel.setThreads(4, 0);
+                QueryPlan plan;
+                EXPECT_EQ(parallel.select(platform.items, &plan).ids(), serial.select(platform.items).ids())
+                    << "\"" << keyword << "\" " << sortBy << " " << limit << "\n" << plan.explain();
+                if (plan.threads > 1) ++parallelRuns;
+            }
+        }
+    }
+    EXPECT_GT(parallelRuns, 0);
+
+    // 商品表小于阈值时仍是单线程
+    SearchCriteria small;
+    small.setThreads(4);
+    QueryPlan plan;
+    small.select(platform.items, &plan);
+    EXPECT_EQ(plan.threads, 1);
+}
+
+// 按图搜索用的生成图片：几个随机方向和频率的正弦条纹叠加，seed 不同图案不同
+static GrayImage patternImage(unsigned seed, int width, int height) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double fx[3], fy[3], phase[3];
+    for (int k = 0; k < 3; ++k) {
+        fx[k] = (unit(rng) - 0.5) * 12.0;
+        fy[k] = (unit(rng) - 0.5) * 12.0;
+        phase[k] = unit(rng) * 6.2832;
+    }
+    GrayImage image(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            double v = 0;
+            for (int k = 0; k < 3; ++k) v += std::sin(fx[k] * x / width + fy[k] * y / height + phase[k]);
+            image.at(x, y) = static_cast<uint8_t>(127.5 + 40.0 * v);
+        }
+    }
+    return image;
+}
+
+// 调亮、加噪声、缩小一半后的同一张图
+static GrayImage editedImage(const GrayImage& image, unsigned seed) {
+    std::mt19937 rng(seed);
+    GrayImage edited(image.width / 2, image.height / 2);
+    for (int y = 0; y < edited.height; ++y) {
+        for (int x = 0; x < edited.width; ++x) {
+            int v = (image.at(2 * x, 2 * y) + image.at(2 * x + 1, 2 * y) + image.at(2 * x, 2 * y + 1) +
+                     image.at(2 * x + 1, 2 * y + 1)) / 4 + 15 + static_cast<int>(rng() % 7) - 3;
+            edited.at(x, y) = static_cast<uint8_t>(std::min(255, std::max(0, v)));
+        }
+    }
+    return edited;
+}
+
+// 差异哈希：同一张图编辑后距离很小，不同的图距离大；PNM 读写
+TEST(ImageHashTest, SimilarImagesHaveCloseHashes) {
+    for (unsigned seed = 1; seed <= 20; ++seed) {
+        GrayImage image = patternImage(seed, 160, 120);
+        uint64_t original = differenceHash(image);
+        EXPECT_LE(hammingDistance(original, differenceHash(editedImage(image, seed))), kSimilarImageDistance) << seed;
+        EXPECT_GT(hammingDistance(original, differenceHash(patternImage(seed + 100, 160, 120))), kSimilarImageDistance)
+            << seed;
+    }
+
+    std::string path = ::testing::TempDir() + "image_hash_test.pgm";
+    GrayImage image = patternImage(7, 40, 30);
+    ASSERT_TRUE(saveImage(path, image));
+    GrayImage loaded;
+    ASSERT_TRUE(loadImage(path, loaded));
+    EXPECT_EQ(loaded.width, 40);
+    EXPECT_EQ(loaded.height, 30);
+    EXPECT_EQ(loaded.pixels, image.pixels);
+    uint64_t hash = 0;
+    EXPECT_TRUE(hashImageFile(path, hash));
+    EXPECT_EQ(hash, differenceHash(image));
+
+    // 灰色的 P6 彩色图与同样的 P5 灰度图哈希相同，带注释的头部也能读
+    std::string colorPath = ::testing::TempDir() + "image_hash_test.ppm";
+    {
+        std::ofstream out(colorPath, std::ios::binary);
+        out << "P6\n# generated\n40 30\n255\n";
+        for (uint8_t v : image.pixels) out << static_cast<char>(v) << static_cast<char>(v) << static_cast<char>(v);
+    }
+    uint64_t colorHash = 0;
+    EXPECT_TRUE(hashImageFile(colorPath, colorHash));
+    EXPECT_EQ(colorHash, hash);
+
+    // 截断、不支持的格式、不存在的文件
+    {
+        std::ofstream out(colorPath, std::ios::binary);
+        out << "P5\n40 30\n255\n" << std::string(100, 'x');
+    }
+    EXPECT_FALSE(hashImageFile(colorPath, hash));
+    {
+        std::ofstream out(colorPath, std::ios::binary);
+        out << "P2\n2 1\n255\n0 0\n";
+    }
+    EXPECT_FALSE(hashImageFile(colorPath, hash));
+    EXPECT_FALSE(hashImageFile(::testing::TempDir() + "no_such_image.pgm", hash));
+    std::remove(path.c_str());
+    std::remove(colorPath.c_str());
+}
+
+// 多索引哈希表的近邻查询与顺序扫描、逐个比较的结果一致，删除和同一商品的多张图片都要处理对
+TEST(ImageIndexTest, NearestMatchesScan) {
+    std::mt19937_64 rng(5);
+    ImageIndex index;
+    std::vector<std::pair<int, uint64_t>> entries;
+    // 1000 组相近的哈希（模拟同款商品的照片），每组 20 个，每两个哈希属于同一件商品
+    for (int group = 0; group < 1000; ++group) {
+        uint64_t center = rng();
+        for (int k = 0; k < 20; ++k) {
+            uint64_t hash = center;
+            for (int flips = rng() % 7; flips > 0; --flips) hash ^= uint64_t(1) << (rng() % 64);
+            int itemId = static_cast<int>(entries.size() / 2) + 1;
+            entries.emplace_back(itemId, hash);
+            index.add(itemId, hash);
+        }
+    }
+    for (size_t i = 0; i < entries.size(); i += 7) ASSERT_TRUE(index.remove(entries[i].first, entries[i].second));
+    EXPECT_FALSE(index.remove(entries[0].first, entries[0].second));
+    EXPECT_EQ(index.size(), entries.size() - (entries.size() + 6) / 7);
+
+    auto brute = [&entries](uint64_t query, size_t limit, int maxDistance) {
+        std::map<int, int> best;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i % 7 == 0) continue;
+            int d = hammingDistance(entries[i].second, query);
+            if (d > maxDistance) continue;
+            auto it = best.find(entries[i].first);
+            if (it == best.end() || d < it->second) best[entries[i].first] = d;
+        }
+        std::vector<std::pair<int, int>> sorted;
+        for (const auto& b : best) sorted.emplace_back(b.second, b.first);
+        std::sort(sorted.begin(), sorted.end());
+        if (limit && sorted.size() > limit) sorted.resize(limit);
+        return sorted;
+    };
+    auto pairs = [](const std::vector<ImageMatch>& matches) {
+        std::vector<std::pair<int, int>> result;
+        for (const ImageMatch& m : matches) result.emplace_back(m.distance, m.itemId);
+        return result;
+    };
+    for (int q = 0; q < 60; ++q) {
+        // 一半查询落在某组附近，一半随机
+        uint64_t query = q % 2 ? rng() : entries[rng() % entries.size()].second ^ (uint64_t(1) << (rng() % 64));
+        for (size_t limit : {1u, 10u, 0u}) {
+            for (int maxDistance : {0, 5, 12, 30}) {
+                auto expected = brute(query, limit, maxDistance);
+                EXPECT_EQ(pairs(index.nearest(query, limit, maxDistance)), expected) << q << " " << limit << " " << maxDistance;
+                EXPECT_EQ(pairs(index.scan(query, limit, maxDistance)), expected) << q << " " << limit << " " << maxDistance;
+            }
+        }
+    }
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.nearest(entries[1].second, 10, 64).empty());
+}
+
+// 带图片发布与按图搜索：编辑过的照片能找回原商品，售出后不再出现，图片读不了时不发布
+TEST_F(TradingPlatformTest, Search_ByImage) {
+    std::vector<std::string> paths;
+    for (unsigned seed = 1; seed <= 30; ++seed) {
+        std::string path = ::testing::TempDir() + "listing_" + std::to_string(seed) + ".pgm";
+        ASSERT_TRUE(saveImage(path, patternImage(seed, 160, 120)));
+        paths.push_back(path);
+    }
+    std::vector<int> ids;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        // 每件商品两张图：自己的一张，加上后一件商品的那张
+        std::vector<std::string> images = {paths[i]};
+        if (i + 1 < paths.size()) images.push_back(paths[i + 1]);
+        ids.push_back(platform.publishItem("商品" + std::to_string(i), "", "Misc", 10, sellerId, images));
+        ASSERT_GT(ids.back(), 0);
+    }
+    EXPECT_EQ(platform.findItemById(ids[3])->images.size(), 2u);
+
+    std::string query = ::testing::TempDir() + "query.pgm";
+    ASSERT_TRUE(saveImage(query, editedImage(patternImage(8, 160, 120), 99)));
+    ItemView view = platform.searchByImage(query);
+    ASSERT_GE(view.size(), 2u);
+    // 第 8 张图属于第 7、8 件商品，距离相同按ID升序
+    EXPECT_EQ(view[0].getItemId(), ids[6]);
+    EXPECT_EQ(view[1].getItemId(), ids[7]);
+    EXPECT_EQ(view.ids(), SearchEngine::imageSearch(platform.viewAvailableItems(), differenceHash(editedImage(patternImage(8, 160, 120), 99)),
+                                                    10, kSimilarImageDistance).ids());
+
+    view = ItemView();
+    EXPECT_TRUE(platform.purchaseItem(ids[6], buyerId));
+    view = platform.searchByImage(query, 1);
+    ASSERT_EQ(view.size(), 1u);
+    EXPECT_EQ(view[0].getItemId(), ids[7]);
+    view = ItemView();
+
+    int before = platform.getItemCount();
+    EXPECT_EQ(platform.publishItem("坏图", "", "Misc", 10, sellerId, {paths[0], ::testing::TempDir() + "missing.pgm"}), -1);
+    EXPECT_EQ(platform.getItemCount(), before);
+    EXPECT_EQ(platform.publishItem("无图", "", "Misc", 10, sellerId), ids.back() + 1);
+    EXPECT_TRUE(platform.searchByImage(::testing::TempDir() + "missing.pgm").empty());
+
+    for (const std::string& path : paths) std::remove(path.c_str());
+    std::remove(query.c_str());
+}
+
+// 多线程同时搜索、浏览、购买、发布、修改：同一件商品只卖出一次，读到的快照前后一致
+// 在 -DTRADING_TSAN=ON 构建下运行可检查数据竞争
+TEST_F(TradingPlatformTest, Concurrency_MixedReadersAndWriters) {
+    std::vector<int> ids;
+    for (int i = 0; i < 400; ++i) {
+        ids.push_back(platform.publishItem(i % 2 ? "Desk lamp" : "Bike", "d", i % 3 ? "Home" : "Sport", 10 + i % 50, sellerId));
+    }
+    std::vector<int> buyers;
+    for (int b = 0; b < 4; ++b) {
+        std::string email = "racer" + std::to_string(b) + "@nju.edu.cn";
+        platform.registerUser("racer", "pwd", email, "1", "1", "R", "CS", REGULAR_USER);
+        buyers.push_back(platform.login(email, "pwd"));
+    }
+
+    std::atomic<int> sold(0);
+    std::atomic<bool> readerFailed(false);
+    std::vector<std::thread> threads;
+    // 买家都从头到尾抢同一批商品
+    for (int buyer : buyers) {
+        threads.emplace_back([this, &ids, &sold, buyer]() {
+            for (int id : ids) {
+                if (platform.purchaseItem(id, buyer)) ++sold;
+                if (id % 16 == 0) {
+                    platform.addToCart(id + 1, buyer);
+                    platform.removeFromCart(id + 1, buyer);
+                }
+            }
+        });
+    }
+    threads.emplace_back([this]() {
+        for (int i = 0; i < 200; ++i) platform.publishItem("Desk lamp new", "n", "Home", 5, sellerId);
+    });
+    threads.emplace_back([this, &ids]() {
+        for (size_t i = 0; i < ids.size(); i += 3) {
+            platform.updateItem(ids[i], sellerId, "Desk lamp v2", "u", "Home", 99);
+        }
+    });
+    for (int r = 0; r < 3; ++r) {
+        threads.emplace_back([this, &ids, &readerFailed, r]() {
+            SearchCriteria criteria;
+            criteria.setKeyword("lamp");
+            criteria.setSortBy(r == 0 ? "price_asc" : "newest");
+            criteria.setPage(20);
+            for (int round = 0; round < 100; ++round) {
+                ItemPage page;
+                if (!platform.searchItems(criteria, page)) readerFailed = true;
+                for (const Item& item : page.items) {
+                    if (!item.isAvailable() || item.getItemName().find("lamp") == TextRef::npos) readerFailed = true;
+                }
+                ItemPage browse;
+                if (!platform.browseItems(PageRequest(10, ORDER_BY_PRICE_DESC), browse)) readerFailed = true;
+                auto item = platform.findItemById(ids[(round * 7) % ids.size()]);
+                if (!item || item->getSellerId() != sellerId) readerFailed = true;
+                if (platform.viewItemsByCategory("Home").empty()) readerFailed = true;
+                platform.suggest("desk");
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_FALSE(readerFailed);
+    int soldInStore = 0;
+    for (int id : ids) soldInStore += platform.findItemById(id)->getStatus() == SOLD;
+    EXPECT_EQ(sold, static_cast<int>(ids.size())) << "每件商品都应恰好被一个买家买到";
+    EXPECT_EQ(soldInStore, sold.load());
+    std::vector<int> purchased;
+    for (int buyer : buyers) {
+        auto user = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyer));
+        purchased.insert(purchased.end(), user->purchasedItems.begin(), user->purchasedItems.end());
+        EXPECT_TRUE(user->cartItems.empty());
+    }
+    std::sort(purchased.begin(), purchased.end());
+    EXPECT_EQ(purchased, ids);
+    EXPECT_EQ(platform.getItemCount(), 600);
+    EXPECT_EQ(platform.items.priceIndex().size(), static_cast<size_t>(platform.getCatalogStats().liveRows));
+}
+
+// 多个买家和卖家同时抢同一件商品：只有一方成功，只有赢家留下购买记录，商品只离开索引一次
+TEST_F(TradingPlatformTest, Concurrency_HotItemSoldOnce) {
+    std::vector<int> buyers;
+    for (int b = 0; b < 6; ++b) {
+        std::string email = "hot" + std::to_string(b) + "@nju.edu.cn";
+        platform.registerUser("hot", "pwd", email, "1", "1", "H", "CS", REGULAR_USER);
+        buyers.push_back(platform.login(email, "pwd"));
+    }
+    for (int round = 0; round < 50; ++round) {
+        int itemId = platform.publishItem("Calculus textbook", "hot", "Books", 30, sellerId);
+        std::atomic<int> winners(0);
+        std::vector<std::thread> threads;
+        for (int buyer : buyers) {
+            threads.emplace_back([this, itemId, buyer, &winners]() { winners += platform.purchaseItem(itemId, buyer); });
+        }
+        threads.emplace_back([this, itemId, &winners]() { winners += platform.deleteItem(itemId, sellerId); });
+        for (auto& t : threads) t.join();
+        EXPECT_EQ(winners, 1) << "第 " << round << " 轮";
+        EXPECT_NE(platform.findItemById(itemId)->getStatus(), AVAILABLE);
+    }
+    size_t purchases = 0;
+    for (int buyer : buyers) {
+        purchases += std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(buyer))->purchasedItems.size();
+    }
+    CatalogStats stats = platform.getCatalogStats();
+    EXPECT_EQ(static_cast<int>(purchases), stats.soldRows);
+    EXPECT_EQ(stats.soldRows + stats.deletedRows, 50);
+    EXPECT_EQ(stats.liveRows, 0);
+    EXPECT_TRUE(platform.viewItemsByName("Calculus").empty());
+}
+
+// 结账预留了前面的商品、在最后一件上失败而撤销时，同时抢购这些商品的买家要等预留落定，不能当作已售出而落空。
+// 购物车很大，预留期间两个线程总会交错（单核上靠时间片切换）
+TEST(ItemClaimsTest, RolledBackCheckoutDoesNotStealItems) {
+    const int kCart = 1 << 18;
+    ItemClaims claims;
+    int lost = 0;
+    for (int round = 0; round < 32; ++round) {
+        std::vector<int> cart;
+        for (int k = 0; k < kCart; ++k) {
+            cart.push_back(claims.size() + 1);
+            ASSERT_TRUE(claims.append(cart.back(), AVAILABLE));
+        }
+        cart.push_back(claims.size() + 1);
+        ASSERT_TRUE(claims.append(cart.back(), SOLD));
+
+        // 结账按ID升序预留，抢购者从另一头降序购买，两者在中间相遇
+        bool checkedOut = true;
+        size_t conflict = 0;
+        std::thread checkout([&claims, &cart, &checkedOut, &conflict]() {
+            checkedOut = claims.claimAll(cart, SOLD, conflict);
+        });
+        for (int k = kCart - 1; k >= 0; --k) lost += !claims.claim(cart[k], SOLD);
+        checkout.join();
+        EXPECT_FALSE(checkedOut);
+        for (int k = 0; k < kCart; ++k) ASSERT_EQ(claims.status(cart[k]), SOLD);
+    }
+    EXPECT_EQ(lost, 0) << "没有人买下的商品被报告为买不到";
+}
+
+// 多个买家同时结账，购物车各含 50 件、彼此大量重叠，还有单件抢购的买家：
+// 每件商品至多卖出一次，每个结账的买家要么买下整车，要么一件没买且购物车不变
+TEST_F(TradingPlatformTest, Concurrency_CheckoutCompetingCarts) {
+    std::vector<int> ids;
+    for (int i = 0; i < 300; ++i) ids.push_back(platform.publishItem("Book", "d", "Books", 5, sellerId));
+    const int kBuyers = 6;
+    std::vector<int> buyers;
+    std::vector<std::vector<int>> carts;
+    for (int b = 0; b < kBuyers; ++b) {
+        std::string email = "cart" + std::to_string(b) + "@nju.edu.cn";
+        platform.registerUser("cart", "pwd", email, "1", "1", "C", "CS", REGULAR_USER);
+        buyers.push_back(platform.login(email, "pwd"));
+        std::vector<int> cart;
+        for (int k = 0; k < 50; ++k) cart.push_back(ids[(b * 40 + k * 3) % ids.size()]);
+        for (int id : cart) ASSERT_TRUE(platform.addToCart(id, buyers.back()));
+        carts.push_back(cart);
+    }
+    std::vector<char> succeeded(kBuyers, 0);
+    std::atomic<int> single(0);
+    std::vector<std::thread> threads;
+    for (int b = 0; b < kBuyers; ++b) {
+        threads.emplace_back([this, b, &buyers, &succeeded]() { succeeded[b] = platform.checkout(buyers[b]); });
+    }
+    threads.emplace_back([this, &ids, &single]() {
+        for (size_t i = 0; i < ids.size(); i += 7) single += platform.purchaseItem(ids[i], strangerId);
+    });
+    for (auto& t : threads) t.join();
+
+    std::map<int, int> owners;
+    int sold = single;
+    for (int b = 0; b < kBuyers; ++b) {
+        std::vector<int> expected = carts[b];
+        std::sort(expected.begin(), expected.end());
+        std::vector<int> purchased = platform.listUserItems(buyers[b], LIST_PURCHASED);
+        std::vector<int> cart = platform.listUserItems(buyers[b], LIST_CART);
+        if (succeeded[b]) {
+            EXPECT_EQ(purchased, expected);
+            EXPECT_TRUE(cart.empty());
+            sold += static_cast<int>(expected.size());
+        } else {
+            EXPECT_TRUE(purchased.empty());
+            EXPECT_EQ(cart, carts[b]);
+        }
+        for (int id : purchased) ++owners[id];
+    }
+    auto stranger = std::dynamic_pointer_cast<const RegularUser>(platform.findUserById(strangerId));
+    for (int id : stranger->purchasedItems) ++owners[id];
+    for (const auto& owner : owners) EXPECT_EQ(owner.second, 1) << "商品 " << owner.first << " 卖出了不止一次";
+    EXPECT_EQ(platform.getCatalogStats().soldRows, sold);
+    for (int id : ids) {
+        EXPECT_EQ(platform.findItemById(id)->getStatus() == SOLD, owners.count(id) == 1) << id;
+    }
+}
+
+// 发布和购买持续进行时，每次查询看到的都是某一时刻完整的商品表：
+// 商品按ID顺序发布、从最小的ID开始卖出，任一时刻在售商品的ID都是一段连续区间
+TEST_F(TradingPlatformTest, Concurrency_SnapshotReadsSeeOneVersion) {
+    std::atomic<bool> done(false);
+    std::atomic<bool> torn(false);
+    int first = platform.publishItem("Desk", "d", "Home", 1, sellerId);
+    std::thread writer([this, first, &done]() {
+        int oldest = first;
+        for (int i = 0; i < 1500; ++i) {
+            platform.publishItem("Desk", "d", "Home", 1 + i % 7, sellerId);
+            if (i % 2) platform.purchaseItem(oldest++, buyerId);
+        }
+        done = true;
+    });
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([this, r, &done, &torn]() {
+            while (!done) {
+                std::vector<int> ids = r == 0 ? platform.viewAvailableItems().ids() : platform.viewItemsByCategory("Home").ids();
+                for (size_t k = 1; k < ids.size(); ++k) {
+                    if (ids[k] != ids[k - 1] + 1) torn = true;
+                }
+                int live = platform.getCatalogStats().liveRows;
+                if (live <= 0) torn = true;
+            }
+        });
+    }
+    writer.join();
+    for (auto& t : readers) t.join();
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(platform.items.priceIndex().size(), static_cast<size_t>(platform.getCatalogStats().liveRows));
+}
+
+static SessionStore::Seconds fakeNow = 1000;
+static SessionStore::Seconds fakeClock() { return fakeNow; }
+
+// 会话令牌：闲置超过 ttl 失效，使用后顺延；注销、伪造的令牌无效；时间轮回收到期的会话
+TEST(SessionStoreTest, TokensExpireAfterIdleTtl) {
+    fakeNow = 1000;
+    SessionStore store(10, fakeClock);
+    std::string a = store.create(7);
+    std::string b = store.create(8);
+    std::string c = store.create(9);
+    EXPECT_EQ(a.size(), 32u);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(store.validate(a), 7);
+    EXPECT_EQ(store.validate(""), 0);
+    EXPECT_EQ(store.validate(std::string(32, 'z')), 0);
+    std::string forged = a;
+    forged[31] = forged[31] == '0' ? '1' : '0';
+    EXPECT_EQ(store.validate(forged), 0);
+
+    fakeNow = 1008;
+    EXPECT_EQ(store.validate(a), 7) << "使用后顺延到 1018";
+    EXPECT_TRUE(store.revoke(c));
+    EXPECT_FALSE(store.revoke(c));
+    EXPECT_EQ(store.validate(c), 0);
+    fakeNow = 1010;
+    EXPECT_EQ(store.validate(b), 0) << "闲置满 10 秒";
+    EXPECT_EQ(store.validate(a), 7);
+    EXPECT_EQ(store.size(), 1u);
+
+    // 时间轮回收：一批到期、一批被顺延
+    std::vector<std::string> idle, busy;
+    for (int i = 0; i < 200; ++i) (i % 2 ? busy : idle).push_back(store.create(100 + i));
+    fakeNow = 1015;
+    for (const std::string& token : busy) EXPECT_NE(store.validate(token), 0);
+    fakeNow = 1021;
+    EXPECT_EQ(store.expire(), 101u) << "100 个闲置的会话和 a";
+    EXPECT_EQ(store.size(), 100u);
+    for (const std::string& token : busy) EXPECT_NE(store.validate(token), 0);
+    // 停了远超一圈之后一次回收干净
+    fakeNow = 5000;
+    EXPECT_EQ(store.expire(), 100u);
+    EXPECT_EQ(store.size(), 0u);
+}
+
+// 平台会话：密码错误不发令牌，修改信息后令牌仍对应同一用户，注销后失效
+TEST_F(TradingPlatformTest, Session_OpenValidateClose) {
+    EXPECT_TRUE(platform.openSession("buyer@nju.edu.cn", "wrong").empty());
+    std::string token = platform.openSession("buyer@nju.edu.cn", "123456");
+    ASSERT_FALSE(token.empty());
+    EXPECT_EQ(platform.sessionUser(token), buyerId);
+    EXPECT_TRUE(platform.updateUserProfile(buyerId, "999", "buyer2@nju.edu.cn", "654321"));
+    EXPECT_EQ(platform.sessionUser(token), buyerId);
+    EXPECT_TRUE(platform.closeSession(token));
+    EXPECT_EQ(platform.sessionUser(token), 0);
+}
+
+#ifdef __linux__
+// 在后台线程上运行的服务器，测试结束时停止
+struct ServerThread {
+    TradingServer server;
+    std::thread loop;
+
+    ServerThread(TradingPlatform& platform, int workers) : server(platform, workers) {}
+    void start() { loop = std::thread([this]() { server.run(); }); }
+    ~ServerThread() {
+        server.stop();
+        if (loop.joinable()) loop.join();
+    }
+};
+
+static std::string wireBody(std::initializer_list<std::string> fields) {
+    std::string body;
+    WireWriter out(body);
+    for (const std::string& field : fields) out.str(field);
+    return body;
+}
+
+static std::string wireId(int itemId) {
+    std::string body;
+    WireWriter(body).i32(itemId);
+    return body;
+}
+
+// 网络前端：经 Unix 域套接字完成登录、发布、搜索、加购、结账、管理员统计，以及各种错误状态
+TEST_F(TradingPlatformTest, Server_EndToEnd) {
+    std::string path = "/tmp/trading_test_" + std::to_string(getpid()) + ".sock";
+    ServerThread running(platform, 2);
+    ASSERT_TRUE(running.server.listenUnix(path));
+    running.start();
+
+    WireClient seller, buyer;
+    ASSERT_TRUE(seller.connectUnix(path));
+    ASSERT_TRUE(buyer.connectUnix(path));
+    WireFrame r;
+    ASSERT_TRUE(seller.call(WIRE_PING, "", r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    std::string publish = wireBody({"Desk lamp", "warm light", "Home"});
+    WireWriter(publish).f64(25);
+    ASSERT_TRUE(seller.call(WIRE_PUBLISH, publish, r));
+    EXPECT_EQ(r.code, WIRE_NOT_LOGGED_IN);
+    ASSERT_TRUE(seller.call(WIRE_LOGIN, wireBody({"seller@nju.edu.cn", "wrong"}), r));
+    EXPECT_EQ(r.code, WIRE_FAILED);
+    ASSERT_TRUE(seller.call(WIRE_LOGIN, wireBody({"seller@nju.edu.cn", "123456"}), r));
+    ASSERT_EQ(r.code, WIRE_OK);
+    WireReader login(r.body.data(), r.body.size());
+    int32_t loggedIn = 0;
+    uint8_t role = 0;
+    std::string token;
+    login.i32(loggedIn), login.u8(role), login.str(token);
+    EXPECT_TRUE(login.done());
+    EXPECT_EQ(loggedIn, sellerId);
+    EXPECT_EQ(platform.sessionUser(token), sellerId);
+    ASSERT_TRUE(seller.call(WIRE_PUBLISH, publish, r));
+    ASSERT_EQ(r.code, WIRE_OK);
+    WireReader published(r.body.data(), r.body.size());
+    int32_t lampId = 0;
+    ASSERT_TRUE(published.i32(lampId));
+    EXPECT_TRUE(published.done());
+
+    std::string search = wireBody({"lamp", ""});
+    WireWriter searchOut(search);
+    searchOut.f64(0);
+    searchOut.f64(100);
+    searchOut.str("price_asc");
+    searchOut.i32(10);
+    searchOut.str("");
+    ASSERT_TRUE(buyer.call(WIRE_SEARCH, search, r));
+    ASSERT_EQ(r.code, WIRE_OK);
+    WireReader page(r.body.data(), r.body.size());
+    std::vector<WireItem> items;
+    std::string cursor;
+    ASSERT_TRUE(readPage(page, items, cursor));
+    ASSERT_EQ(items.size(), 1u);
+    EXPECT_EQ(items[0].itemId, lampId);
+    EXPECT_EQ(items[0].name, "Desk lamp");
+    EXPECT_DOUBLE_EQ(items[0].price, 25);
+    EXPECT_EQ(items[0].sellerId, sellerId);
+    EXPECT_TRUE(cursor.empty());
+
+    ASSERT_TRUE(buyer.call(WIRE_ADD_TO_CART, wireId(lampId), r));
+    EXPECT_EQ(r.code, WIRE_NOT_LOGGED_IN);
+    ASSERT_TRUE(buyer.call(WIRE_LOGIN, wireBody({"buyer@nju.edu.cn", "123456"}), r));
+    ASSERT_TRUE(buyer.call(WIRE_ADD_TO_CART, wireId(lampId), r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    std::string cartList(1, static_cast<char>(LIST_CART));
+    ASSERT_TRUE(buyer.call(WIRE_LIST, cartList, r));
+    WireReader cart(r.body.data(), r.body.size());
+    std::vector<int> cartIds;
+    ASSERT_TRUE(cart.ids(cartIds));
+    EXPECT_EQ(cartIds, std::vector<int>({lampId}));
+    ASSERT_TRUE(buyer.call(WIRE_CHECKOUT, "", r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    ASSERT_TRUE(buyer.call(WIRE_ITEM_DETAIL, wireId(lampId), r));
+    WireReader detail(r.body.data(), r.body.size());
+    WireItem lamp;
+    ASSERT_TRUE(readItem(detail, lamp));
+    EXPECT_EQ(lamp.status, SOLD);
+    ASSERT_TRUE(buyer.call(WIRE_PURCHASE, wireId(lampId), r));
+    EXPECT_EQ(r.code, WIRE_FAILED) << "已售出";
+
+    // 令牌在新连接上沿用会话；注销后其他连接上的同一会话也随之失效
+    WireClient again;
+    ASSERT_TRUE(again.connectUnix(path));
+    ASSERT_TRUE(again.call(WIRE_RESUME, wireBody({"0123456789abcdef0123456789abcdef"}), r));
+    EXPECT_EQ(r.code, WIRE_FAILED);
+    ASSERT_TRUE(again.call(WIRE_RESUME, wireBody({token}), r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    std::string publishedList(1, static_cast<char>(LIST_PUBLISHED));
+    ASSERT_TRUE(again.call(WIRE_LIST, publishedList, r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    ASSERT_TRUE(seller.call(WIRE_LOGOUT, "", r));
+    ASSERT_TRUE(again.call(WIRE_LIST, publishedList, r));
+    EXPECT_EQ(r.code, WIRE_NOT_LOGGED_IN);
+
+    // 错误状态：内容不完整、页大小或补全条数超出上限、未知操作、非管理员执行管理操作
+    ASSERT_TRUE(buyer.call(WIRE_ITEM_DETAIL, "ab", r));
+    EXPECT_EQ(r.code, WIRE_MALFORMED);
+    std::string browse;
+    WireWriter browseOut(browse);
+    browseOut.u8(ORDER_BY_ID);
+    browseOut.i32(kWirePageLimit + 1);
+    browseOut.str("");
+    ASSERT_TRUE(buyer.call(WIRE_BROWSE, browse, r));
+    EXPECT_EQ(r.code, WIRE_MALFORMED);
+    std::string bigSearch = wireBody({"lamp", ""});
+    WireWriter bigSearchOut(bigSearch);
+    bigSearchOut.f64(0);
+    bigSearchOut.f64(100);
+    bigSearchOut.str("");
+    bigSearchOut.i32(kWirePageLimit + 1);
+    bigSearchOut.str("");
+    ASSERT_TRUE(buyer.call(WIRE_SEARCH, bigSearch, r));
+    EXPECT_EQ(r.code, WIRE_MALFORMED);
+    std::string suggest = wireBody({"De"});
+    WireWriter(suggest).u32(kWirePageLimit + 1);
+    ASSERT_TRUE(buyer.call(WIRE_SUGGEST, suggest, r));
+    EXPECT_EQ(r.code, WIRE_MALFORMED);
+    ASSERT_TRUE(buyer.call(200, "", r));
+    EXPECT_EQ(r.code, WIRE_UNKNOWN_OP);
+    ASSERT_TRUE(buyer.call(WIRE_ADMIN_STATS, "", r));
+    EXPECT_EQ(r.code, WIRE_FORBIDDEN);
+    ASSERT_TRUE(buyer.call(WIRE_LOGIN, wireBody({"admin1@nju.edu.cn", "admin1234"}), r));
+    ASSERT_TRUE(buyer.call(WIRE_ADMIN_STATS, "", r));
+    ASSERT_EQ(r.code, WIRE_OK);
+    WireReader stats(r.body.data(), r.body.size());
+    int32_t users = 0, itemCount = 0, live = 0, sold = 0;
+    stats.i32(users), stats.i32(itemCount), stats.i32(live), stats.i32(sold);
+    EXPECT_EQ(users, platform.getUserCount());
+    EXPECT_EQ(itemCount, 1);
+    EXPECT_EQ(live, 0);
+    EXPECT_EQ(sold, 1);
+}
+
+// 流水线：一次写出的多个请求按顺序得到响应；不合法的帧只断开发出它的连接
+TEST_F(TradingPlatformTest, Server_PipelinedRequestsAnswerInOrder) {
+    for (int i = 0; i < 50; ++i) platform.publishItem("Book" + std::to_string(i), "d", "Books", 10 + i, sellerId);
+    ServerThread running(platform, 3);
+    ASSERT_TRUE(running.server.listenTcp("127.0.0.1", 0));
+    running.start();
+
+    std::vector<std::thread> clients;
+    std::atomic<int> mismatches(0);
+    for (int c = 0; c < 4; ++c) {
+        clients.emplace_back([&running, &mismatches, c]() {
+            WireClient conn;
+            if (!conn.connectTcp("127.0.0.1", running.server.port())) {
+                ++mismatches;
+                return;
+            }
+            for (uint32_t k = 0; k < 300; ++k) conn.send(k, WIRE_ITEM_DETAIL, wireId(1 + (k + c) % 50));
+            for (uint32_t k = 0; k < 300; ++k) {
+                WireFrame r;
+                if (!conn.receive(r) || r.requestId != k || r.code != WIRE_OK) {
+                    ++mismatches;
+                    return;
+                }
+                WireReader in(r.body.data(), r.body.size());
+                WireItem item;
+                if (!readItem(in, item) || item.itemId != static_cast<int>(1 + (k + c) % 50)) ++mismatches;
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+    EXPECT_EQ(mismatches.load(), 0);
+
+    WireClient bad, good;
+    ASSERT_TRUE(bad.connectTcp("127.0.0.1", running.server.port()));
+    ASSERT_TRUE(good.connectTcp("127.0.0.1", running.server.port()));
+    bad.send(0, WIRE_PING, std::string(kWireMaxFrame, 'x'));
+    WireFrame r;
+    EXPECT_FALSE(bad.receive(r));
+    ASSERT_TRUE(good.call(WIRE_PING, "", r));
+    EXPECT_EQ(r.code, WIRE_OK);
+    EXPECT_EQ(running.server.stats().dropped, 1u);
+    EXPECT_EQ(running.server.stats().requests, 4u * 300 + 1);
+}
+
+// 背压：对端只发不收时服务器暂停读取该连接，积压发出后恢复，所有请求仍按顺序得到响应
+TEST_F(TradingPlatformTest, Server_ThrottlesUnreadResponses) {
+    int poster = platform.publishItem("Poster", std::string(16 * 1024, 'd'), "Art", 5, sellerId);
+    ServerThread running(platform, 2);
+    ASSERT_TRUE(running.server.listenTcp("127.0.0.1", 0));
+    running.start();
+
+    // 请求数低于积压请求的上限，但第一批的响应共约 8MB，超出待发响应的上限，服务器读到第二批时暂停；
+    // 请求只有十几KB，写出后不会阻塞客户端
+    const uint32_t requests = 1000;
+    WireClient conn;
+    ASSERT_TRUE(conn.connectTcp("127.0.0.1", running.server.port()));
+    for (uint32_t k = 0; k < requests / 2; ++k) conn.send(k, WIRE_ITEM_DETAIL, wireId(poster));
+    ASSERT_TRUE(conn.flush());
+    for (int wait = 0; wait < 500 && running.server.stats().requests < requests / 2; ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (uint32_t k = requests / 2; k < requests; ++k) conn.send(k, WIRE_ITEM_DETAIL, wireId(poster));
+    WireFrame r;
+    for (uint32_t k = 0; k < requests; ++k) {
+        ASSERT_TRUE(conn.receive(r));
+        ASSERT_EQ(r.requestId, k);
+        ASSERT_EQ(r.code, WIRE_OK);
+    }
+    EXPECT_GE(running.server.stats().throttled, 1u);
+    EXPECT_EQ(running.server.stats().requests, requests);
+    ASSERT_TRUE(conn.call(WIRE_PING, "", r));
+    EXPECT_EQ(r.code, WIRE_OK);
+}
+#endif
+
+// 响应超出 kWireMaxFrame 时不发出这一帧，改为只带状态码的 WIRE_TOO_LARGE，缩小页大小即可取到
+TEST_F(TradingPlatformTest, Wire_OversizedResponseRefused) {
+    std::string description(16 * 1024, 'd');
+    for (int i = 0; i < kWirePageLimit; ++i) platform.publishItem("Poster", description, "Art", 5, sellerId);
+    RequestHandler handler(platform);
+    WireSession session;
+
+    for (int pageSize : {kWirePageLimit, 10}) {
+        WireFrame request;
+        request.requestId = 7;
+        request.code = WIRE_BROWSE;
+        WireWriter body(request.body);
+        body.u8(ORDER_BY_ID);
+        body.i32(pageSize);
+        body.str("");
+        std::string out;
+        handler.handle(session, request, out);
+        WireFrame response;
+        ASSERT_EQ(parseFrame(out.data(), out.size(), response), static_cast<long>(out.size()));
+        EXPECT_EQ(response.requestId, 7u);
+        if (pageSize == kWirePageLimit) {
+            EXPECT_EQ(response.code, WIRE_TOO_LARGE);
+            EXPECT_TRUE(response.body.empty());
+        } else {
+            EXPECT_EQ(response.code, WIRE_OK);
+        }
+    }
+}
+
+// 分区统计与压实
+// 覆盖：售出/删除后进入冷分区，压实后可购买商品的顺序不变，管理员仍能看到全部商品
+TEST_F(TradingPlatformTest, Catalog_PartitionAndCompact) {
+    int a = platform.publishItem("A", "D", "C", 1, sellerId);
+    int b = platform.publishItem("B", "D", "C", 2, sellerId);
+    int c = platform.publishItem("C", "D", "C", 3, sellerId);
+    int d = platform.publishItem("D", "D", "C", 4, sellerId);
+
+    platform.purchaseItem(b, buyerId);
+    platform.deleteItem(d, sellerId);
+
+    CatalogStats stats = platform.getCatalogStats();
+    EXPECT_EQ(stats.liveRows, 2);
+    EXPECT_EQ(stats.soldRows, 1);
+    EXPECT_EQ(stats.deletedRows, 1);
+    EXPECT_EQ(stats.tombstones, 2);
+
+    EXPECT_EQ(platform.compactCatalog(), 2);
+    stats = platform.getCatalogStats();
+    EXPECT_EQ(stats.tombstones, 0);
+    EXPECT_EQ(stats.liveRows, 2);
+
+    auto available = platform.getAvailableItems();
+    ASSERT_EQ(available.size(), 2);
+    EXPECT_EQ(available[0].getItemId(), a);
+    EXPECT_EQ(available[1].getItemId(), c);
+
+    auto all = platform.getAllItems();
+    EXPECT_EQ(all.size(), 4) << "管理员视图应包含已售出和已删除的商品";
+    EXPECT_EQ(platform.findItemById(b)->getStatus(), SOLD);
+
+    // 状态只能从 AVAILABLE 离开：已售出的商品不能再被删除，已删除的商品也不能被购买
+    EXPECT_FALSE(platform.deleteItem(b, adminId));
+    EXPECT_FALSE(platform.purchaseItem(d, buyerId));
+    stats = platform.getCatalogStats();
+    EXPECT_EQ(stats.soldRows, 1);
+    EXPECT_EQ(stats.deletedRows, 1);
+}
+
+// 大量下架后自动压实，扫描不会再经过墓碑
+TEST_F(TradingPlatformTest, Catalog_AutoCompact) {
+    std::vector<int> ids;
+    for (int i = 0; i < 3000; ++i) {
+        ids.push_back(platform.publishItem("Bulk", "D", "C", 1, sellerId));
+    }
+    for (int i = 0; i < 2000; ++i) {
+        platform.purchaseItem(ids[i], buyerId);
+    }
+    CatalogStats stats = platform.getCatalogStats();
+    EXPECT_EQ(stats.liveRows, 1000);
+    EXPECT_EQ(stats.soldRows, 2000);
+    EXPECT_LT(stats.tombstones, stats.liveRows + 1) << "墓碑数超过可购买数时应已自动压实";
+
+    SearchCriteria criteria;
+    criteria.setKeyword("Bulk");
+    auto results = criteria.apply(platform.items);
+    ASSERT_EQ(results.size(), 1000);
+    EXPECT_EQ(results.front().getItemId(), ids[2000]);
+}
+
+// 查询视图直接指向商品表中的商品，不复制；平台返回的视图登记着所在的副本，释放前写者等待，snapshot() 复制出可长期保存的结果
+// 覆盖：view* 接口、副本登记、快照视图、视图版本号、SearchEngine 视图重载
+TEST_F(TradingPlatformTest, View_ZeroCopyResults) {
+    int a = platform.publishItem("Lamp A", "desk", "Home", 30, sellerId);
+    int b = platform.publishItem("Lamp B", "floor", "Home", 10, sellerId);
+    int c = platform.publishItem("Chair", "wood", "Home", 10, sellerId);
+
+    ItemView view = platform.viewItemsByName("Lamp");
+    ASSERT_EQ(view.size(), 2);
+    EXPECT_TRUE(&view[0] == platform.catalog.replica(0).find(a) || &view[0] == platform.catalog.replica(1).find(a))
+        << "平台返回的视图应指向副本中的商品";
+    EXPECT_EQ(view.ids(), std::vector<int>({a, b}));
+    ItemView copy = view;
+    EXPECT_EQ(&copy[1], &view[1]) << "复制视图只复制指针";
+    ItemView frozen = view.snapshot();
+    EXPECT_NE(&frozen[0], &view[0]);
+    unsigned long long generation = view.generation;
+    EXPECT_EQ(generation, platform.items.generation());
+
+    // 视图登记着副本时，另一个线程的购买要等它释放才能完成；期间视图看到的商品不变
+    std::atomic<bool> bought(false);
+    std::thread buyer([this, a, &bought]() { bought = platform.purchaseItem(a, buyerId); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(bought);
+    EXPECT_EQ(view[0].getStatus(), AVAILABLE);
+    view = ItemView();
+    copy = ItemView();
+    buyer.join();
+    EXPECT_TRUE(bought);
+
+    // 商品表修改后快照的版本落后，其中的商品保持查询时的状态
+    EXPECT_NE(platform.items.generation(), generation);
+    EXPECT_EQ(frozen[0].getStatus(), AVAILABLE);
+    EXPECT_EQ(platform.findItemById(a)->getStatus(), SOLD);
+    SearchCriteria lamps;
+    lamps.setKeyword("Lamp");
+    ItemView live = lamps.select(platform.items);
+    ASSERT_EQ(live.size(), 1);
+    EXPECT_EQ(&live[0], platform.items.find(b)) << "商品表上的视图应指向商品表中的同一对象";
+
+    // 按价格排序只重排指针，同价商品保持原顺序
+    ItemView sorted = SearchEngine::sortByPrice(platform.viewItemsByCategory("Home"), true);
+    ASSERT_EQ(sorted.size(), 2);
+    EXPECT_EQ(sorted[0].getItemId(), b);
+    EXPECT_EQ(sorted[1].getItemId(), c);
+    EXPECT_TRUE(sorted.anchor) << "排序得到的视图同样持有登记";
+
+    SearchCriteria criteria;
+    criteria.setKeyword("floor");
+    ItemView selected = criteria.select(platform.items);
+    ASSERT_EQ(selected.size(), 1);
+    EXPECT_EQ(&selected[0], platform.items.find(b));
+    EXPECT_EQ(platform.viewAllItems().size(), 3);
+}
+
+// =================================================================
+// 功能模块 4: 游标分页
+// =================================================================
+
+// 按ID翻页：每页不重不漏，翻页期间商品被买走不会打乱后续页
+TEST_F(TradingPlatformTest, Page_ByIdWithCursor) {
+    std::vector<int> ids;
+    for (int i = 0; i < 7; ++i) {
+        ids.push_back(platform.publishItem("P" + std::to_string(i), "D", "C", 10 + i, sellerId));
+    }
+
+    ItemPage page;
+    ASSERT_TRUE(platform.browseItems(PageRequest(3), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({ids[0], ids[1], ids[2]}));
+    ASSERT_TRUE(page.hasMore());
+    PageRequest next(3, ORDER_BY_ID, page.nextCursor);
+    page = ItemPage();
+
+    platform.purchaseItem(ids[3], buyerId);   // 下一页的第一件被买走
+
+    ASSERT_TRUE(platform.browseItems(next, page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({ids[4], ids[5], ids[6]}));
+    EXPECT_FALSE(page.hasMore()) << "最后一页不应再返回游标";
+
+    // 最新发布在前
+    ASSERT_TRUE(platform.browseItems(PageRequest(2, ORDER_BY_NEWEST), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({ids[6], ids[5]}));
+}
+
+// 按价格翻页：同价商品按ID排序，跨页不重复
+TEST_F(TradingPlatformTest, Page_ByPriceWithTies) {
+    int a = platform.publishItem("A", "D", "C", 20, sellerId);
+    int b = platform.publishItem("B", "D", "C", 10, sellerId);
+    int c = platform.publishItem("C", "D", "C", 20, sellerId);
+    int d = platform.publishItem("D", "D", "C", 5, sellerId);
+    int e = platform.publishItem("E", "D", "C", 20, sellerId);
+
+    std::vector<int> seen;
+    PageRequest request(2, ORDER_BY_PRICE_ASC);
+    ItemPage page;
+    do {
+        ASSERT_TRUE(platform.browseItems(request, page));
+        for (int id : page.items.ids()) seen.push_back(id);
+        request.cursor = page.nextCursor;
+    } while (page.hasMore());
+    EXPECT_EQ(seen, std::vector<int>({d, b, a, c, e}));
+
+    seen.clear();
+    request = PageRequest(2, ORDER_BY_PRICE_DESC);
+    do {
+        ASSERT_TRUE(platform.browseItems(request, page));
+        for (int id : page.items.ids()) seen.push_back(id);
+        request.cursor = page.nextCursor;
+    } while (page.hasMore());
+    EXPECT_EQ(seen, std::vector<int>({a, c, e, b, d}));
+}
+
+// 非法游标、与排序方式不符的游标、非法页大小都应拒绝
+TEST_F(TradingPlatformTest, Page_InvalidCursor) {
+    for (int i = 0; i < 3; ++i) platform.publishItem("X", "D", "C", 1, sellerId);
+    ItemPage page;
+    ASSERT_TRUE(platform.browseItems(PageRequest(1), page));
+    std::string cursor = page.nextCursor;
+
+    EXPECT_FALSE(platform.browseItems(PageRequest(1, ORDER_BY_ID, "not-a-cursor"), page));
+    EXPECT_FALSE(platform.browseItems(PageRequest(1, ORDER_BY_PRICE_ASC, cursor), page));
+    std::string tampered = cursor;
+    tampered[20] = tampered[20] == '0' ? '1' : '0';
+    EXPECT_FALSE(platform.browseItems(PageRequest(1, ORDER_BY_ID, tampered), page));
+    EXPECT_FALSE(platform.browseItems(PageRequest(0), page));
+
+    // 校验正确但ID越界的伪造游标（按ID翻页时 itemId ± 1 会溢出）
+    for (int id : {INT_MAX, INT_MIN, 0, -1}) {
+        std::string forged = encodeCursor(ORDER_BY_ID, Item(id, "X", "D", "C", 1, sellerId));
+        EXPECT_FALSE(platform.browseAllItems(PageRequest(1, ORDER_BY_ID, forged), page)) << id;
+        forged = encodeCursor(ORDER_BY_NEWEST, Item(id, "X", "D", "C", 1, sellerId));
+        EXPECT_FALSE(platform.browseAllItems(PageRequest(1, ORDER_BY_NEWEST, forged), page)) << id;
+    }
+}
+
+// 管理员分页包含已下架商品；搜索结果同样可以分页
+TEST_F(TradingPlatformTest, Page_AdminAndSearch) {
+    int a = platform.publishItem("Desk lamp", "D", "Home", 30, sellerId);
+    int b = platform.publishItem("Desk", "D", "Home", 80, sellerId);
+    int c = platform.publishItem("Desk fan", "D", "Home", 50, sellerId);
+    platform.deleteItem(b, sellerId);
+
+    ItemPage page;
+    ASSERT_TRUE(platform.browseAllItems(PageRequest(2), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({a, b}));
+    ASSERT_TRUE(platform.browseAllItems(PageRequest(2, ORDER_BY_ID, page.nextCursor), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({c}));
+    // 页大小取 INT_MAX 时一页取完
+    ASSERT_TRUE(platform.browseAllItems(PageRequest(INT_MAX), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({a, b, c}));
+    EXPECT_FALSE(page.hasMore());
+    ASSERT_TRUE(platform.browseAllItems(PageRequest(INT_MAX, ORDER_BY_NEWEST), page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({c, b, a}));
+    EXPECT_FALSE(page.hasMore());
+
+    SearchCriteria criteria;
+    criteria.setKeyword("Desk");
+    criteria.setSortBy("price_desc");
+    criteria.setPage(1);
+    ASSERT_TRUE(platform.searchItems(criteria, page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({c}));
+    criteria.setPage(1, page.nextCursor);
+    ASSERT_TRUE(platform.searchItems(criteria, page));
+    EXPECT_EQ(page.items.ids(), std::vector<int>({a}));
+    EXPECT_FALSE(page.hasMore());
+}
+
+// 搜索分页按计划选出的候选集从游标处继续读取，逐页拼起来与一次查询的结果相同；相关度等无法分页的排序直接拒绝
+TEST_F(TradingPlatformTest, Page_SearchFollowsPlan) {
+    for (int i = 0; i < 6000; ++i) {
+        int id = platform.publishItem(i % 600 ? "Bike" : "Rare book", "d", i % 600 ? "Transport" : "Books", i % 100,
+                                      sellerId);
+        if (i % 7 == 0) platform.purchaseItem(id, buyerId);
+    }
+    struct Case {
+        const char* category;
+        const char* keyword;
+        int maxDistance;
+        double minPrice, maxPrice;
+    } cases[] = {
+        {"", "", 0, 0, 1000000},           // 沿可购买分区 / 价格索引顺序读取
+        {"", "", 0, 10, 10},               // 价格区间很窄
+        {"Transport", "", 0, 20, 60},      // 稠密的分类位图
+        {"Books", "", 0, 0, 1000000},      // 稀疏的分类位图
+        {"", "Rare", 0, 0, 1000000},       // 文本索引
+        {"Transport", "Bkie", 1, 0, 50},   // 近似搜索，候选集需要核对原文
+    };
+    const char* orders[] = {"", "newest", "price_asc", "price_desc"};
+    for (const Case& c : cases) {
+        for (const char* sortBy : orders) {
+            SearchCriteria criteria;
+            criteria.setCategory(c.category);
+            criteria.setKeyword(c.keyword);
+            criteria.setMaxDistance(c.maxDistance);
+            criteria.setPriceRange(c.minPrice, c.maxPrice);
+            criteria.setSortBy(sortBy);
+            std::vector<int> seen;
+            ItemPage page;
+            criteria.setPage(97);
+            do {
+                ASSERT_TRUE(criteria.selectPage(platform.items, page));
+                for (int id : page.items.ids()) seen.push_back(id);
+                criteria.setPage(97, page.nextCursor);
+            } while (page.hasMore());
+            EXPECT_EQ(seen, criteria.select(platform.items).ids()) << c.category << " " << c.keyword << " " << sortBy;
+        }
+    }
+
+    SearchCriteria criteria;
+    criteria.setKeyword("Rare");
+    criteria.setPage(10);
+    ItemPage page;
+    criteria.setSortBy("relevance");
+    EXPECT_FALSE(criteria.selectPage(platform.items, page));
+    EXPECT_FALSE(platform.searchItems(criteria, page));
+    criteria.setSortBy("price_asc,newest");
+    EXPECT_FALSE(criteria.selectPage(platform.items, page));
+    criteria.setSortBy("oldest");
+    EXPECT_TRUE(criteria.selectPage(platform.items, page));
+    EXPECT_EQ(page.items.size(), 8u);
+}
+
+// =================================================================
+// 功能模块 5: 列存过滤
+// =================================================================
+
+// 标量 / SSE2 / AVX2 过滤核结果一致（包括不足64行的尾部和从中间开始的区间）
+TEST(FilterKernelTest, AllImplementationsAgree) {
+    ItemColumns columns;
+    for (int i = 0; i < 1000; ++i) {
+        Item item(i + 1, "n", "d", "c", (i * 37) % 200, i % 7);
+        item.setStatus(i % 5 == 0 ? SOLD : (i % 11 == 0 ? DELETED : AVAILABLE));
+        columns.append(item, i % 4);
+    }
+    ColumnFilter filter;
+    filter.minPrice = 50;
+    filter.maxPrice = 120;
+    filter.categoryId = 2;
+
+    for (int categoryId : {2, -1}) {
+        filter.categoryId = categoryId;
+        std::vector<uint64_t> expected;
+        filterColumns(columns, filter, expected, FILTER_SCALAR);
+        for (FilterImpl impl : {FILTER_SSE2, FILTER_AVX2, FILTER_AUTO}) {
+            std::vector<uint64_t> bitmap;
+            filterColumns(columns, filter, bitmap, impl);
+            EXPECT_EQ(bitmap, expected) << filterImplName(resolveFilterImpl(impl));
+        }
+
+        std::vector<int> rows;
+        bitmapToRows(expected, rows);
+        for (int row : rows) {
+            EXPECT_EQ(columns.status[row], AVAILABLE);
+            EXPECT_GE(columns.price[row], 50);
+            EXPECT_LE(columns.price[row], 120);
+            if (categoryId >= 0) {
+                EXPECT_EQ(columns.categoryId[row], categoryId);
+            }
+        }
+
+        // 区间求值只覆盖 [128, 1000)
+        std::vector<uint64_t> partial;
+        filterColumns(columns, filter, 128, 1000, partial, FILTER_AUTO);
+        EXPECT_EQ(partial[0], 0u);
+        EXPECT_EQ(std::vector<uint64_t>(partial.begin() + 2, partial.end()),
+                  std::vector<uint64_t>(expected.begin() + 2, expected.end()));
+    }
+}
+
+// 商品表的列存影子随状态变化同步，SearchCriteria 的结果与逐条判断一致
+TEST_F(TradingPlatformTest, Columns_SelectMatchesRowPredicate) {
+    for (int i = 0; i < 300; ++i) {
+        int id = platform.publishItem(i % 3 ? "Bike" : "Book", i % 2 ? "red" : "blue",
+                                      i % 4 ? "Transport" : "Books", i % 50, sellerId);
+        if (i % 9 == 0) platform.purchaseItem(id, buyerId);
+    }
+    SearchCriteria criteria;
+    criteria.setPriceRange(10, 30);
+    criteria.setCategory("Transport");
+    criteria.setKeyword("red");
+
+    std::vector<int> expected;
+    for (const auto& item : platform.items) {
+        if (criteria.matches(item)) expected.push_back(item.getItemId());
+    }
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(criteria.select(platform.items).ids(), expected);
+
+    criteria.setCategory("NoSuchCategory");
+    EXPECT_TRUE(criteria.select(platform.items).empty());
+}
+// =================================================================
+// 功能模块 6: 分类位图
+// =================================================================
+
+// 数组容器与位图容器互相转换，集合运算与 std::set 的结果一致
+TEST(RoaringBitmapTest, SetOperationsMatchReference) {
+    RoaringBitmap a, b;
+    std::vector<uint32_t> expectA, expectB, expectAnd, expectOr;
+    // a 的第0桶稠密（超过 4096 个元素），b 跨多个稀疏桶
+    for (uint32_t id = 0; id < 20000; id += 3) { a.add(id); expectA.push_back(id); }
+    for (uint32_t id = 0; id < 200000; id += 7) { b.add(id); expectB.push_back(id); }
+    EXPECT_FALSE(a.add(3));
+    EXPECT_TRUE(a.contains(9));
+    EXPECT_FALSE(a.contains(10));
+    EXPECT_EQ(a.toVector(), expectA);
+    EXPECT_EQ(b.cardinality(), expectB.size());
+
+    std::set_intersection(expectA.begin(), expectA.end(), expectB.begin(), expectB.end(), std::back_inserter(expectAnd));
+    std::set_union(expectA.begin(), expectA.end(), expectB.begin(), expectB.end(), std::back_inserter(expectOr));
+    EXPECT_EQ(a.intersect(b).toVector(), expectAnd);
+    EXPECT_EQ(b.intersect(a).toVector(), expectAnd);
+    EXPECT_EQ(a.unite(b).toVector(), expectOr);
+
+    // 与普通位图求交
+    std::vector<uint64_t> dense((200000 + 63) / 64, 0);
+    std::vector<uint32_t> expectDense;
+    for (uint32_t id : expectB) {
+        if (id % 2 == 0) { dense[id / 64] |= 1ull << (id % 64); expectDense.push_back(id); }
+    }
+    EXPECT_EQ(b.intersectDense(dense).toVector(), expectDense);
+
+    // 删除到不足 4096 个时退回数组容器，内容不变
+    for (uint32_t id = 0; id < 20000; id += 6) { EXPECT_TRUE(a.remove(id)); }
+    EXPECT_FALSE(a.remove(0));
+    std::vector<uint32_t> rest;
+    for (uint32_t id : expectA) if (id % 6 != 0) rest.push_back(id);
+    EXPECT_EQ(a.toVector(), rest);
+    EXPECT_FALSE(a.containers[0].dense);
+}
+
+// 分类位图只包含可购买商品，随购买、删除和修改分类同步
+TEST_F(TradingPlatformTest, Category_BitmapFollowsStatus) {
+    int book1 = platform.publishItem("C++ Primer", "入门", "书籍", 50, sellerId);
+    int bike = platform.publishItem("山地车", "九成新", "自行车", 300, sellerId);
+    int book2 = platform.publishItem("算法导论", "经典", "书籍", 80, sellerId);
+    int book3 = platform.publishItem("数据库系统", "教材", "书籍", 40, sellerId);
+
+    EXPECT_EQ(platform.viewItemsByCategory("书籍").ids(), std::vector<int>({book1, book2, book3}));
+    platform.purchaseItem(book2, buyerId);
+    platform.deleteItem(book3, sellerId);
+    EXPECT_EQ(platform.viewItemsByCategory("书籍").ids(), std::vector<int>({book1}));
+
+    ASSERT_TRUE(platform.updateItem(book1, sellerId, "C++ Primer", "入门", "电子书", 45));
+    EXPECT_TRUE(platform.viewItemsByCategory("书籍").empty());
+    EXPECT_EQ(platform.viewItemsByCategory("电子书").ids(), std::vector<int>({book1}));
+    EXPECT_EQ(platform.findItemById(book1)->getCategory(), "电子书");
+    EXPECT_EQ(platform.items.columnar().price[book1], 45);
+    EXPECT_EQ(platform.viewItemsByCategory("自行车").ids(), std::vector<int>({bike}));
+    EXPECT_TRUE(platform.viewItemsByCategory("不存在").empty());
+
+    // 小分类只有少量候选，不必经过过滤核
+    for (int i = 0; i < 200; ++i) platform.publishItem("杂物", "", "生活用品", i, sellerId);
+    SearchCriteria criteria;
+    criteria.setCategory("电子书");
+    criteria.setPriceRange(40, 50);
+    EXPECT_EQ(criteria.select(platform.items).ids(), std::vector<int>({book1}));
+    criteria.setPriceRange(0, 40);
+    EXPECT_TRUE(criteria.select(platform.items).empty());
+}
+
+// 只有卖家本人或管理员可以修改在售商品
+TEST_F(TradingPlatformTest, UpdateItem_Permissions) {
+    int itemId = platform.publishItem("台灯", "护眼", "生活用品", 30, sellerId);
+    EXPECT_FALSE(platform.updateItem(itemId, strangerId, "台灯", "护眼", "生活用品", 1));
+    EXPECT_FALSE(platform.updateItem(999, sellerId, "台灯", "护眼", "生活用品", 1));
+    EXPECT_TRUE(platform.updateItem(itemId, adminId, "台灯", "护眼", "生活用品", 25));
+    EXPECT_EQ(platform.findItemById(itemId)->getPrice(), 25);
+
+    platform.purchaseItem(itemId, buyerId);
+    EXPECT_FALSE(platform.updateItem(itemId, sellerId, "台灯", "护眼", "生活用品", 20));
+}